@@ -0,0 +1,132 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+
+/*
+ benchmark of scs_solve_batch against calling scs_solve on each problem in turn, for one random SOCP with a box
+ cone and, with blas+lapack, a 12 x 12 SD block (same A and cones) with num_problems perturbed (b, c) right-hand sides.
+
+ usage: bench_batch [n] [num_problems] [seed]
+
+ both versions do the same arithmetic for each problem, so the results must be identical.
+ */
+
+int main(int argc, char **argv) {
+	scs_int n = argc > 1 ? atoi(argv[1]) : 1000;
+	scs_int numProblems = argc > 2 ? atoi(argv[2]) : 16;
+	int seed = argc > 3 ? atoi(argv[3]) : 1;
+	scs_int m = 3 * n, col_nnz = (scs_int) ceil(sqrt(n)), rows, size, i, j, mismatches = 0, totIters = 0;
+	scs_float tSerial, tBatch, *b0, *c0;
+	Data * d = scs_calloc(1, sizeof(Data));
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	Sol opt = { 0 };
+	Sol * serial = scs_calloc(numProblems, sizeof(Sol)), *batch = scs_calloc(numProblems, sizeof(Sol));
+	Info * serialInfo = scs_calloc(numProblems, sizeof(Info)), *batchInfo = scs_calloc(numProblems, sizeof(Info));
+	scs_float ** b = scs_malloc(numProblems * sizeof(scs_float *)), **c = scs_malloc(numProblems * sizeof(scs_float *));
+	Info info = { 0 };
+	Work * w;
+	timer t;
+
+	srand(seed);
+	d->stgs = scs_calloc(1, sizeof(Settings));
+	d->m = m;
+	d->n = n;
+	k->f = n / 3;
+	k->l = n;
+	/* t and n / 10 entries with random bounds around 0 */
+	k->bsize = 1 + MAX(n / 10, 1);
+	k->bl = scs_malloc((k->bsize - 1) * sizeof(scs_float));
+	k->bu = scs_malloc((k->bsize - 1) * sizeof(scs_float));
+	for (i = 0; i < k->bsize - 1; ++i) {
+		k->bl[i] = -rand() / (scs_float) RAND_MAX;
+		k->bu[i] = rand() / (scs_float) RAND_MAX;
+	}
+	rows = m - k->f - k->l - k->bsize;
+#ifdef LAPACK_LIB_FOUND
+	/* larger than the blocks projected by Jacobi, so projected by the pretests or the eigendecomposition */
+	k->ssize = 1;
+	k->s = scs_malloc(sizeof(scs_int));
+	k->s[0] = 12;
+	rows -= k->s[0] * (k->s[0] + 1) / 2;
+#endif
+	k->q = scs_malloc(rows * sizeof(scs_int));
+	while (rows > 0) {
+		/* MIN evaluates its arguments twice */
+		size = 3 + rand() % 5;
+		size = MIN(size, rows);
+		k->q[k->qsize++] = size;
+		rows -= size;
+	}
+	genRandomProbData(n * col_nnz, col_nnz, d, k, &opt);
+	setDefaultSettings(d);
+	d->stgs->verbose = 0;
+	for (j = 0; j < numProblems; ++j) {
+		b[j] = scs_malloc(m * sizeof(scs_float));
+		c[j] = scs_malloc(n * sizeof(scs_float));
+		memcpy(b[j], d->b, m * sizeof(scs_float));
+		memcpy(c[j], d->c, n * sizeof(scs_float));
+		perturbVector(b[j], m);
+		perturbVector(c[j], n);
+	}
+
+	b0 = d->b;
+	c0 = d->c;
+	w = scs_init(d, k, &info);
+	if (!w) {
+		scs_printf("scs_init failed\n");
+		return -1;
+	}
+
+	tic(&t);
+	for (j = 0; j < numProblems; ++j) {
+		d->b = b[j];
+		d->c = c[j];
+		scs_solve(w, d, k, &(serial[j]), &(serialInfo[j]));
+	}
+	tSerial = tocq(&t);
+
+	tic(&t);
+	scs_solve_batch(w, d, k, numProblems, b, c, batch, batchInfo);
+	tBatch = tocq(&t);
+
+	for (j = 0; j < numProblems; ++j) {
+		totIters += batchInfo[j].iter;
+		if (serialInfo[j].statusVal != batchInfo[j].statusVal || serialInfo[j].iter != batchInfo[j].iter
+				|| memcmp(serial[j].x, batch[j].x, n * sizeof(scs_float))
+				|| memcmp(serial[j].y, batch[j].y, m * sizeof(scs_float))
+				|| memcmp(serial[j].s, batch[j].s, m * sizeof(scs_float))) {
+			scs_printf("problem %li: batch result differs from scs_solve (%s in %li vs %s in %li iterations)\n", (long) j,
+					batchInfo[j].status, (long) batchInfo[j].iter, serialInfo[j].status, (long) serialInfo[j].iter);
+			mismatches++;
+		}
+	}
+	scs_printf("n = %li, m = %li, %li problems, %li iterations in total, %li mismatches\n", (long) n, (long) m,
+			(long) numProblems, (long) totIters, (long) mismatches);
+	scs_printf("scs_solve in turn: %8.2f ms\n", tSerial);
+	scs_printf("scs_solve_batch:   %8.2f ms (%.2fx)\n", tBatch, tSerial / tBatch);
+
+	scs_finish(w);
+	for (j = 0; j < numProblems; ++j) {
+		scs_free(b[j]);
+		scs_free(c[j]);
+		scs_free(serial[j].x);
+		scs_free(serial[j].y);
+		scs_free(serial[j].s);
+		scs_free(batch[j].x);
+		scs_free(batch[j].y);
+		scs_free(batch[j].s);
+	}
+	d->b = b0;
+	d->c = c0;
+	freeData(d, k);
+	scs_free(opt.x);
+	scs_free(opt.y);
+	scs_free(opt.s);
+	scs_free(b);
+	scs_free(c);
+	scs_free(serial);
+	scs_free(batch);
+	scs_free(serialInfo);
+	scs_free(batchInfo);
+	return mismatches > 0;
+}
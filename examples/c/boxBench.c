@@ -0,0 +1,156 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+
+/*
+ benchmark of the box cone on a long-only portfolio LP: maximize mu'x subject to sum(x) = 1, 0 <= x <= 3 / n and the
+ exposure of each of num_sectors sectors (asset i is in sector i % num_sectors) at least 0.5 / num_sectors and, for
+ every other sector, at most 2 / num_sectors. solved once with each bound as rows of the positive orthant (two rows
+ per doubly bounded constraint) and once with one row each in the box cone.
+
+ usage: bench_box [n] [num_sectors] [seed]
+
+ the box cone solution is checked against its bounds and the objective of the LP one.
+ */
+
+#define BOX_BENCH_EPS (1e-4)
+
+/* the upper bound of sector j, infinite for the odd sectors */
+static scs_float sectorUpper(scs_int j, scs_int numSectors) {
+	return j % 2 ? 1e20 : 2.0 / numSectors;
+}
+
+/* fills d and k with the portfolio LP, its bounds in the box cone if box else in the positive orthant */
+static void portfolioData(Data * d, Cone * k, const scs_float * mu, scs_int n, scs_int numSectors, scs_int box) {
+	scs_int i, j, row, q = 0, numUpper = (numSectors + 1) / 2;
+	scs_float hi = 3.0 / n, lo = 0.0, sLo = 0.5 / numSectors;
+	AMatrix * A = d->A = scs_calloc(1, sizeof(AMatrix));
+	k->f = 1;
+	if (box) {
+		k->bsize = 1 + n + numSectors;
+		k->bl = scs_malloc((k->bsize - 1) * sizeof(scs_float));
+		k->bu = scs_malloc((k->bsize - 1) * sizeof(scs_float));
+		d->m = 1 + k->bsize;
+	} else {
+		k->l = 2 * n + numSectors + numUpper;
+		d->m = 1 + k->l;
+	}
+	d->n = n;
+	d->b = scs_calloc(d->m, sizeof(scs_float));
+	d->c = scs_malloc(n * sizeof(scs_float));
+	A->m = d->m;
+	A->n = n;
+	A->p = scs_malloc((n + 1) * sizeof(scs_int));
+	A->i = scs_malloc(5 * n * sizeof(scs_int));
+	A->x = scs_malloc(5 * n * sizeof(scs_float));
+	d->b[0] = 1.0;
+	if (box) {
+		/* t = 1, then s = x and the sector exposures */
+		d->b[1] = 1.0;
+		for (i = 0; i < n; ++i) {
+			k->bl[i] = lo;
+			k->bu[i] = hi;
+		}
+		for (j = 0; j < numSectors; ++j) {
+			k->bl[n + j] = sLo;
+			k->bu[n + j] = sectorUpper(j, numSectors);
+		}
+	} else {
+		for (i = 0; i < n; ++i) {
+			d->b[1 + 2 * i] = hi;
+			d->b[2 + 2 * i] = -lo;
+		}
+		for (j = 0, row = 1 + 2 * n; j < numSectors; ++j) {
+			d->b[row++] = -sLo;
+			if (j % 2 == 0) {
+				d->b[row++] = sectorUpper(j, numSectors);
+			}
+		}
+	}
+	for (i = 0; i < n; ++i) {
+		d->c[i] = -mu[i];
+		A->p[i] = q;
+		A->i[q] = 0;
+		A->x[q++] = 1.0;
+		j = i % numSectors;
+		if (box) {
+			A->i[q] = 2 + i;
+			A->x[q++] = -1.0;
+			A->i[q] = 2 + n + j;
+			A->x[q++] = -1.0;
+		} else {
+			A->i[q] = 1 + 2 * i;
+			A->x[q++] = 1.0;
+			A->i[q] = 2 + 2 * i;
+			A->x[q++] = -1.0;
+			/* sector j's rows follow those of the sectors before it, one or two each */
+			row = 1 + 2 * n + j + (j + 1) / 2;
+			A->i[q] = row;
+			A->x[q++] = -1.0;
+			if (j % 2 == 0) {
+				A->i[q] = row + 1;
+				A->x[q++] = 1.0;
+			}
+		}
+	}
+	A->p[n] = q;
+}
+
+/* largest violation of the bounds by the solution x */
+static scs_float boundViolation(const scs_float * x, scs_int n, scs_int numSectors) {
+	scs_int i, j;
+	scs_float viol = 0.0, *exposure = scs_calloc(numSectors, sizeof(scs_float));
+	for (i = 0; i < n; ++i) {
+		viol = MAX(viol, MAX(-x[i], x[i] - 3.0 / n));
+		exposure[i % numSectors] += x[i];
+	}
+	for (j = 0; j < numSectors; ++j) {
+		viol = MAX(viol, MAX(0.5 / numSectors - exposure[j], exposure[j] - sectorUpper(j, numSectors)));
+	}
+	scs_free(exposure);
+	return viol;
+}
+
+int main(int argc, char **argv) {
+	scs_int n = argc > 1 ? atoi(argv[1]) : 2000;
+	scs_int numSectors = argc > 2 ? atoi(argv[2]) : 20;
+	int seed = argc > 3 ? atoi(argv[3]) : 1;
+	scs_int i, box;
+	scs_float viol = 0.0, obj[2], *mu = scs_malloc(n * sizeof(scs_float));
+	Sol sol = { 0 };
+	Info info[2] = { { 0 }, { 0 } };
+	Data * d;
+	Cone * k;
+
+	srand(seed);
+	for (i = 0; i < n; ++i) {
+		mu[i] = rand_gauss();
+	}
+	scs_printf("portfolio LP on %li assets in %li sectors\n", (long) n, (long) numSectors);
+	for (box = 0; box < 2; ++box) {
+		d = scs_calloc(1, sizeof(Data));
+		k = scs_calloc(1, sizeof(Cone));
+		portfolioData(d, k, mu, n, numSectors, box);
+		d->stgs = scs_calloc(1, sizeof(Settings));
+		setDefaultSettings(d);
+		d->stgs->verbose = 0;
+		d->stgs->eps = BOX_BENCH_EPS;
+		scs(d, k, &sol, &(info[box]));
+		obj[box] = info[box].pobj;
+		scs_printf("%-14s m = %6li: %s in %5li iterations, %8.2f ms (cones %6.2f ms), objective %.6e\n",
+				box ? "box cone:" : "LP rows:", (long) d->m, info[box].status, (long) info[box].iter,
+				info[box].setupTime + info[box].solveTime, info[box].coneTime, obj[box]);
+		if (box) {
+			viol = boundViolation(sol.x, n, numSectors);
+			scs_printf("box cone bound violation %.1e, objective difference %.1e\n", viol, ABS(obj[1] - obj[0]));
+		}
+		freeData(d, k);
+		scs_free(sol.x);
+		scs_free(sol.y);
+		scs_free(sol.s);
+		sol.x = sol.y = sol.s = SCS_NULL;
+	}
+	scs_free(mu);
+	return info[0].statusVal != SCS_SOLVED || info[1].statusVal != SCS_SOLVED || viol > 1e-3 / n
+			|| ABS(obj[1] - obj[0]) > 1e-3 * (1 + ABS(obj[0]));
+}
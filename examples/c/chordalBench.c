@@ -0,0 +1,205 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+
+/*
+ benchmark of chordal_decomposition on the max-cut SDP relaxation in its dual form, minimize sum(x) subject to
+ diag(x) - L / 4 PSD, for the Laplacian L of a graph on n vertices with the edges of a band of width bandwidth plus
+ arrow vertices joined to all others (the aggregate sparsity of the SD block is that of L). solved with the setting
+ off and on, then with the decomposition from one scs_init: again warm started from the solution, after scs_update_A
+ scales A by 2 (x halves) and as a batch with c and 2 c.
+
+ usage: bench_chordal [n] [bandwidth] [arrow] [seed]
+
+ the solutions are those of the original problem, mapped back from the decomposed one (y outside the band and arrow by
+ PSD completion), and are checked for the residuals and the smallest eigenvalues of s and y.
+ */
+
+#define CHORDAL_BENCH_EPS (1e-4)
+
+#ifdef LAPACK_LIB_FOUND
+void BLAS(syevr)(const char *jobz, const char *range, const char *uplo, blasint *n, scs_float *a, blasint *lda,
+		scs_float *vl, scs_float *vu, blasint *il, blasint *iu, scs_float *abstol, blasint *m, scs_float *w,
+		scs_float *z, blasint *ldz, blasint *isuppz, scs_float *work, blasint *lwork, blasint *iwork, blasint *liwork,
+		blasint *info);
+
+/* the index of entry (i, j), i >= j, of an n x n block in the (column-wise, lower triangular) SD cone variables */
+static scs_int svecIndex(scs_int i, scs_int j, scs_int n) {
+	return j * n - (j * (j - 1)) / 2 + i - j;
+}
+
+/* c = 1, b = -svec(L / 4) and A x = -svec(diag(x)) */
+static void maxCutData(Data * d, Cone * k, scs_int n, scs_int bandwidth, scs_int arrow) {
+	scs_int i, j;
+	scs_float w;
+	AMatrix * A = d->A = scs_calloc(1, sizeof(AMatrix));
+	k->ssize = 1;
+	k->s = scs_malloc(sizeof(scs_int));
+	k->s[0] = n;
+	d->n = n;
+	d->m = (n * (n + 1)) / 2;
+	d->b = scs_calloc(d->m, sizeof(scs_float));
+	d->c = scs_malloc(n * sizeof(scs_float));
+	A->m = d->m;
+	A->n = n;
+	A->p = scs_malloc((n + 1) * sizeof(scs_int));
+	A->i = scs_malloc(n * sizeof(scs_int));
+	A->x = scs_malloc(n * sizeof(scs_float));
+	for (j = 0; j < n; ++j) {
+		for (i = j + 1; i < n; ++i) {
+			if (i - j <= bandwidth || i >= n - arrow) {
+				w = 0.25 * ABS(rand_scs_float());
+				d->b[svecIndex(i, j, n)] = SQRTF(2.0) * w;
+				d->b[svecIndex(i, i, n)] -= w;
+				d->b[svecIndex(j, j, n)] -= w;
+			}
+		}
+		d->c[j] = 1.0;
+		A->p[j] = j;
+		A->i[j] = svecIndex(j, j, n);
+		A->x[j] = -1.0;
+	}
+	A->p[n] = n;
+}
+
+/* smallest eigenvalue of the n x n block with SD cone variables x, relative to its largest magnitude */
+static scs_float minEig(const scs_float * x, scs_int n) {
+	scs_int i, j;
+	blasint nb = (blasint) n, m = 0, lwork = 26 * nb, liwork = 10 * nb, info;
+	scs_float vl, vu, abstol = 1e-12, ret;
+	scs_float *X = scs_malloc(n * n * sizeof(scs_float)), *e = scs_malloc(n * sizeof(scs_float));
+	scs_float *work = scs_malloc(lwork * sizeof(scs_float));
+	blasint * iwork = scs_malloc(liwork * sizeof(blasint));
+	for (j = 0; j < n; ++j) {
+		for (i = j; i < n; ++i) {
+			X[i + j * n] = (i == j ? 1.0 : 1.0 / SQRTF(2.0)) * x[svecIndex(i, j, n)];
+		}
+	}
+	BLAS(syevr)("NoVectors", "All", "Lower", &nb, X, &nb, &vl, &vu, SCS_NULL, SCS_NULL, &abstol, &m, e, SCS_NULL,
+			&nb, SCS_NULL, work, &lwork, iwork, &liwork, &info);
+	ret = e[0] / MAX(MAX(ABS(e[0]), ABS(e[n - 1])), 1e-12);
+	scs_free(X);
+	scs_free(e);
+	scs_free(work);
+	scs_free(iwork);
+	return ret;
+}
+
+/* largest of the relative primal and dual residuals of the original problem */
+static scs_float residual(const Data * d, const scs_float * c, const Sol * sol) {
+	scs_int i, j;
+	scs_float * pr = scs_malloc(d->m * sizeof(scs_float));
+	scs_float res, pres = 0.0, dres = 0.0, dr;
+	for (i = 0; i < d->m; ++i) {
+		pr[i] = d->b[i] - sol->s[i];
+	}
+	for (j = 0; j < d->n; ++j) {
+		dr = c[j];
+		for (i = d->A->p[j]; i < d->A->p[j + 1]; ++i) {
+			pr[d->A->i[i]] -= d->A->x[i] * sol->x[j];
+			dr += d->A->x[i] * sol->y[d->A->i[i]];
+		}
+		dres = MAX(dres, ABS(dr));
+	}
+	for (i = 0; i < d->m; ++i) {
+		pres = MAX(pres, ABS(pr[i]));
+	}
+	res = MAX(pres / (1 + calcNorm(d->b, d->m)), dres / (1 + calcNorm(c, d->n)));
+	scs_free(pr);
+	return res;
+}
+
+/* prints the solve and its checks, returns 1 if they fail */
+static scs_int report(const char * name, const Data * d, const scs_float * c, const Sol * sol, const Info * info,
+		scs_float obj) {
+	scs_float res = residual(d, c, sol), eigS = minEig(sol->s, d->n), eigY = minEig(sol->y, d->n);
+	scs_printf("%-28s %s in %4li iterations, %8.2f ms, objective %.6e, residual %.1e, min eig s %.1e, y %.1e\n", name,
+			info->status, (long) info->iter, info->setupTime + info->solveTime, info->pobj, res, eigS, eigY);
+	return (info->statusVal != SCS_SOLVED && info->statusVal != SCS_SOLVED_INACCURATE) || res > 10 * CHORDAL_BENCH_EPS || eigS < -1e-3 || eigY < -1e-3
+			|| ABS(info->pobj - obj) > 1e-2 * ABS(obj);
+}
+#endif
+
+int main(int argc, char **argv) {
+#ifdef LAPACK_LIB_FOUND
+	scs_int n = argc > 1 ? atoi(argv[1]) : 300;
+	scs_int bandwidth = argc > 2 ? atoi(argv[2]) : 3;
+	scs_int arrow = argc > 3 ? atoi(argv[3]) : 2;
+	int seed = argc > 4 ? atoi(argv[4]) : 1;
+	scs_int j, mode, fail = 0;
+	scs_float obj = 0.0, *Ax, *b[2], *c[2];
+	Data * d = scs_calloc(1, sizeof(Data));
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	Sol * sol = scs_calloc(2, sizeof(Sol));
+	Info info[2] = { { 0 }, { 0 } };
+	Work * w;
+
+	srand(seed);
+	maxCutData(d, k, n, bandwidth, arrow);
+	d->stgs = scs_calloc(1, sizeof(Settings));
+	setDefaultSettings(d);
+	d->stgs->verbose = 0;
+	d->stgs->eps = CHORDAL_BENCH_EPS;
+	scs_printf("max-cut SDP on %li vertices, band of width %li and %li arrow vertices\n", (long) n, (long) bandwidth,
+			(long) arrow);
+	for (mode = 0; mode < 2; ++mode) {
+		d->stgs->chordal_decomposition = mode;
+		scs(d, k, &(sol[0]), &(info[0]));
+		if (mode == 0) {
+			obj = info[0].pobj;
+		}
+		fail |= report(mode ? "chordal_decomposition = 1:" : "chordal_decomposition = 0:", d, d->c, &(sol[0]),
+				&(info[0]), obj);
+	}
+
+	w = scs_init(d, k, &(info[0]));
+	if (!w) {
+		scs_printf("scs_init failed\n");
+		return -1;
+	}
+	scs_solve(w, d, k, &(sol[0]), &(info[0]));
+	d->stgs->warm_start = 1;
+	scs_solve(w, d, k, &(sol[0]), &(info[0]));
+	d->stgs->warm_start = 0;
+	fail |= report("warm started:", d, d->c, &(sol[0]), &(info[0]), obj);
+
+	Ax = scs_malloc(n * sizeof(scs_float));
+	for (j = 0; j < n; ++j) {
+		Ax[j] = 2.0 * d->A->x[j];
+	}
+	fail |= scs_update_A(w, Ax) != 0;
+	scaleArray(d->A->x, 2.0, n);
+	scs_solve(w, d, k, &(sol[0]), &(info[0]));
+	fail |= report("A scaled by 2:", d, d->c, &(sol[0]), &(info[0]), 0.5 * obj);
+
+	for (j = 0; j < n; ++j) {
+		Ax[j] = 0.5 * d->A->x[j];
+	}
+	fail |= scs_update_A(w, Ax) != 0;
+	scaleArray(d->A->x, 0.5, n);
+	b[0] = b[1] = d->b;
+	c[0] = d->c;
+	c[1] = scs_malloc(n * sizeof(scs_float));
+	for (j = 0; j < n; ++j) {
+		c[1][j] = 2.0 * d->c[j];
+	}
+	fail |= scs_solve_batch(w, d, k, 2, b, c, sol, info) != 0;
+	fail |= report("batch, c:", d, c[0], &(sol[0]), &(info[0]), obj);
+	fail |= report("batch, 2 c:", d, c[1], &(sol[1]), &(info[1]), 2.0 * obj);
+	scs_finish(w);
+
+	scs_free(Ax);
+	scs_free(c[1]);
+	for (j = 0; j < 2; ++j) {
+		scs_free(sol[j].x);
+		scs_free(sol[j].y);
+		scs_free(sol[j].s);
+	}
+	scs_free(sol);
+	freeData(d, k);
+	return fail;
+#else
+	scs_printf("bench_chordal needs blas+lapack (USE_LAPACK = 1)\n");
+	return 0;
+#endif
+}
@@ -0,0 +1,148 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+#include <pthread.h>
+
+/*
+ stress test for reentrancy: solves the same set of random SOCPs from many threads at once
+ and checks every result is bit-for-bit identical to a sequential reference solve.
+
+ usage: concurrent_solves [num_threads] [num_problems] [rounds] [n]
+
+ each thread gets its own copy of every problem, since without COPYAMATRIX scs_init
+ normalizes A in place.
+ */
+
+typedef struct {
+	scs_int id, numProblems, rounds, failures;
+	Data ** d;
+	Cone ** k;
+	Sol * ref;
+	Info * refInfo;
+} Job;
+
+static void genProblem(scs_int n, int seed, Data ** dOut, Cone ** kOut, Sol * opt) {
+	scs_int m = 3 * n, col_nnz = (scs_int) ceil(sqrt(n)), rows, size;
+	Data * d = scs_calloc(1, sizeof(Data));
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	srand(seed);
+	d->stgs = scs_calloc(1, sizeof(Settings));
+	d->m = m;
+	d->n = n;
+	k->f = n / 3;
+	k->l = n;
+	rows = m - k->f - k->l;
+	k->q = scs_malloc(rows * sizeof(scs_int));
+	k->qsize = 0;
+	while (rows > 0) {
+		/* MIN evaluates its arguments twice */
+		size = 3 + rand() % 5;
+		size = MIN(size, rows);
+		k->q[k->qsize++] = size;
+		rows -= size;
+	}
+	genRandomProbData(n * col_nnz, col_nnz, d, k, opt);
+	setDefaultSettings(d);
+	d->stgs->verbose = 0;
+	d->stgs->eps = 1e-5;
+	*dOut = d;
+	*kOut = k;
+}
+
+static scs_int sameSolution(const Data * d, const Sol * a, const Info * ia, const Sol * b, const Info * ib) {
+	return ia->statusVal == ib->statusVal && ia->iter == ib->iter
+			&& !memcmp(a->x, b->x, d->n * sizeof(scs_float)) && !memcmp(a->y, b->y, d->m * sizeof(scs_float))
+			&& !memcmp(a->s, b->s, d->m * sizeof(scs_float));
+}
+
+static void * runJob(void * arg) {
+	Job * job = (Job *) arg;
+	scs_int r, p;
+	Info info = { 0 };
+	for (r = 0; r < job->rounds; ++r) {
+		for (p = 0; p < job->numProblems; ++p) {
+			/* vary the order between threads so different problems overlap */
+			scs_int q = (p + job->id) % job->numProblems;
+			Sol sol = { 0 };
+			scs(job->d[q], job->k[q], &sol, &info);
+			if (!sameSolution(job->d[q], &sol, &info, &(job->ref[q]), &(job->refInfo[q]))) {
+				scs_printf("thread %li, problem %li: result differs from sequential solve\n", (long) job->id, (long) q);
+				job->failures++;
+			}
+			scs_free(sol.x);
+			scs_free(sol.y);
+			scs_free(sol.s);
+		}
+	}
+	return SCS_NULL;
+}
+
+int main(int argc, char **argv) {
+	scs_int numThreads = argc > 1 ? atoi(argv[1]) : 8;
+	scs_int numProblems = argc > 2 ? atoi(argv[2]) : 4;
+	scs_int rounds = argc > 3 ? atoi(argv[3]) : 3;
+	scs_int n = argc > 4 ? atoi(argv[4]) : 200;
+	scs_int t, p, failures = 0;
+	Job * jobs = scs_calloc(numThreads, sizeof(Job));
+	pthread_t * threads = scs_malloc(numThreads * sizeof(pthread_t));
+	Sol * ref = scs_calloc(numProblems, sizeof(Sol));
+	Info * refInfo = scs_calloc(numProblems, sizeof(Info));
+	Sol opt = { 0 };
+	Data * d;
+	Cone * k;
+
+	/* sequential reference solves, problem data is generated serially since rand() is not reentrant */
+	for (p = 0; p < numProblems; ++p) {
+		genProblem(n, (int) p + 1, &d, &k, &opt);
+		scs(d, k, &(ref[p]), &(refInfo[p]));
+		scs_printf("problem %li: %s in %li iterations, pobj = %4f, true opt = %4f\n", (long) p, refInfo[p].status,
+				(long) refInfo[p].iter, refInfo[p].pobj, innerProd(d->c, opt.x, d->n));
+		freeData(d, k);
+		scs_free(opt.x);
+		scs_free(opt.y);
+		scs_free(opt.s);
+	}
+	for (t = 0; t < numThreads; ++t) {
+		jobs[t].id = t;
+		jobs[t].numProblems = numProblems;
+		jobs[t].rounds = rounds;
+		jobs[t].ref = ref;
+		jobs[t].refInfo = refInfo;
+		jobs[t].d = scs_malloc(numProblems * sizeof(Data *));
+		jobs[t].k = scs_malloc(numProblems * sizeof(Cone *));
+		for (p = 0; p < numProblems; ++p) {
+			genProblem(n, (int) p + 1, &(jobs[t].d[p]), &(jobs[t].k[p]), &opt);
+			scs_free(opt.x);
+			scs_free(opt.y);
+			scs_free(opt.s);
+		}
+	}
+
+	for (t = 0; t < numThreads; ++t) {
+		pthread_create(&(threads[t]), SCS_NULL, runJob, &(jobs[t]));
+	}
+	for (t = 0; t < numThreads; ++t) {
+		pthread_join(threads[t], SCS_NULL);
+		failures += jobs[t].failures;
+	}
+	scs_printf("%li threads x %li problems x %li rounds: %li mismatches\n", (long) numThreads, (long) numProblems,
+			(long) rounds, (long) failures);
+
+	for (t = 0; t < numThreads; ++t) {
+		for (p = 0; p < numProblems; ++p) {
+			freeData(jobs[t].d[p], jobs[t].k[p]);
+		}
+		scs_free(jobs[t].d);
+		scs_free(jobs[t].k);
+	}
+	for (p = 0; p < numProblems; ++p) {
+		scs_free(ref[p].x);
+		scs_free(ref[p].y);
+		scs_free(ref[p].s);
+	}
+	scs_free(ref);
+	scs_free(jobs);
+	scs_free(threads);
+	scs_free(refInfo);
+	return failures > 0;
+}
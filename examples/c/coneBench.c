@@ -0,0 +1,123 @@
+#include "scs.h"
+
+#ifdef OPENMP
+#include <omp.h>
+#endif
+
+/*
+ micro-benchmark of projDualCone on many SOC blocks, some mid-size SD blocks and power cones, comparing the cone
+ workspace set up for all threads (OMP_NUM_THREADS) with one set up for a single thread.
+
+ usage: bench_cones [num_soc] [num_sd] [sd_size] [num_pow] [rounds] [seed]
+
+ the blocks are disjoint, so both must give identical projections.
+ */
+
+static void randVec(scs_float * x, scs_int len) {
+	scs_int i;
+	for (i = 0; i < len; ++i) {
+		x[i] = (scs_float) rand() / RAND_MAX - 0.5;
+	}
+}
+
+/* fastest of rounds projections of x0, result in x and the times of the last one in info */
+static scs_float timeProjection(const scs_float * x0, scs_float * x, scs_int m, const Cone * k, ConeWork * c,
+		scs_int rounds, Info * info) {
+	scs_int r;
+	scs_float t, best = INFINITY;
+	timer projTimer;
+	for (r = 0; r < rounds; ++r) {
+		memcpy(x, x0, m * sizeof(scs_float));
+		tic(&projTimer);
+		if (projDualCone(x, k, c, SCS_NULL, -1) < 0) {
+			scs_printf("projDualCone failed\n");
+		}
+		t = tocq(&projTimer);
+		best = MIN(best, t);
+		getConeInfo(c, info);
+	}
+	return best;
+}
+
+int main(int argc, char **argv) {
+	scs_int numSoc = argc > 1 ? atoi(argv[1]) : 20000;
+#ifdef LAPACK_LIB_FOUND
+	scs_int numSd = argc > 2 ? atoi(argv[2]) : 24;
+	scs_int sdSize = argc > 3 ? atoi(argv[3]) : 60;
+#else
+	scs_int numSd = argc > 2 ? atoi(argv[2]) : 1000;
+	scs_int sdSize = 2; /* larger SD cones need lapack */
+#endif
+	scs_int numPow = argc > 4 ? atoi(argv[4]) : 2000;
+	scs_int rounds = argc > 5 ? atoi(argv[5]) : 5;
+	int seed = argc > 6 ? atoi(argv[6]) : 1;
+	scs_int i, m = 0, threads = 1, mismatch;
+	scs_float tSerial, tParallel, *x0, *xSerial, *xParallel;
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	Info serialInfo = { 0 }, parallelInfo = { 0 };
+	ConeWork * serial, *parallel;
+
+	srand(seed);
+	k->qsize = numSoc;
+	k->q = scs_malloc(numSoc * sizeof(scs_int));
+	for (i = 0; i < numSoc; ++i) {
+		k->q[i] = 3 + rand() % 5;
+		m += k->q[i];
+	}
+	k->ssize = numSd;
+	k->s = scs_malloc(numSd * sizeof(scs_int));
+	for (i = 0; i < numSd; ++i) {
+		k->s[i] = sdSize;
+		m += (sdSize * (sdSize + 1)) / 2;
+	}
+	k->psize = numPow;
+	k->p = scs_malloc(numPow * sizeof(scs_float));
+	for (i = 0; i < numPow; ++i) {
+		k->p[i] = 1.8 * rand() / RAND_MAX - 0.9;
+		m += 3;
+	}
+	x0 = scs_malloc(m * sizeof(scs_float));
+	xSerial = scs_malloc(m * sizeof(scs_float));
+	xParallel = scs_malloc(m * sizeof(scs_float));
+	randVec(x0, m);
+
+#ifdef OPENMP
+	threads = omp_get_max_threads();
+	omp_set_num_threads(1);
+#endif
+	serial = initCone(k);
+#ifdef OPENMP
+	omp_set_num_threads(threads);
+#endif
+	parallel = initCone(k);
+	if (!serial || !parallel) {
+		scs_printf("initCone failed\n");
+		return -1;
+	}
+	tSerial = timeProjection(x0, xSerial, m, k, serial, rounds, &serialInfo);
+	tParallel = timeProjection(x0, xParallel, m, k, parallel, rounds, &parallelInfo);
+	mismatch = memcmp(xSerial, xParallel, m * sizeof(scs_float)) != 0;
+
+	scs_printf("%li SOC, %li SD (size %li), %li power cones, m = %li, %li jobs on %li threads, fastest of %li\n",
+			(long) numSoc, (long) numSd, (long) sdSize, (long) numPow, (long) m, (long) parallel->numJobs,
+			(long) threads, (long) rounds);
+	scs_printf("1 thread:   %8.2f ms (last projection: SOC %.2f ms, SD %.2f ms, power %.2f ms)\n", tSerial,
+			serialInfo.socConeTime, serialInfo.sdConeTime, serialInfo.powConeTime);
+	scs_printf("%li threads: %8.2f ms (last projection: SOC %.2f ms, SD %.2f ms, power %.2f ms), %.2fx\n",
+			(long) threads, tParallel, parallelInfo.socConeTime, parallelInfo.sdConeTime, parallelInfo.powConeTime,
+			tSerial / tParallel);
+	if (mismatch) {
+		scs_printf("projections differ\n");
+	}
+
+	finishCone(serial);
+	finishCone(parallel);
+	scs_free(k->q);
+	scs_free(k->s);
+	scs_free(k->p);
+	scs_free(k);
+	scs_free(x0);
+	scs_free(xSerial);
+	scs_free(xParallel);
+	return mismatch;
+}
@@ -67,6 +67,17 @@ scs_int readInData(FILE * fp, Data * d, Cone * k) {
     stgs->rho_x = RHOX;
     stgs->warm_start = 0;
     stgs->scale = 1;
+    stgs->acceleration_lookback = ACCEL_LOOKBACK;
+    stgs->acceleration_type = ACCEL_TYPE;
+    stgs->adaptive_scale = ADAPTIVE_SCALE;
+    stgs->time_limit = TIME_LIMIT;
+    stgs->mixed_precision = MIXED_PRECISION;
+    stgs->sdp_warm_eig = SDP_WARM_EIG;
+    stgs->chordal_decomposition = CHORDAL_DECOMPOSITION;
+    stgs->supernodal = SUPERNODAL;
+    stgs->normal_equations = NORMAL_EQUATIONS;
+    stgs->factor_cache = FACTOR_CACHE;
+    stgs->tree_parallel = TREE_PARALLEL;
     if (fscanf(fp, INTRW, &(d->n)) != 1) {
         DEBUG_FUNC
         return -1;
@@ -0,0 +1,187 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+
+/*
+ benchmark of the exponential cone projection: the original bisection on the dual variable against projDualCone
+ (Newton steps on the dual variable), from scratch and warm started from the projection of a nearby point (as in
+ consecutive scs iterations), followed by a solve of a random problem with num_exp / 100 primal and dual exponential
+ cones.
+
+ usage: bench_exp [num_exp] [rounds] [seed]
+
+ both stop at a tolerance of about 1e-8 on the dual variable, but near the boundary of the cone the projection is
+ very sensitive to it, so they only agree to about 1e-5.
+ */
+
+#define OLD_CONE_TOL (1e-8)
+#define OLD_CONE_THRESH (1e-6)
+#define OLD_EXP_CONE_MAX_ITERS (100)
+
+static scs_float oldExpNewtonOneD(scs_float rho, scs_float y_hat, scs_float z_hat) {
+	scs_float t = MAX(-z_hat, 1e-6);
+	scs_float f, fp;
+	scs_int i;
+	for (i = 0; i < OLD_EXP_CONE_MAX_ITERS; ++i) {
+		f = t * (t + z_hat) / rho / rho - y_hat / rho + log(t / rho) + 1;
+		fp = (2 * t + z_hat) / rho / rho + 1 / t;
+		t = t - f / fp;
+		if (t <= -z_hat) {
+			return 0;
+		} else if (t <= 0) {
+			return z_hat;
+		} else if (ABS(f) < OLD_CONE_TOL) {
+			break;
+		}
+	}
+	return t + z_hat;
+}
+
+static scs_float oldExpCalcGrad(scs_float * v, scs_float * x, scs_float rho) {
+	x[2] = oldExpNewtonOneD(rho, v[1], v[2]);
+	x[1] = (x[2] - v[2]) * x[2] / rho;
+	x[0] = v[0] - rho;
+	if (x[1] <= 1e-12) {
+		return x[0];
+	}
+	return x[0] + x[1] * log(x[1] / x[2]);
+}
+
+/* projExpCone prior to the Newton steps on the dual variable */
+static void oldProjExpCone(scs_float * v) {
+	scs_int i;
+	scs_float ub, lb, rho, g, x[3];
+	scs_float r = v[0], s = v[1], t = v[2];
+	if ((s * exp(r / s) - t <= OLD_CONE_THRESH && s > 0) || (r <= 0 && s == 0 && t >= 0)) {
+		return;
+	}
+	if ((-r < 0 && r * exp(s / r) + exp(1) * t <= OLD_CONE_THRESH) || (-r == 0 && -s >= 0 && -t >= 0)) {
+		memset(v, 0, 3 * sizeof(scs_float));
+		return;
+	}
+	if (r < 0 && s < 0) {
+		v[1] = 0.0;
+		v[2] = MAX(v[2], 0);
+		return;
+	}
+	lb = 0;
+	ub = 0.125;
+	while (oldExpCalcGrad(v, x, ub) > 0) {
+		lb = ub;
+		ub *= 2;
+	}
+	for (i = 0; i < OLD_EXP_CONE_MAX_ITERS; ++i) {
+		rho = (ub + lb) / 2;
+		g = oldExpCalcGrad(v, x, rho);
+		if (g > 0) {
+			lb = rho;
+		} else {
+			ub = rho;
+		}
+		if (ub - lb < OLD_CONE_TOL) {
+			break;
+		}
+	}
+	v[0] = x[0];
+	v[1] = x[1];
+	v[2] = x[2];
+}
+
+static scs_float maxDiff(const scs_float * a, const scs_float * b, scs_int len) {
+	scs_int i;
+	scs_float d = 0.0;
+	for (i = 0; i < len; ++i) {
+		d = MAX(d, ABS(a[i] - b[i]));
+	}
+	return d;
+}
+
+int main(int argc, char **argv) {
+	scs_int numExp = argc > 1 ? atoi(argv[1]) : 100000;
+	scs_int rounds = argc > 2 ? atoi(argv[2]) : 3;
+	int seed = argc > 3 ? atoi(argv[3]) : 1;
+	scs_int i, r, len = 3 * numExp, n, m;
+	scs_float t, tOld = INFINITY, tNew = INFINITY, tWarm = INFINITY, diffNew, diffWarm;
+	scs_float *v0, *v1, *xOld, *xNew, *xWarm, *prev;
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	Data * d = scs_calloc(1, sizeof(Data));
+	Sol sol = { 0 }, opt = { 0 };
+	Info info = { 0 };
+	timer projTimer;
+
+	srand(seed);
+	/* v1 is v0 moved slightly, as between consecutive iterations */
+	v0 = scs_malloc(len * sizeof(scs_float));
+	v1 = scs_malloc(len * sizeof(scs_float));
+	xOld = scs_malloc(len * sizeof(scs_float));
+	xNew = scs_malloc(len * sizeof(scs_float));
+	xWarm = scs_malloc(len * sizeof(scs_float));
+	prev = scs_malloc(len * sizeof(scs_float));
+	for (i = 0; i < len; ++i) {
+		v0[i] = v1[i] = rand_gauss();
+	}
+	perturbVector(v1, len);
+
+	/* dual cones, projDualCone projects onto the exponential cone itself */
+	k->ed = numExp;
+	memcpy(prev, v0, len * sizeof(scs_float));
+	projDualCone(prev, k, SCS_NULL, SCS_NULL, -1);
+	for (r = 0; r < rounds; ++r) {
+		memcpy(xOld, v1, len * sizeof(scs_float));
+		tic(&projTimer);
+		for (i = 0; i < numExp; ++i) {
+			oldProjExpCone(&(xOld[3 * i]));
+		}
+		t = tocq(&projTimer);
+		tOld = MIN(tOld, t);
+
+		memcpy(xNew, v1, len * sizeof(scs_float));
+		tic(&projTimer);
+		projDualCone(xNew, k, SCS_NULL, SCS_NULL, -1);
+		t = tocq(&projTimer);
+		tNew = MIN(tNew, t);
+
+		memcpy(xWarm, v1, len * sizeof(scs_float));
+		tic(&projTimer);
+		projDualCone(xWarm, k, SCS_NULL, prev, -1);
+		t = tocq(&projTimer);
+		tWarm = MIN(tWarm, t);
+	}
+	diffNew = maxDiff(xOld, xNew, len);
+	diffWarm = maxDiff(xOld, xWarm, len);
+	scs_printf("%li exponential cone projections, fastest of %li\n", (long) numExp, (long) rounds);
+	scs_printf("bisection:            %8.2f ms\n", tOld);
+	scs_printf("newton:               %8.2f ms (%.2fx), max difference %.1e\n", tNew, tOld / tNew, diffNew);
+	scs_printf("newton, warm started: %8.2f ms (%.2fx), max difference %.1e\n", tWarm, tOld / tWarm, diffWarm);
+
+	/* a random problem with numExp / 100 primal and dual exponential cones */
+	k->ep = k->ed = MAX(numExp / 100, 1);
+	k->l = 3 * k->ep;
+	m = k->l + 3 * (k->ep + k->ed);
+	n = m / 3;
+	d->m = m;
+	d->n = n;
+	d->stgs = scs_calloc(1, sizeof(Settings));
+	genRandomProbData(n * 5, 5, d, k, &opt);
+	setDefaultSettings(d);
+	d->stgs->verbose = 0;
+	scs(d, k, &sol, &info);
+	scs_printf("random problem with %li primal and %li dual exponential cones: %s in %li iterations, "
+			"exp cone projections %.2f ms of %.2f ms\n", (long) k->ep, (long) k->ed, info.status, (long) info.iter,
+			info.expConeTime, info.solveTime);
+
+	freeData(d, k);
+	scs_free(sol.x);
+	scs_free(sol.y);
+	scs_free(sol.s);
+	scs_free(opt.x);
+	scs_free(opt.y);
+	scs_free(opt.s);
+	scs_free(v0);
+	scs_free(v1);
+	scs_free(xOld);
+	scs_free(xNew);
+	scs_free(xWarm);
+	scs_free(prev);
+	return diffNew > 1e-4 || diffWarm > 1e-4 || info.statusVal != SCS_SOLVED;
+}
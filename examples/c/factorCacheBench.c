@@ -0,0 +1,86 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+
+/*
+ benchmark of the factor_cache setting of the direct solver on a random SOCP with sqrt(n) nonzeros per column of A,
+ for the column and the supernodal factorization: scs_init without the cache, then twice with it in dir, the first
+ factors and stores (unless an earlier run did), the second loads the factorization.
+
+ usage: bench_factor_cache [n] [dir] [iters] [seed]
+
+ the loaded factorization is the stored one, so the results must be identical.
+ */
+
+static void freeSolVecs(Sol * sol) {
+	scs_free(sol->x);
+	scs_free(sol->y);
+	scs_free(sol->s);
+	sol->x = sol->y = sol->s = SCS_NULL;
+}
+
+int main(int argc, char **argv) {
+	scs_int n = argc > 1 ? atoi(argv[1]) : 1000;
+	const char * dir = argc > 2 ? argv[2] : ".";
+	scs_int iters = argc > 3 ? atoi(argv[3]) : 20;
+	int seed = argc > 4 ? atoi(argv[4]) : 1;
+	scs_int m = 3 * n, col_nnz = (scs_int) ceil(sqrt(n)), nnz = n * col_nnz, rows, size, mode, run, failures = 0;
+	Data * d = scs_calloc(1, sizeof(Data));
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	Sol opt = { 0 }, sol[3] = { { 0 }, { 0 }, { 0 } };
+	Info info[3] = { { 0 }, { 0 }, { 0 } };
+
+	srand(seed);
+	d->stgs = scs_calloc(1, sizeof(Settings));
+	d->m = m;
+	d->n = n;
+	k->f = n / 3;
+	k->l = n;
+	rows = m - k->f - k->l;
+	k->q = scs_malloc(rows * sizeof(scs_int));
+	while (rows > 0) {
+		/* MIN evaluates its arguments twice */
+		size = 3 + rand() % 5;
+		size = MIN(size, rows);
+		k->q[k->qsize++] = size;
+		rows -= size;
+	}
+	genRandomProbData(nnz, col_nnz, d, k, &opt);
+	setDefaultSettings(d);
+	d->stgs->verbose = 0;
+	d->stgs->max_iters = iters;
+	d->stgs->eps = 1e-12;
+	/* scs normalizes A in place, copied when COPYAMATRIX, so all solves see the same data */
+	for (mode = 0; mode < 2; ++mode) {
+		d->stgs->supernodal = mode;
+		for (run = 0; run < 3; ++run) {
+			d->stgs->factor_cache = run ? dir : SCS_NULL;
+			scs(d, k, &(sol[run]), &(info[run]));
+		}
+		scs_printf("%-13s nnz(L) = %9li, setup %8.2f ms without the cache, %8.2f ms (%s), %8.2f ms (%s)\n",
+				mode ? "supernodal:" : "column LDL':", (long) info[0].nnzL, info[0].setupTime, info[1].setupTime,
+				info[1].factorCacheHit ? "hit" : "miss", info[2].setupTime, info[2].factorCacheHit ? "hit" : "miss");
+		for (run = 1; run < 3; ++run) {
+			if (memcmp(sol[0].x, sol[run].x, n * sizeof(scs_float)) || memcmp(sol[0].y, sol[run].y, m * sizeof(scs_float))
+					|| info[run].iter != info[0].iter) {
+				scs_printf("%s: the solution with the cache (run %li) differs\n", mode ? "supernodal" : "column LDL'",
+						(long) run);
+				failures++;
+			}
+		}
+		if (info[0].factorCacheHit != -1 || info[1].factorCacheHit < 0 || info[2].factorCacheHit != 1) {
+			scs_printf("unexpected cache use: %li %li %li\n", (long) info[0].factorCacheHit,
+					(long) info[1].factorCacheHit, (long) info[2].factorCacheHit);
+			failures++;
+		}
+		for (run = 0; run < 3; ++run) {
+			freeSolVecs(&(sol[run]));
+		}
+	}
+	d->stgs->factor_cache = SCS_NULL;
+	freeData(d, k);
+	scs_free(opt.x);
+	scs_free(opt.y);
+	scs_free(opt.s);
+	return failures;
+}
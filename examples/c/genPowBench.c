@@ -0,0 +1,164 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+
+/*
+ benchmark of the generalized power cone on a weighted geometric mean: maximize prod_s (1 + f_s'x)^pi_s over the
+ unit ball ||x|| <= 1 in R^num_vars, for num_terms random f_s and weights pi (e.g. the growth of a portfolio x of
+ long and short positions over scenarios s with returns f_s and probabilities pi). solved once with one generalized
+ power cone (num_terms + 1 rows) and once with the geometric mean as a chain of num_terms - 1 three dimensional power
+ cones, w_s = w_(s-1)^a_s (1 + f_s'x)^(1 - a_s), and their auxiliary variables w_s.
+
+ usage: bench_gen_pow [num_terms] [num_vars] [seed]
+
+ the objectives of the two must agree.
+ */
+
+#define GEN_POW_BENCH_EPS (1e-5)
+
+/* A in column compressed form from the dense m x n column-major matrix M */
+static AMatrix * compressA(const scs_float * M, scs_int m, scs_int n) {
+	scs_int i, j, nnz = 0;
+	AMatrix * A = scs_calloc(1, sizeof(AMatrix));
+	for (i = 0; i < m * n; ++i) {
+		nnz += M[i] != 0.0;
+	}
+	A->m = m;
+	A->n = n;
+	A->p = scs_malloc((n + 1) * sizeof(scs_int));
+	A->i = scs_malloc(nnz * sizeof(scs_int));
+	A->x = scs_malloc(nnz * sizeof(scs_float));
+	for (j = 0, nnz = 0; j < n; ++j) {
+		A->p[j] = nnz;
+		for (i = 0; i < m; ++i) {
+			if (M[i + j * m] != 0.0) {
+				A->i[nnz] = i;
+				A->x[nnz++] = M[i + j * m];
+			}
+		}
+	}
+	A->p[n] = nnz;
+	return A;
+}
+
+/*
+ * fills d and k with the weighted geometric mean of 1 + F x (F num_terms x num_vars, column-major) with weights pi,
+ * the variables are x then the geometric mean (and if chain the partial ones). the first rows are the SOC of the
+ * unit ball, then the cones
+ */
+static void geoMeanData(Data * d, Cone * k, const scs_float * F, const scs_float * pi, scs_int ns, scs_int na,
+		scs_int chain) {
+	scs_int i, s, row, m, n = chain ? na + ns - 1 : na + 1;
+	scs_float * M, cum = pi[0];
+	k->qsize = 1;
+	k->q = scs_malloc(sizeof(scs_int));
+	k->q[0] = na + 1;
+	if (chain) {
+		k->psize = ns - 1;
+		k->p = scs_malloc(k->psize * sizeof(scs_float));
+		m = 1 + na + 3 * k->psize;
+	} else {
+		k->gpsize = 1;
+		k->gpm = scs_malloc(sizeof(scs_int));
+		k->gpn = scs_malloc(sizeof(scs_int));
+		k->gpa = scs_malloc(ns * sizeof(scs_float));
+		k->gpm[0] = ns;
+		k->gpn[0] = 1;
+		memcpy(k->gpa, pi, ns * sizeof(scs_float));
+		m = 1 + na + ns + 1;
+	}
+	d->m = m;
+	d->n = n;
+	d->b = scs_calloc(m, sizeof(scs_float));
+	d->c = scs_calloc(n, sizeof(scs_float));
+	M = scs_calloc(m * n, sizeof(scs_float));
+	d->b[0] = 1.0;
+	for (i = 0; i < na; ++i) {
+		M[1 + i + i * m] = -1.0;
+	}
+	row = 1 + na;
+	if (chain) {
+		/* cone s - 1: (w_(s-1), 1 + f_s'x, w_s) with w_0 = 1 + f_0'x, w_s the variable na + s - 1 */
+		for (s = 1; s < ns; ++s, row += 3) {
+			k->p[s - 1] = cum / (cum + pi[s]);
+			cum += pi[s];
+			d->b[row] = s == 1 ? 1.0 : 0.0;
+			d->b[row + 1] = 1.0;
+			for (i = 0; i < na; ++i) {
+				if (s == 1) {
+					M[row + i * m] = -F[i * ns];
+				}
+				M[row + 1 + i * m] = -F[s + i * ns];
+			}
+			if (s > 1) {
+				M[row + (na + s - 2) * m] = -1.0;
+			}
+			M[row + 2 + (na + s - 1) * m] = -1.0;
+		}
+		d->c[n - 1] = -1.0;
+	} else {
+		for (s = 0; s < ns; ++s) {
+			d->b[row + s] = 1.0;
+			for (i = 0; i < na; ++i) {
+				M[row + s + i * m] = -F[s + i * ns];
+			}
+		}
+		M[row + ns + na * m] = -1.0;
+		d->c[na] = -1.0;
+	}
+	d->A = compressA(M, m, n);
+	scs_free(M);
+}
+
+int main(int argc, char **argv) {
+	scs_int ns = argc > 1 ? atoi(argv[1]) : 200;
+	scs_int na = argc > 2 ? atoi(argv[2]) : 50;
+	int seed = argc > 3 ? atoi(argv[3]) : 1;
+	scs_int i, s, chain;
+	scs_float obj[2], sum = 0.0, mu, *F = scs_malloc(ns * na * sizeof(scs_float));
+	scs_float * pi = scs_malloc(ns * sizeof(scs_float));
+	Sol sol = { 0 };
+	Info info[2] = { { 0 }, { 0 } };
+	Data * d;
+	Cone * k;
+
+	srand(seed);
+	/* |f_s'x| <= ||f_s|| < 1 on the unit ball, so the terms stay positive */
+	for (i = 0; i < na; ++i) {
+		mu = 0.1 * rand_gauss();
+		for (s = 0; s < ns; ++s) {
+			F[s + i * ns] = (mu + 0.3 * rand_gauss()) / (2 * SQRTF((scs_float) na));
+		}
+	}
+	for (s = 0; s < ns; ++s) {
+		pi[s] = 1.0 + 0.5 * rand_scs_float();
+		sum += pi[s];
+	}
+	scaleArray(pi, 1.0 / sum, ns);
+	scs_printf("weighted geometric mean of %li terms in %li variables\n", (long) ns, (long) na);
+	for (chain = 0; chain < 2; ++chain) {
+		d = scs_calloc(1, sizeof(Data));
+		k = scs_calloc(1, sizeof(Cone));
+		geoMeanData(d, k, F, pi, ns, na, chain);
+		d->stgs = scs_calloc(1, sizeof(Settings));
+		setDefaultSettings(d);
+		d->stgs->verbose = 0;
+		d->stgs->eps = GEN_POW_BENCH_EPS;
+		scs(d, k, &sol, &(info[chain]));
+		obj[chain] = info[chain].pobj;
+		scs_printf("%-22s m = %5li, n = %5li: %s in %5li iterations, %8.2f ms (cones %7.2f ms), objective %.6e\n",
+				chain ? "power cone chain:" : "generalized power cone:", (long) d->m, (long) d->n, info[chain].status,
+				(long) info[chain].iter, info[chain].setupTime + info[chain].solveTime, info[chain].coneTime,
+				obj[chain]);
+		freeData(d, k);
+		scs_free(sol.x);
+		scs_free(sol.y);
+		scs_free(sol.s);
+		sol.x = sol.y = sol.s = SCS_NULL;
+	}
+	scs_printf("objective difference %.1e\n", ABS(obj[1] - obj[0]));
+	scs_free(F);
+	scs_free(pi);
+	return info[0].statusVal != SCS_SOLVED || info[1].statusVal != SCS_SOLVED
+			|| ABS(obj[1] - obj[0]) > 1e-3 * (1 + ABS(obj[0]));
+}
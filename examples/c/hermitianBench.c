@@ -0,0 +1,196 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+
+/*
+ benchmark of the Hermitian PSD cone on the phase synchronization SDP in its dual form, minimize sum(x) subject to
+ diag(x) - C PSD, for C = z z^H + sigma W with z a vector of n random unit phases and W a Hermitian Gaussian matrix.
+ solved once with C in the n x n Hermitian PSD cone (n^2 rows) and once with its real embedding
+ [Re(C) -Im(C); Im(C) Re(C)], PSD if and only if C is, in a 2n x 2n SD cone (n (2n + 1) rows).
+
+ usage: bench_hermitian [n] [sigma] [seed]
+
+ the objectives must agree, and the slack of the Hermitian solve must be PSD.
+ */
+
+#define HERMITIAN_BENCH_EPS (1e-4)
+
+#ifdef LAPACK_LIB_FOUND
+void BLAS(syevr)(const char *jobz, const char *range, const char *uplo, blasint *n, scs_float *a, blasint *lda,
+		scs_float *vl, scs_float *vu, blasint *il, blasint *iu, scs_float *abstol, blasint *m, scs_float *w,
+		scs_float *z, blasint *ldz, blasint *isuppz, scs_float *work, blasint *lwork, blasint *iwork, blasint *liwork,
+		blasint *info);
+
+/* the index of entry (i, j), i >= j, of an n x n block in the (column-wise, lower triangular) SD cone variables */
+static scs_int svecIndex(scs_int i, scs_int j, scs_int n) {
+	return j * n - (j * (j - 1)) / 2 + i - j;
+}
+
+/* the index of entry (i, j), i >= j, of an n x n block in the Hermitian PSD cone variables, of its real part */
+static scs_int hvecIndex(scs_int i, scs_int j, scs_int n) {
+	return j * (2 * n - j) + (i == j ? 0 : 2 * (i - j) - 1);
+}
+
+/* entry (i, j) of the 2n x 2n real embedding of the Hermitian matrix with real and imaginary parts re and im */
+static scs_float embedEntry(const scs_float * re, const scs_float * im, scs_int n, scs_int i, scs_int j) {
+	scs_int a = i % n, b = j % n;
+	if ((i < n) == (j < n)) {
+		return re[a + b * n];
+	}
+	return i >= n ? im[a + b * n] : -im[a + b * n];
+}
+
+/* c = 1, b = -vec(C) and A x = -vec(diag(x)), in the Hermitian PSD cone or if embed in the SD cone */
+static void phaseSyncData(Data * d, Cone * k, const scs_float * re, const scs_float * im, scs_int n, scs_int embed) {
+	scs_int i, j, N = 2 * n;
+	scs_float sqrt2 = SQRTF(2.0);
+	AMatrix * A = d->A = scs_calloc(1, sizeof(AMatrix));
+	d->n = n;
+	if (embed) {
+		k->ssize = 1;
+		k->s = scs_malloc(sizeof(scs_int));
+		k->s[0] = N;
+		d->m = (N * (N + 1)) / 2;
+	} else {
+		k->cssize = 1;
+		k->cs = scs_malloc(sizeof(scs_int));
+		k->cs[0] = n;
+		d->m = n * n;
+	}
+	d->b = scs_calloc(d->m, sizeof(scs_float));
+	d->c = scs_malloc(n * sizeof(scs_float));
+	A->m = d->m;
+	A->n = n;
+	A->p = scs_malloc((n + 1) * sizeof(scs_int));
+	A->i = scs_malloc(2 * n * sizeof(scs_int));
+	A->x = scs_malloc(2 * n * sizeof(scs_float));
+	if (embed) {
+		for (j = 0; j < N; ++j) {
+			for (i = j; i < N; ++i) {
+				d->b[svecIndex(i, j, N)] = -(i == j ? 1.0 : sqrt2) * embedEntry(re, im, n, i, j);
+			}
+		}
+	} else {
+		for (j = 0; j < n; ++j) {
+			d->b[hvecIndex(j, j, n)] = -re[j + j * n];
+			for (i = j + 1; i < n; ++i) {
+				d->b[hvecIndex(i, j, n)] = -sqrt2 * re[i + j * n];
+				d->b[hvecIndex(i, j, n) + 1] = -sqrt2 * im[i + j * n];
+			}
+		}
+	}
+	for (j = 0; j < n; ++j) {
+		d->c[j] = 1.0;
+		A->p[j] = embed ? 2 * j : j;
+		if (embed) {
+			A->i[2 * j] = svecIndex(j, j, N);
+			A->x[2 * j] = -1.0;
+			A->i[2 * j + 1] = svecIndex(n + j, n + j, N);
+			A->x[2 * j + 1] = -1.0;
+		} else {
+			A->i[j] = hvecIndex(j, j, n);
+			A->x[j] = -1.0;
+		}
+	}
+	A->p[n] = embed ? 2 * n : n;
+}
+
+/* smallest eigenvalue of the n x n Hermitian block with cone variables x, relative to its largest magnitude */
+static scs_float minEig(const scs_float * x, scs_int n) {
+	scs_int i, j, N = 2 * n;
+	blasint nb = (blasint) N, m = 0, lwork = 26 * nb, liwork = 10 * nb, info;
+	scs_float vl, vu, abstol = 1e-12, ret, sqrt2Inv = 1.0 / SQRTF(2.0);
+	scs_float *re = scs_calloc(n * n, sizeof(scs_float)), *im = scs_calloc(n * n, sizeof(scs_float));
+	scs_float *X = scs_malloc(N * N * sizeof(scs_float)), *e = scs_malloc(N * sizeof(scs_float));
+	scs_float * work = scs_malloc(lwork * sizeof(scs_float));
+	blasint * iwork = scs_malloc(liwork * sizeof(blasint));
+	for (j = 0; j < n; ++j) {
+		re[j + j * n] = x[hvecIndex(j, j, n)];
+		for (i = j + 1; i < n; ++i) {
+			re[i + j * n] = re[j + i * n] = sqrt2Inv * x[hvecIndex(i, j, n)];
+			im[i + j * n] = sqrt2Inv * x[hvecIndex(i, j, n) + 1];
+			im[j + i * n] = -im[i + j * n];
+		}
+	}
+	for (j = 0; j < N; ++j) {
+		for (i = j; i < N; ++i) {
+			X[i + j * N] = embedEntry(re, im, n, i, j);
+		}
+	}
+	BLAS(syevr)("NoVectors", "All", "Lower", &nb, X, &nb, &vl, &vu, SCS_NULL, SCS_NULL, &abstol, &m, e, SCS_NULL,
+			&nb, SCS_NULL, work, &lwork, iwork, &liwork, &info);
+	ret = e[0] / MAX(MAX(ABS(e[0]), ABS(e[N - 1])), 1e-12);
+	scs_free(re);
+	scs_free(im);
+	scs_free(X);
+	scs_free(e);
+	scs_free(work);
+	scs_free(iwork);
+	return ret;
+}
+#endif
+
+int main(int argc, char **argv) {
+#ifdef LAPACK_LIB_FOUND
+	scs_int n = argc > 1 ? atoi(argv[1]) : 80;
+	scs_float sigma = argc > 2 ? atof(argv[2]) : 1.0;
+	int seed = argc > 3 ? atoi(argv[3]) : 1;
+	scs_int i, j, embed;
+	scs_float eig = 0.0, obj[2], w, *theta = scs_malloc(n * sizeof(scs_float));
+	scs_float *re = scs_malloc(n * n * sizeof(scs_float)), *im = scs_malloc(n * n * sizeof(scs_float));
+	Sol sol = { 0 };
+	Info info[2] = { { 0 }, { 0 } };
+	Data * d;
+	Cone * k;
+
+	srand(seed);
+	for (i = 0; i < n; ++i) {
+		theta[i] = 2 * M_PI * ABS(rand_scs_float());
+	}
+	/* C = z z^H + sigma W, W with standard complex Gaussian entries below the diagonal and real ones on it */
+	for (j = 0; j < n; ++j) {
+		re[j + j * n] = 1.0 + sigma * rand_gauss();
+		im[j + j * n] = 0.0;
+		for (i = j + 1; i < n; ++i) {
+			w = sigma / SQRTF(2.0);
+			re[i + j * n] = cos(theta[i] - theta[j]) + w * rand_gauss();
+			im[i + j * n] = sin(theta[i] - theta[j]) + w * rand_gauss();
+			re[j + i * n] = re[i + j * n];
+			im[j + i * n] = -im[i + j * n];
+		}
+	}
+	scs_printf("phase synchronization SDP on %li phases, noise %.2f\n", (long) n, sigma);
+	for (embed = 0; embed < 2; ++embed) {
+		d = scs_calloc(1, sizeof(Data));
+		k = scs_calloc(1, sizeof(Cone));
+		phaseSyncData(d, k, re, im, n, embed);
+		d->stgs = scs_calloc(1, sizeof(Settings));
+		setDefaultSettings(d);
+		d->stgs->verbose = 0;
+		d->stgs->eps = HERMITIAN_BENCH_EPS;
+		scs(d, k, &sol, &(info[embed]));
+		obj[embed] = info[embed].pobj;
+		scs_printf("%-16s m = %6li: %s in %5li iterations, %8.2f ms (cones %8.2f ms), objective %.6e\n",
+				embed ? "real embedding:" : "Hermitian cone:", (long) d->m, info[embed].status, (long) info[embed].iter,
+				info[embed].setupTime + info[embed].solveTime, info[embed].coneTime, obj[embed]);
+		if (!embed) {
+			eig = MIN(minEig(sol.s, n), minEig(sol.y, n));
+			scs_printf("Hermitian cone min eig of s and y %.1e\n", eig);
+		}
+		freeData(d, k);
+		scs_free(sol.x);
+		scs_free(sol.y);
+		scs_free(sol.s);
+		sol.x = sol.y = sol.s = SCS_NULL;
+	}
+	scs_printf("objective difference %.1e\n", ABS(obj[1] - obj[0]));
+	scs_free(theta);
+	scs_free(re);
+	scs_free(im);
+	return info[0].statusVal != SCS_SOLVED || info[1].statusVal != SCS_SOLVED || eig < -1e-3
+			|| ABS(obj[1] - obj[0]) > 1e-3 * (1 + ABS(obj[0]));
+#else
+	scs_printf("bench_hermitian needs blas+lapack (USE_LAPACK = 1)\n");
+	return 0;
+#endif
+}
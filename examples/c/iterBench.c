@@ -0,0 +1,171 @@
+#include "scs.h"
+#include "linAlg.h"
+
+/*
+ micro-benchmark of the element-wise work in one scs iteration (everything except the
+ linear system solve, the cone projection is replaced by the nonnegative orthant), comparing the original sequence of
+ separate passes with the fused kernels used in scs.c.
+
+ usage: bench_iter [n] [m] [iters]
+
+ bytes moved are counted as scs_float reads plus writes over vectors of length n + m + 1,
+ assuming nothing stays in cache between passes (true once n + m is large).
+ */
+
+/* vectors read, written per element of u for each version (the stand-in projection is not counted) */
+#define SEPARATE_READS 20
+#define SEPARATE_WRITES 8
+#define FUSED_READS 12
+#define FUSED_WRITES 5
+
+static void randVec(scs_float * x, scs_int len) {
+	scs_int i;
+	for (i = 0; i < len; ++i) {
+		x[i] = (scs_float) rand() / RAND_MAX - 0.5;
+	}
+}
+
+/* stands in for the cone projection, keeps the iterates bounded */
+static void nonnegProj(scs_float * x, scs_int len) {
+	scs_int i;
+	for (i = 0; i < len; ++i) {
+		if (x[i] < 0)
+			x[i] = 0;
+	}
+}
+
+/* scs.c prior to fusing: u_prev copy, projectLinSys, projectCones, updateDualVars */
+static void separateIter(scs_int n, scs_int m, scs_float rho_x, scs_float alpha, scs_float gTh, scs_float *u,
+		scs_float *v, scs_float *u_t, scs_float *u_prev, const scs_float *h, const scs_float *g) {
+	scs_int i, l = n + m + 1;
+	memcpy(u_prev, u, l * sizeof(scs_float));
+	memcpy(u_t, u, l * sizeof(scs_float));
+	addScaledArray(u_t, v, l, 1.0);
+	scaleArray(u_t, rho_x, n);
+	addScaledArray(u_t, h, l - 1, -u_t[l - 1]);
+	addScaledArray(u_t, h, l - 1, -innerProd(u_t, g, l - 1) / (gTh + 1));
+	scaleArray(&(u_t[n]), -1, m);
+	/* linear system solve */
+	u_t[l - 1] += innerProd(u_t, h, l - 1);
+	for (i = 0; i < n; ++i) {
+		u[i] = u_t[i] - v[i];
+	}
+	for (i = n; i < l; ++i) {
+		u[i] = alpha * u_t[i] + (1 - alpha) * u_prev[i] - v[i];
+	}
+	nonnegProj(&(u[n]), m + 1);
+	for (i = n; i < l; ++i) {
+		v[i] += (u[i] - alpha * u_t[i] - (1.0 - alpha) * u_prev[i]);
+	}
+}
+
+/* same as the fused kernels in scs.c, the caller rotates u and u_prev */
+static void fusedIter(scs_int n, scs_int m, scs_float rho_x, scs_float alpha, scs_float gTh, scs_float *u,
+		scs_float *v, scs_float *u_t, scs_float *u_prev, const scs_float *h, const scs_float *g) {
+	scs_int i, l = n + m + 1;
+	scs_float tau, ip = 0;
+	tau = u_t[l - 1] = u_prev[l - 1] + v[l - 1];
+	for (i = 0; i < n; ++i) {
+		u_t[i] = rho_x * (u_prev[i] + v[i]) - h[i] * tau;
+		ip += u_t[i] * g[i];
+	}
+	for (i = n; i < l - 1; ++i) {
+		u_t[i] = u_prev[i] + v[i] - h[i] * tau;
+		ip += u_t[i] * g[i];
+	}
+	ip /= (gTh + 1);
+	for (i = 0; i < n; ++i) {
+		u_t[i] -= h[i] * ip;
+	}
+	for (i = n; i < l - 1; ++i) {
+		u_t[i] = h[i] * ip - u_t[i];
+	}
+	/* linear system solve */
+	ip = 0;
+	for (i = 0; i < n; ++i) {
+		u[i] = u_t[i] - v[i];
+		ip += u_t[i] * h[i];
+	}
+	for (i = n; i < l - 1; ++i) {
+		u[i] = alpha * u_t[i] + (1 - alpha) * u_prev[i] - v[i];
+		v[i] = -u[i];
+		ip += u_t[i] * h[i];
+	}
+	u_t[l - 1] += ip;
+	u[l - 1] = alpha * u_t[l - 1] + (1 - alpha) * u_prev[l - 1] - v[l - 1];
+	v[l - 1] = -u[l - 1];
+	nonnegProj(&(u[n]), m + 1);
+	for (i = n; i < l; ++i) {
+		v[i] += u[i];
+	}
+}
+
+int main(int argc, char **argv) {
+	scs_int n = argc > 1 ? atoi(argv[1]) : 1000000;
+	scs_int m = argc > 2 ? atoi(argv[2]) : 3 * n;
+	scs_int iters = argc > 3 ? atoi(argv[3]) : 50;
+	scs_int i, l = n + m + 1;
+	scs_float tSep, tFused, mb, diff, *tmp;
+	scs_float *u = scs_malloc(l * sizeof(scs_float)), *v = scs_malloc(l * sizeof(scs_float));
+	scs_float *u_t = scs_malloc(l * sizeof(scs_float)), *u_prev = scs_malloc(l * sizeof(scs_float));
+	scs_float *h = scs_malloc(l * sizeof(scs_float)), *g = scs_malloc(l * sizeof(scs_float));
+	scs_float *u2 = scs_malloc(l * sizeof(scs_float)), *v2 = scs_malloc(l * sizeof(scs_float));
+	scs_float *u_prev2 = scs_malloc(l * sizeof(scs_float));
+	timer t;
+
+	if (!u || !v || !u_t || !u_prev || !h || !g || !u2 || !v2 || !u_prev2) {
+		scs_printf("memory allocation failure\n");
+		return -1;
+	}
+	srand(0);
+	randVec(u, l);
+	randVec(v, l);
+	randVec(h, l);
+	randVec(g, l);
+	scaleArray(h, 1.0 / SQRTF((scs_float) l), l);
+	scaleArray(g, 1.0 / SQRTF((scs_float) l), l);
+	memcpy(u2, u, l * sizeof(scs_float));
+	memcpy(v2, v, l * sizeof(scs_float));
+
+	/* check both versions agree after one iteration from the same point */
+	separateIter(n, m, 1e-3, 1.5, 1.0, u, v, u_t, u_prev, h, g);
+	tmp = u_prev2;
+	u_prev2 = u2;
+	u2 = tmp;
+	fusedIter(n, m, 1e-3, 1.5, 1.0, u2, v2, u_t, u_prev2, h, g);
+	diff = MAX(calcNormInfDiff(u, u2, l) / calcNormInf(u, l), calcNormInfDiff(v, v2, l) / calcNormInf(v, l));
+
+	tic(&t);
+	for (i = 0; i < iters; ++i) {
+		separateIter(n, m, 1e-3, 1.5, 1.0, u, v, u_t, u_prev, h, g);
+	}
+	tSep = tocq(&t) / iters;
+
+	tic(&t);
+	for (i = 0; i < iters; ++i) {
+		tmp = u_prev2;
+		u_prev2 = u2;
+		u2 = tmp;
+		fusedIter(n, m, 1e-3, 1.5, 1.0, u2, v2, u_t, u_prev2, h, g);
+	}
+	tFused = tocq(&t) / iters;
+
+	mb = l * sizeof(scs_float) / 1e6;
+	scs_printf("n = %li, m = %li, %li iterations, relative difference between versions %1.2e\n", (long) n, (long) m,
+			(long) iters, diff);
+	scs_printf("separate passes: %6.1f MB moved per iteration, %8.3f ms per iteration, %6.2f GB/s\n",
+			(SEPARATE_READS + SEPARATE_WRITES) * mb, tSep, (SEPARATE_READS + SEPARATE_WRITES) * mb / tSep);
+	scs_printf("fused passes:    %6.1f MB moved per iteration, %8.3f ms per iteration, %6.2f GB/s\n",
+			(FUSED_READS + FUSED_WRITES) * mb, tFused, (FUSED_READS + FUSED_WRITES) * mb / tFused);
+
+	scs_free(u);
+	scs_free(v);
+	scs_free(u_t);
+	scs_free(u_prev);
+	scs_free(h);
+	scs_free(g);
+	scs_free(u2);
+	scs_free(v2);
+	scs_free(u_prev2);
+	return 0;
+}
@@ -0,0 +1,89 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+
+/*
+ benchmark of mixed_precision against pure double precision solves, for one random LP / SOCP solved to a tight
+ tolerance with the same workspace (so both use the same factorization / data).
+
+ usage: bench_mixed [n] [eps] [rounds] [seed]
+
+ each mode is solved rounds times and the fastest solve is reported, the solutions should agree to about eps.
+ */
+
+static void printSolve(const char * name, const Info * info, scs_float t) {
+	scs_printf("%-8s %-10s iters %5li (single %5li)  resPri %.1e  resDual %.1e  relGap %.1e  pobj % .8e"
+			"  time %8.2f ms (lin-sys %8.2f ms)\n", name, info->status, (long) info->iter, (long) info->singleIters,
+			info->resPri, info->resDual, info->relGap, info->pobj, t, info->linSysTime);
+}
+
+int main(int argc, char **argv) {
+	scs_int n = argc > 1 ? atoi(argv[1]) : 1000;
+	scs_float eps = argc > 2 ? atof(argv[2]) : 1e-6;
+	scs_int rounds = argc > 3 ? atoi(argv[3]) : 3;
+	int seed = argc > 4 ? atoi(argv[4]) : 1;
+	scs_int m = 3 * n, col_nnz = (scs_int) ceil(sqrt(n)), rows, size, r, mode;
+	scs_float best[2] = { INFINITY, INFINITY }, t, diff;
+	Data * d = scs_calloc(1, sizeof(Data));
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	Sol opt = { 0 }, sol[2] = { { 0 } };
+	Info info = { 0 }, solveInfo[2];
+	const char * names[2] = { "double", "mixed" };
+	Work * w;
+	timer solveTimer;
+
+	srand(seed);
+	d->stgs = scs_calloc(1, sizeof(Settings));
+	d->m = m;
+	d->n = n;
+	k->f = n / 3;
+	k->l = n;
+	rows = m - k->f - k->l;
+	k->q = scs_malloc(rows * sizeof(scs_int));
+	while (rows > 0) {
+		/* MIN evaluates its arguments twice */
+		size = 3 + rand() % 5;
+		size = MIN(size, rows);
+		k->q[k->qsize++] = size;
+		rows -= size;
+	}
+	genRandomProbData(n * col_nnz, col_nnz, d, k, &opt);
+	setDefaultSettings(d);
+	d->stgs->verbose = 0;
+	d->stgs->eps = eps;
+	d->stgs->max_iters = 100000;
+
+	w = scs_init(d, k, &info);
+	if (!w) {
+		scs_printf("scs_init failed\n");
+		return -1;
+	}
+	for (r = 0; r < rounds; ++r) {
+		for (mode = 0; mode < 2; ++mode) {
+			d->stgs->mixed_precision = mode;
+			tic(&solveTimer);
+			scs_solve(w, d, k, &(sol[mode]), &(solveInfo[mode]));
+			t = tocq(&solveTimer);
+			best[mode] = MIN(best[mode], t);
+		}
+	}
+	scs_printf("n = %li, m = %li, nnz(A) = %li, eps = %.0e, fastest of %li solves each\n", (long) n, (long) m,
+			(long) (n * col_nnz), eps, (long) rounds);
+	for (mode = 0; mode < 2; ++mode) {
+		printSolve(names[mode], &(solveInfo[mode]), best[mode]);
+	}
+	diff = ABS(solveInfo[1].pobj - solveInfo[0].pobj) / (1 + ABS(solveInfo[0].pobj));
+	scs_printf("relative objective difference %.1e, speedup %.2fx\n", diff, best[0] / best[1]);
+
+	scs_finish(w);
+	for (mode = 0; mode < 2; ++mode) {
+		scs_free(sol[mode].x);
+		scs_free(sol[mode].y);
+		scs_free(sol[mode].s);
+	}
+	freeData(d, k);
+	scs_free(opt.x);
+	scs_free(opt.y);
+	scs_free(opt.s);
+	return solveInfo[0].statusVal != SCS_SOLVED || solveInfo[1].statusVal != SCS_SOLVED;
+}
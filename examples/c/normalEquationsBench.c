@@ -0,0 +1,70 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+
+/*
+ benchmark of the normal_equations setting of the direct solver on a random tall LP, m = ratio * n inequalities in n
+ variables with colNnz nonzeros per column of A, a least squares like shape: the KKT matrix of dimension n + m is
+ factored and solved once, and once the normal equations rho_x I + A'A of dimension n, if their factor is smaller.
+
+ usage: bench_normal_equations [n] [ratio] [colNnz] [iters] [seed]
+
+ both run the same number of iterations, so the iterates must agree up to the rounding of the two factorizations.
+ */
+
+static void freeSolVecs(Sol * sol) {
+	scs_free(sol->x);
+	scs_free(sol->y);
+	scs_free(sol->s);
+	sol->x = sol->y = sol->s = SCS_NULL;
+}
+
+int main(int argc, char **argv) {
+	scs_int n = argc > 1 ? atoi(argv[1]) : 300;
+	scs_int ratio = argc > 2 ? atoi(argv[2]) : 20;
+	scs_int col_nnz = argc > 3 ? atoi(argv[3]) : 30;
+	scs_int iters = argc > 4 ? atoi(argv[4]) : 100;
+	int seed = argc > 5 ? atoi(argv[5]) : 1;
+	scs_int m = ratio * n, i, mode;
+	scs_float diff = 0, nrm = 0;
+	Data * d = scs_calloc(1, sizeof(Data));
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	Sol opt = { 0 }, sol[2] = { { 0 }, { 0 } };
+	Info info[2] = { { 0 }, { 0 } };
+
+	srand(seed);
+	d->stgs = scs_calloc(1, sizeof(Settings));
+	d->m = m;
+	d->n = n;
+	k->l = m;
+	genRandomProbData(n * col_nnz, col_nnz, d, k, &opt);
+	setDefaultSettings(d);
+	d->stgs->verbose = 0;
+	d->stgs->max_iters = iters;
+	d->stgs->eps = 1e-12;
+	/* scs normalizes A in place, copied when COPYAMATRIX, so both solves see the same data */
+	for (mode = 0; mode < 2; ++mode) {
+		d->stgs->normal_equations = mode;
+		scs(d, k, &(sol[mode]), &(info[mode]));
+		scs_printf("%-18s nnz(L) = %9li, ordering %8.2f ms, factorization %8.2f ms, solves %6.3f ms per iteration "
+				"(%li iterations)\n", mode ? "normal equations:" : "KKT:", (long) info[mode].nnzL,
+				info[mode].orderingTime, info[mode].factorTime, info[mode].linSysTime / MAX(info[mode].iter, 1),
+				(long) info[mode].iter);
+	}
+	for (i = 0; i < n; ++i) {
+		diff += (sol[1].x[i] - sol[0].x[i]) * (sol[1].x[i] - sol[0].x[i]);
+		nrm += sol[0].x[i] * sol[0].x[i];
+	}
+	diff = SQRTF(diff / MAX(nrm, 1e-18));
+	scs_printf("n = %li, m = %li: factorization %.2fx, solves %.2fx, relative difference of x %.1e\n", (long) n,
+			(long) m, (info[0].orderingTime + info[0].factorTime)
+					/ MAX(info[1].orderingTime + info[1].factorTime, 1e-9),
+			info[0].linSysTime / MAX(info[1].linSysTime, 1e-9), diff);
+	freeSolVecs(&(sol[0]));
+	freeSolVecs(&(sol[1]));
+	freeData(d, k);
+	scs_free(opt.x);
+	scs_free(opt.y);
+	scs_free(opt.s);
+	return info[0].iter != info[1].iter || !(diff < 1e-6);
+}
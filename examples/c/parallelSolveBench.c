@@ -0,0 +1,135 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+#ifdef OPENMP
+#include <omp.h>
+#endif
+
+/*
+ benchmark of the numeric factorization and the triangular solves of the direct solver (tree_parallel) on one thread
+ against all of them (OMP_NUM_THREADS), on a block-angular LP: numBlocks independent blocks of blockSize variables
+ and 3 * blockSize inequalities each, colNnz nonzeros per column, coupled by a few free linking rows. its elimination
+ tree is wide and shallow, one subtree per block under the linking rows. with a few more nonzeros per column the
+ blocks fill in and are factored in supernodes.
+
+ usage: bench_parallel_solve [numBlocks] [blockSize] [colNnz] [iters] [seed]
+
+ both do the same arithmetic on any number of threads, so the results must be identical.
+ */
+
+#define LINKING_ROWS (8)
+
+/* A, b, c and the cones of the block-angular LP, feasible and bounded with the solution opt as genRandomProbData */
+static void genBlockProbData(scs_int numBlocks, scs_int blockSize, scs_int colNnz, Data * d, Cone * k, Sol * opt) {
+	scs_int i, j, r, blk, nnz = 0, n = numBlocks * blockSize, m = LINKING_ROWS + 3 * n;
+	AMatrix * A = d->A = scs_calloc(1, sizeof(AMatrix));
+	scs_float * z = scs_calloc(m, sizeof(scs_float));
+	d->n = n;
+	d->m = m;
+	d->b = scs_calloc(m, sizeof(scs_float));
+	d->c = scs_calloc(n, sizeof(scs_float));
+	opt->x = scs_calloc(n, sizeof(scs_float));
+	opt->y = scs_calloc(m, sizeof(scs_float));
+	opt->s = scs_calloc(m, sizeof(scs_float));
+	k->f = LINKING_ROWS;
+	k->l = 3 * n;
+	A->m = m;
+	A->n = n;
+	A->p = scs_calloc(n + 1, sizeof(scs_int));
+	A->i = scs_calloc(n * (colNnz + 1), sizeof(scs_int));
+	A->x = scs_calloc(n * (colNnz + 1), sizeof(scs_float));
+	for (i = 0; i < m; ++i) {
+		opt->y[i] = z[i] = rand_scs_float();
+	}
+	projDualCone(opt->y, k, SCS_NULL, SCS_NULL, -1);
+	for (i = 0; i < m; ++i) {
+		d->b[i] = opt->s[i] = opt->y[i] - z[i];
+	}
+	for (j = 0; j < n; ++j) {
+		opt->x[j] = rand_scs_float();
+	}
+	/* a linking row, then distinct rows of the column's block, increasing */
+	for (j = 0; j < n; ++j) {
+		blk = j / blockSize;
+		A->i[nnz] = j % LINKING_ROWS;
+		A->x[nnz++] = rand_scs_float();
+		for (r = 0; r < colNnz; ++r) {
+			A->i[nnz] = LINKING_ROWS + 3 * blockSize * blk + r * 3 * blockSize / colNnz
+					+ rand() % (3 * blockSize / colNnz);
+			A->x[nnz++] = rand_scs_float();
+		}
+		A->p[j + 1] = nnz;
+		for (r = A->p[j]; r < nnz; ++r) {
+			d->b[A->i[r]] += A->x[r] * opt->x[j];
+			d->c[j] -= A->x[r] * opt->y[A->i[r]];
+		}
+	}
+	scs_free(z);
+}
+
+static void freeSolVecs(Sol * sol) {
+	scs_free(sol->x);
+	scs_free(sol->y);
+	scs_free(sol->s);
+	sol->x = sol->y = sol->s = SCS_NULL;
+}
+
+int main(int argc, char **argv) {
+	scs_int numBlocks = argc > 1 ? atoi(argv[1]) : 400;
+	scs_int blockSize = argc > 2 ? atoi(argv[2]) : 40;
+	scs_int colNnz = argc > 3 ? atoi(argv[3]) : 4;
+	scs_int iters = argc > 4 ? atoi(argv[4]) : 200;
+	int seed = argc > 5 ? atoi(argv[5]) : 1;
+	scs_int mode, run, threads = 1, mismatches = 0;
+	scs_float tSolve[2], tFactor[2];
+	Data * d = scs_calloc(1, sizeof(Data));
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	Sol opt = { 0 }, sol[2] = { { 0 }, { 0 } };
+	Info info = { 0 };
+
+	srand(seed);
+	genBlockProbData(numBlocks, blockSize, colNnz, d, k, &opt);
+	d->stgs = scs_calloc(1, sizeof(Settings));
+	setDefaultSettings(d);
+	d->stgs->verbose = 0;
+	d->stgs->max_iters = iters;
+	d->stgs->eps = 1e-12;
+	d->stgs->tree_parallel = 1;
+#ifdef OPENMP
+	threads = omp_get_max_threads();
+	if (threads > omp_get_num_procs()) {
+		scs_printf("only %li processors, the direct solver uses at most that many threads\n",
+				(long) omp_get_num_procs());
+	}
+#endif
+	scs_printf("%li blocks of %li variables, %li nonzeros per column, n = %li, m = %li, %li iterations\n",
+			(long) numBlocks, (long) blockSize, (long) colNnz, (long) d->n, (long) d->m, (long) iters);
+	/* scs normalizes A in place, copied when COPYAMATRIX, so all solves see the same data */
+	for (mode = 0; mode < 2; ++mode) {
+		d->stgs->supernodal = mode;
+		for (run = 0; run < 2; ++run) {
+#ifdef OPENMP
+			omp_set_num_threads(run ? threads : 1);
+#endif
+			scs(d, k, &(sol[run]), &info);
+			tSolve[run] = info.linSysTime / MAX(info.iter, 1);
+			tFactor[run] = info.factorTime;
+		}
+		if (memcmp(sol[0].x, sol[1].x, d->n * sizeof(scs_float))
+				|| memcmp(sol[0].y, sol[1].y, d->m * sizeof(scs_float))) {
+			scs_printf("%s: the solutions on 1 and %li threads differ\n", mode ? "supernodal" : "column LDL'",
+					(long) threads);
+			mismatches++;
+		}
+		scs_printf("%-12s factorization %8.2f ms on 1 thread, %8.2f ms on %li threads (%.2fx)\n",
+				mode ? "supernodal:" : "column LDL':", tFactor[0], tFactor[1], (long) threads,
+				tFactor[0] / MAX(tFactor[1], 1e-9));
+		scs_printf("%-12s solves %7.3f ms per iteration on 1 thread, %7.3f ms on %li threads (%.2fx)\n", "",
+				tSolve[0], tSolve[1], (long) threads, tSolve[0] / MAX(tSolve[1], 1e-9));
+		freeSolVecs(&(sol[0]));
+		freeSolVecs(&(sol[1]));
+	}
+	freeData(d, k);
+	freeSolVecs(&opt);
+	return mismatches;
+}
@@ -0,0 +1,162 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+
+/*
+ benchmark of the power cone projection: the original projection (four pows per Newton step and the dual cone
+ scaling recomputed on every call) against projDualCone, followed by a solve of a random problem with
+ num_pow / 100 power cones. the exponents are drawn from num_exps distinct values in (-1, 1).
+
+ usage: bench_pow [num_pow] [num_exps] [rounds] [seed]
+
+ both stop at the same tolerance, so they agree to about 1e-8.
+ */
+
+#define OLD_CONE_TOL (1e-8)
+#define OLD_CONE_THRESH (1e-6)
+#define OLD_POW_CONE_MAX_ITERS (20)
+
+static scs_float oldPowCalcX(scs_float r, scs_float xh, scs_float rh, scs_float a) {
+	scs_float x = 0.5 * (xh + SQRTF(xh * xh + 4 * a * (rh - r) * r));
+	return MAX(x, 1e-12);
+}
+
+static scs_float oldPowCalcdxdr(scs_float x, scs_float xh, scs_float rh, scs_float r, scs_float a) {
+	return a * (rh - 2 * r) / (2 * x - xh);
+}
+
+/* projPowerCone prior to the precomputed constants */
+static void oldProjPowerCone(scs_float * v, scs_float a) {
+	scs_float xh = v[0], yh = v[1], rh = ABS(v[2]);
+	scs_float x = 0, y = 0, r;
+	scs_int i;
+	if (xh >= 0 && yh >= 0 && OLD_CONE_THRESH + POWF(xh, a) * POWF(yh, (1 - a)) >= rh)
+		return;
+	if (xh <= 0 && yh <= 0
+			&& OLD_CONE_THRESH + POWF(-xh, a) * POWF(-yh, 1 - a) >= rh * POWF(a, a) * POWF(1 - a, 1 - a)) {
+		v[0] = v[1] = v[2] = 0;
+		return;
+	}
+	r = rh / 2;
+	for (i = 0; i < OLD_POW_CONE_MAX_ITERS; ++i) {
+		scs_float f, fp, dxdr, dydr;
+		x = oldPowCalcX(r, xh, rh, a);
+		y = oldPowCalcX(r, yh, rh, 1 - a);
+		f = POWF(x, a) * POWF(y, (1 - a)) - r;
+		if (ABS(f) < OLD_CONE_TOL)
+			break;
+		dxdr = oldPowCalcdxdr(x, xh, rh, r, a);
+		dydr = oldPowCalcdxdr(y, yh, rh, r, (1 - a));
+		fp = POWF(x, a) * POWF(y, (1 - a)) * (a * dxdr / x + (1 - a) * dydr / y) - 1;
+		r = MAX(r - f / fp, 0);
+		r = MIN(r, rh);
+	}
+	v[0] = x;
+	v[1] = y;
+	v[2] = (v[2] < 0) ? -(r) : (r);
+}
+
+/* the loop over the power cones in projDualCone prior to the precomputed constants */
+static void oldProj(scs_float * x, const Cone * k) {
+	scs_int i;
+	scs_float v[3];
+	for (i = 0; i < k->psize; ++i) {
+		if (k->p[i] <= 0) {
+			oldProjPowerCone(&(x[3 * i]), -k->p[i]);
+		} else {
+			v[0] = -x[3 * i];
+			v[1] = -x[3 * i + 1];
+			v[2] = -x[3 * i + 2];
+			oldProjPowerCone(v, k->p[i]);
+			x[3 * i] += v[0];
+			x[3 * i + 1] += v[1];
+			x[3 * i + 2] += v[2];
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+	scs_int numPow = argc > 1 ? atoi(argv[1]) : 100000;
+	scs_int numExps = argc > 2 ? atoi(argv[2]) : 10;
+	scs_int rounds = argc > 3 ? atoi(argv[3]) : 3;
+	int seed = argc > 4 ? atoi(argv[4]) : 1;
+	scs_int i, r, len = 3 * numPow, n, m;
+	scs_float t, tOld = INFINITY, tNew = INFINITY, diff = 0.0, *v, *xOld, *xNew, *exps;
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	Data * d = scs_calloc(1, sizeof(Data));
+	ConeWork * c;
+	Sol sol = { 0 }, opt = { 0 };
+	Info info = { 0 };
+	timer projTimer;
+
+	srand(seed);
+	v = scs_malloc(len * sizeof(scs_float));
+	xOld = scs_malloc(len * sizeof(scs_float));
+	xNew = scs_malloc(len * sizeof(scs_float));
+	exps = scs_malloc(numExps * sizeof(scs_float));
+	for (i = 0; i < numExps; ++i) {
+		exps[i] = 0.98 * rand_scs_float();
+	}
+	k->psize = numPow;
+	k->p = scs_malloc(numPow * sizeof(scs_float));
+	for (i = 0; i < numPow; ++i) {
+		k->p[i] = exps[rand() % numExps];
+	}
+	for (i = 0; i < len; ++i) {
+		v[i] = rand_gauss();
+	}
+	c = initCone(k);
+	if (!c) {
+		scs_printf("initCone failed\n");
+		return -1;
+	}
+	for (r = 0; r < rounds; ++r) {
+		memcpy(xOld, v, len * sizeof(scs_float));
+		tic(&projTimer);
+		oldProj(xOld, k);
+		t = tocq(&projTimer);
+		tOld = MIN(tOld, t);
+
+		memcpy(xNew, v, len * sizeof(scs_float));
+		tic(&projTimer);
+		projDualCone(xNew, k, c, SCS_NULL, -1);
+		t = tocq(&projTimer);
+		tNew = MIN(tNew, t);
+	}
+	for (i = 0; i < len; ++i) {
+		diff = MAX(diff, ABS(xOld[i] - xNew[i]));
+	}
+	finishCone(c);
+	scs_printf("%li power cone projections with %li distinct exponents, fastest of %li\n", (long) numPow,
+			(long) numExps, (long) rounds);
+	scs_printf("original:     %8.2f ms\n", tOld);
+	scs_printf("projDualCone: %8.2f ms (%.2fx), max difference %.1e\n", tNew, tOld / tNew, diff);
+
+	/* a random problem with numPow / 100 power cones */
+	k->psize = MAX(numPow / 100, 1);
+	k->l = 3 * k->psize;
+	m = k->l + 3 * k->psize;
+	n = m / 3;
+	d->m = m;
+	d->n = n;
+	d->stgs = scs_calloc(1, sizeof(Settings));
+	genRandomProbData(n * 5, 5, d, k, &opt);
+	setDefaultSettings(d);
+	d->stgs->verbose = 0;
+	scs(d, k, &sol, &info);
+	scs_printf("random problem with %li power cones: %s in %li iterations, power cone projections %.2f ms of %.2f ms\n",
+			(long) k->psize, info.status, (long) info.iter, info.powConeTime, info.solveTime);
+
+	freeData(d, k);
+	scs_free(sol.x);
+	scs_free(sol.y);
+	scs_free(sol.s);
+	scs_free(opt.x);
+	scs_free(opt.y);
+	scs_free(opt.s);
+	scs_free(v);
+	scs_free(xOld);
+	scs_free(xNew);
+	scs_free(exps);
+	return diff > 1e-6 || info.statusVal != SCS_SOLVED;
+}
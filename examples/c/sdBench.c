@@ -0,0 +1,258 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+
+/*
+ benchmark of sdp_warm_eig, the projections of large SD blocks warm started from the eigenvectors of the previous
+ projection, against the full eigendecomposition:
+ - a sequence of rounds projections of an n x n block with rank positive eigenvalues that drifts slowly, as the
+   iterates do once the positive eigenspace has settled;
+ - rounds projections each of a positive definite, a negative definite and an indefinite n x n block, the first two
+   found so by the Cholesky pretests and the last one projected by the eigendecomposition;
+ - a PSD matrix completion problem (minimize trace(X) subject to X PSD and the observed entries of a rank rank
+   matrix) solved with the setting off and on.
+
+ usage: bench_sd [n] [rank] [rounds] [seed]
+
+ the warm-started projections are accurate to about 1e-8 times the norm of the block. blocks smaller than about
+ 150 x 150 are never warm started, the full decomposition is about as fast.
+ */
+
+#define DRIFT (1e-3)
+#define OBSERVED (0.4)
+
+#ifdef LAPACK_LIB_FOUND
+/* the index of entry (i, j), i >= j, of an n x n block in the (column-wise, lower triangular) SD cone variables */
+static scs_int svecIndex(scs_int i, scs_int j, scs_int n) {
+	return j * n - (j * (j - 1)) / 2 + i - j;
+}
+
+/* x = the SD cone variables of the symmetric n x n X (the off diagonal entries scaled by sqrt(2)) */
+static void svec(scs_float * x, const scs_float * X, scs_int n) {
+	scs_int i, j;
+	for (j = 0; j < n; ++j) {
+		for (i = j; i < n; ++i) {
+			x[svecIndex(i, j, n)] = (i == j ? 1.0 : SQRTF(2.0)) * X[i + j * n];
+		}
+	}
+}
+
+/* X = symmetric Gaussian matrix times scale / sqrt(n) */
+static void randSym(scs_float * X, scs_int n, scs_float scale) {
+	scs_int i, j;
+	for (j = 0; j < n; ++j) {
+		for (i = j; i < n; ++i) {
+			X[i + j * n] = X[j + i * n] = scale * rand_gauss() / SQRTF((scs_float) n);
+		}
+	}
+}
+
+/* X += a u u' for a random unit vector u */
+static void addRankOne(scs_float * X, scs_int n, scs_float a, scs_float * u) {
+	scs_int i, j;
+	for (i = 0; i < n; ++i) {
+		u[i] = rand_gauss();
+	}
+	scaleArray(u, 1.0 / calcNorm(u, n), n);
+	for (j = 0; j < n; ++j) {
+		for (i = 0; i < n; ++i) {
+			X[i + j * n] += a * u[i] * u[j];
+		}
+	}
+}
+
+/* fills c, A, b of the completion problem of n x n M from the entries (i, j) with observed[...] set */
+static void completionData(Data * d, Cone * k, const scs_float * M, const scs_int * observed, scs_int n) {
+	scs_int i, j, col, row = 0, nnz = 0, len = (n * (n + 1)) / 2, numObs = 0;
+	AMatrix * A = d->A = scs_calloc(1, sizeof(AMatrix));
+	for (i = 0; i < len; ++i) {
+		numObs += observed[i];
+	}
+	k->f = numObs;
+	k->ssize = 1;
+	k->s = scs_malloc(sizeof(scs_int));
+	k->s[0] = n;
+	d->n = len;
+	d->m = numObs + len;
+	d->b = scs_calloc(d->m, sizeof(scs_float));
+	d->c = scs_calloc(d->n, sizeof(scs_float));
+	A->m = d->m;
+	A->n = d->n;
+	A->p = scs_malloc((len + 1) * sizeof(scs_int));
+	A->i = scs_malloc((numObs + len) * sizeof(scs_int));
+	A->x = scs_malloc((numObs + len) * sizeof(scs_float));
+	/* x are the SD cone variables of X, the observed ones fixed by the zero cone rows, and s = x in the SD cone */
+	for (j = 0; j < n; ++j) {
+		for (i = j; i < n; ++i) {
+			col = svecIndex(i, j, n);
+			A->p[col] = nnz;
+			if (i == j) {
+				d->c[col] = 1.0;
+			}
+			if (observed[col]) {
+				A->i[nnz] = row;
+				A->x[nnz++] = 1.0;
+				d->b[row++] = (i == j ? 1.0 : SQRTF(2.0)) * M[i + j * n];
+			}
+			A->i[nnz] = numObs + col;
+			A->x[nnz++] = -1.0;
+		}
+	}
+	A->p[len] = nnz;
+}
+#endif
+
+int main(int argc, char **argv) {
+#ifdef LAPACK_LIB_FOUND
+	scs_int n = argc > 1 ? atoi(argv[1]) : 200;
+	scs_int rank = argc > 2 ? atoi(argv[2]) : 5;
+	scs_int rounds = argc > 3 ? atoi(argv[3]) : 50;
+	int seed = argc > 4 ? atoi(argv[4]) : 1;
+	scs_int i, r, len = (n * (n + 1)) / 2, mode, fail = 0, iters[2];
+	scs_int hits[3];
+	scs_float t, tFull = 0.0, tWarm = 0.0, diff = 0.0, nrm, obj[2], tPre[3] = { 0.0, 0.0, 0.0 };
+	scs_float *X, *F, *u, *x0, *f, *xFull, *xWarm;
+	scs_int * observed;
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	ConeWork * full, *warm;
+	Info info = { 0 };
+	timer projTimer;
+
+	srand(seed);
+	X = scs_calloc(n * n, sizeof(scs_float));
+	F = scs_calloc(n * n, sizeof(scs_float));
+	u = scs_malloc(n * sizeof(scs_float));
+	x0 = scs_malloc(len * sizeof(scs_float));
+	f = scs_malloc(len * sizeof(scs_float));
+	xFull = scs_malloc(len * sizeof(scs_float));
+	xWarm = scs_malloc(len * sizeof(scs_float));
+	observed = scs_calloc(len, sizeof(scs_int));
+
+	/* rank positive eigenvalues in [1, rank], the others around -1, drifting in direction F */
+	randSym(X, n, 0.1);
+	for (i = 0; i < n; ++i) {
+		X[i + i * n] -= 1.0;
+	}
+	for (i = 0; i < rank; ++i) {
+		addRankOne(X, n, 2.0 + i, u);
+	}
+	svec(x0, X, n);
+	randSym(F, n, DRIFT);
+	svec(f, F, n);
+
+	k->ssize = 1;
+	k->s = &n;
+	full = initCone(k);
+	warm = initCone(k);
+	if (!full || !warm) {
+		scs_printf("initCone failed\n");
+		return -1;
+	}
+	warm->sdWarmEig = 1;
+	for (r = 0; r < rounds; ++r) {
+		memcpy(xFull, x0, len * sizeof(scs_float));
+		addScaledArray(xFull, f, len, (scs_float) r);
+		memcpy(xWarm, xFull, len * sizeof(scs_float));
+		nrm = calcNorm(xFull, len);
+		tic(&projTimer);
+		projDualCone(xFull, k, full, SCS_NULL, r);
+		t = tocq(&projTimer);
+		tFull += t;
+		tic(&projTimer);
+		projDualCone(xWarm, k, warm, SCS_NULL, r);
+		t = tocq(&projTimer);
+		tWarm += t;
+		for (i = 0; i < len; ++i) {
+			diff = MAX(diff, ABS(xFull[i] - xWarm[i]) / nrm);
+		}
+	}
+	getConeInfo(warm, &info);
+	scs_printf("%li projections of a drifting %li x %li block with %li positive eigenvalues\n", (long) rounds,
+			(long) n, (long) n, (long) rank);
+	scs_printf("full eigendecomposition: %8.2f ms\n", tFull);
+	scs_printf("sdp_warm_eig:            %8.2f ms (%.2fx), %li of %li warm started, max difference %.1e (relative)\n",
+			tWarm, tFull / tWarm, (long) info.sdWarmEigs, (long) rounds, diff);
+	finishCone(full);
+	finishCone(warm);
+	fail = diff > 1e-6;
+
+	/* a positive definite block, its negative and the indefinite one with the signs of half its entries flipped */
+	randSym(X, n, 1.0);
+	for (i = 0; i < n; ++i) {
+		X[i + i * n] += 3.0;
+	}
+	svec(x0, X, n);
+	for (mode = 0; mode < 3; ++mode) {
+		full = initCone(k);
+		if (!full) {
+			scs_printf("initCone failed\n");
+			return -1;
+		}
+		for (i = 0; i < len; ++i) {
+			f[i] = (mode == 1 || (mode == 2 && i < len / 2) ? -1.0 : 1.0) * x0[i];
+		}
+		for (r = 0; r < rounds; ++r) {
+			memcpy(xFull, f, len * sizeof(scs_float));
+			tic(&projTimer);
+			projDualCone(xFull, k, full, SCS_NULL, -1);
+			tPre[mode] += tocq(&projTimer);
+		}
+		for (i = 0; i < len && mode < 2; ++i) {
+			diff = MAX(diff, ABS(xFull[i] - (mode == 0 ? x0[i] : 0.0)));
+		}
+		getConeInfo(full, &info);
+		hits[mode] = info.sdPsdHits + info.sdNsdHits;
+		finishCone(full);
+	}
+	scs_printf("%li projections each of a %li x %li block with all eigenvalues positive, all negative and mixed\n",
+			(long) rounds, (long) n, (long) n);
+	scs_printf("positive definite: %8.2f ms (%li found PSD)\n", tPre[0], (long) hits[0]);
+	scs_printf("negative definite: %8.2f ms (%li found NSD)\n", tPre[1], (long) hits[1]);
+	scs_printf("indefinite:        %8.2f ms (%li found PSD or NSD)\n", tPre[2], (long) hits[2]);
+	fail |= diff > 1e-6 || hits[0] != rounds || hits[1] != rounds || hits[2] != 0;
+
+	/* PSD completion of M = U U', U n x rank Gaussian, observing each entry with probability OBSERVED */
+	memset(X, 0, n * n * sizeof(scs_float));
+	for (i = 0; i < rank; ++i) {
+		addRankOne(X, n, 1.0, u);
+	}
+	for (i = 0; i < len; ++i) {
+		observed[i] = (scs_float) rand() / RAND_MAX < OBSERVED;
+	}
+	for (mode = 0; mode < 2; ++mode) {
+		Data * d = scs_calloc(1, sizeof(Data));
+		Cone * kc = scs_calloc(1, sizeof(Cone));
+		Sol * sol = scs_calloc(1, sizeof(Sol));
+		completionData(d, kc, X, observed, n);
+		d->stgs = scs_calloc(1, sizeof(Settings));
+		setDefaultSettings(d);
+		d->stgs->verbose = 0;
+		d->stgs->sdp_warm_eig = mode;
+		scs(d, kc, sol, &info);
+		scs_printf("completion, sdp_warm_eig = %li: %s in %li iterations, objective %.6e, SD projections %.2f ms of "
+				"%.2f ms, %li of %li warm started, %li PSD\n", (long) mode, info.status, (long) info.iter, info.pobj,
+				info.sdConeTime, info.solveTime, (long) info.sdWarmEigs, (long) info.sdProjections,
+				(long) info.sdPsdHits);
+		iters[mode] = info.iter;
+		obj[mode] = info.pobj;
+		fail |= info.statusVal != SCS_SOLVED;
+		freeData(d, kc);
+		freeSol(sol);
+	}
+	fail |= ABS(obj[0] - obj[1]) > 1e-2 * ABS(obj[0]) || iters[1] > 2 * iters[0];
+
+	scs_free(X);
+	scs_free(F);
+	scs_free(u);
+	scs_free(x0);
+	scs_free(f);
+	scs_free(xFull);
+	scs_free(xWarm);
+	scs_free(observed);
+	scs_free(k);
+	return fail;
+#else
+	scs_printf("bench_sd needs blas+lapack (USE_LAPACK = 1)\n");
+	return 0;
+#endif
+}
@@ -0,0 +1,141 @@
+#include "scs.h"
+#include "linAlg.h"
+
+#ifdef OPENMP
+#include <omp.h>
+#endif
+
+/*
+ benchmark of the projection of many small SD blocks in projDualCone (Jacobi eigendecompositions of SD_LANES blocks
+ of equal size side by side, no LAPACK) against the original projection, one LAPACK syevr call per block, for
+ num_sd blocks of random size in [nmin, nmax].
+
+ usage: bench_sd_small [num_sd] [nmin] [nmax] [rounds] [seed]
+
+ the Jacobi sweeps stop at off-diagonal entries of about 1e-13 times the norm of the block and syevr at an
+ eigenvalue tolerance of 1e-8, so they agree to about 1e-8. projDualCone runs on one thread.
+ */
+
+#ifdef LAPACK_LIB_FOUND
+void BLAS(syevr)(const char *jobz, const char *range, const char *uplo, blasint *n, scs_float *a, blasint *lda,
+		scs_float *vl, scs_float *vu, blasint *il, blasint *iu, scs_float *abstol, blasint *m, scs_float *w,
+		scs_float *z, blasint *ldz, blasint *isuppz, scs_float *work, blasint *lwork, blasint *iwork, blasint *liwork,
+		blasint *info);
+void BLAS(syr)(const char *uplo, const blasint *n, const scs_float *alpha, const scs_float *x, const blasint *incx,
+		scs_float *a, const blasint *lda);
+
+/* projSemiDefiniteCone prior to the Jacobi kernel, workspaces of size n * n, n, 26 * n and 10 * n */
+static void oldProjSd(scs_float * X, scs_int n, scs_float * Xs, scs_float * Z, scs_float * e, scs_float * work,
+		blasint * iwork) {
+	scs_int i;
+	blasint nb = (blasint) n, one = 1, m = 0, lwork = 26 * nb, liwork = 10 * nb, info;
+	scs_float sqrt2 = SQRTF(2.0), eigTol = 1e-8, vlower = 0.0, vupper;
+	for (i = 0; i < n; ++i) {
+		memcpy(&(Xs[i * (n + 1)]), &(X[i * n - ((i - 1) * i) / 2]), (n - i) * sizeof(scs_float));
+		Xs[i * (n + 1)] *= sqrt2;
+	}
+	vupper = MAX(1.1 * sqrt2 * calcNorm(X, (n * (n + 1)) / 2), 0.01);
+	BLAS(syevr)("Vectors", "VInterval", "Lower", &nb, Xs, &nb, &vlower, &vupper, SCS_NULL, SCS_NULL, &eigTol, &m, e,
+			Z, &nb, SCS_NULL, work, &lwork, iwork, &liwork, &info);
+	memset(Xs, 0, n * n * sizeof(scs_float));
+	for (i = 0; i < m; ++i) {
+		BLAS(syr)("Lower", &nb, &(e[i]), &(Z[i * n]), &one, Xs, &nb);
+	}
+	for (i = 0; i < n; ++i) {
+		Xs[i * (n + 1)] /= sqrt2;
+		memcpy(&(X[i * n - ((i - 1) * i) / 2]), &(Xs[i * (n + 1)]), (n - i) * sizeof(scs_float));
+	}
+}
+#endif
+
+static void randVec(scs_float * x, scs_int len) {
+	scs_int i;
+	for (i = 0; i < len; ++i) {
+		x[i] = (scs_float) rand() / RAND_MAX - 0.5;
+	}
+}
+
+int main(int argc, char **argv) {
+	scs_int numSd = argc > 1 ? atoi(argv[1]) : 100000;
+	scs_int nmin = argc > 2 ? atoi(argv[2]) : 3;
+	scs_int nmax = argc > 3 ? atoi(argv[3]) : 4;
+	scs_int rounds = argc > 4 ? atoi(argv[4]) : 5;
+	int seed = argc > 5 ? atoi(argv[5]) : 1;
+	scs_int i, r, m = 0;
+	scs_float t, tNew = INFINITY, maxDiff = 0.0, *x0, *xNew;
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	ConeWork * c;
+	timer projTimer;
+#ifdef LAPACK_LIB_FOUND
+	scs_int row;
+	scs_float tOld = INFINITY, *xOld, *Xs, *Z, *e, *work;
+	blasint * iwork;
+#endif
+
+	srand(seed);
+	k->ssize = numSd;
+	k->s = scs_malloc(numSd * sizeof(scs_int));
+	for (i = 0; i < numSd; ++i) {
+		k->s[i] = nmin + rand() % (nmax - nmin + 1);
+		m += (k->s[i] * (k->s[i] + 1)) / 2;
+	}
+	x0 = scs_malloc(m * sizeof(scs_float));
+	xNew = scs_malloc(m * sizeof(scs_float));
+	randVec(x0, m);
+
+#ifdef OPENMP
+	omp_set_num_threads(1);
+#endif
+	c = initCone(k);
+	if (!c) {
+		scs_printf("initCone failed\n");
+		return -1;
+	}
+	for (r = 0; r < rounds; ++r) {
+		memcpy(xNew, x0, m * sizeof(scs_float));
+		tic(&projTimer);
+		projDualCone(xNew, k, c, SCS_NULL, -1);
+		t = tocq(&projTimer);
+		tNew = MIN(tNew, t);
+	}
+	scs_printf("%li SD blocks of size %li to %li, m = %li, fastest of %li\n", (long) numSd, (long) nmin, (long) nmax,
+			(long) m, (long) rounds);
+#ifdef LAPACK_LIB_FOUND
+	xOld = scs_malloc(m * sizeof(scs_float));
+	Xs = scs_malloc(nmax * nmax * sizeof(scs_float));
+	Z = scs_malloc(nmax * nmax * sizeof(scs_float));
+	e = scs_malloc(nmax * sizeof(scs_float));
+	work = scs_malloc(26 * nmax * sizeof(scs_float));
+	iwork = scs_malloc(10 * nmax * sizeof(blasint));
+	for (r = 0; r < rounds; ++r) {
+		memcpy(xOld, x0, m * sizeof(scs_float));
+		tic(&projTimer);
+		for (i = 0, row = 0; i < numSd; ++i) {
+			oldProjSd(&(xOld[row]), k->s[i], Xs, Z, e, work, iwork);
+			row += (k->s[i] * (k->s[i] + 1)) / 2;
+		}
+		t = tocq(&projTimer);
+		tOld = MIN(tOld, t);
+	}
+	for (i = 0; i < m; ++i) {
+		maxDiff = MAX(maxDiff, ABS(xOld[i] - xNew[i]));
+	}
+	scs_printf("syevr per block: %8.2f ms\n", tOld);
+	scs_printf("projDualCone:    %8.2f ms (%.2fx), max difference %.1e\n", tNew, tOld / tNew, maxDiff);
+	scs_free(xOld);
+	scs_free(Xs);
+	scs_free(Z);
+	scs_free(e);
+	scs_free(work);
+	scs_free(iwork);
+#else
+	scs_printf("projDualCone:    %8.2f ms (no blas+lapack to compare with)\n", tNew);
+#endif
+
+	finishCone(c);
+	scs_free(k->s);
+	scs_free(k);
+	scs_free(x0);
+	scs_free(xNew);
+	return maxDiff > 1e-6;
+}
@@ -0,0 +1,113 @@
+#include "scs.h"
+#include "linAlg.h"
+
+#ifdef OPENMP
+#include <omp.h>
+#endif
+
+/*
+ micro-benchmark of the SOC projection in projDualCone (blocks sorted by dimension and projected SOC_LANES at a
+ time) against the original loop over the blocks, for many small SOC blocks of random dimension in [qmin, qmax].
+
+ usage: bench_soc [num_soc] [qmin] [qmax] [rounds] [seed]
+
+ both do the same arithmetic on each block, so the projections are identical unless the compiler contracts it into
+ fused multiply-adds differently (e.g. with -march=native). projDualCone runs on one thread.
+ */
+
+static void randVec(scs_float * x, scs_int len) {
+	scs_int i;
+	for (i = 0; i < len; ++i) {
+		x[i] = (scs_float) rand() / RAND_MAX - 0.5;
+	}
+}
+
+/* projDualCone prior to the lane kernel */
+static void loopProj(scs_float * x, const Cone * k) {
+	scs_int i, count = 0;
+	for (i = 0; i < k->qsize; ++i) {
+		if (k->q[i] == 0) {
+			continue;
+		}
+		if (k->q[i] == 1) {
+			if (x[count] < 0.0)
+				x[count] = 0.0;
+		} else {
+			scs_float v1 = x[count];
+			scs_float s = calcNorm(&(x[count + 1]), k->q[i] - 1);
+			scs_float alpha = (s + v1) / 2.0;
+
+			if (s <= v1) { /* do nothing */
+			} else if (s <= -v1) {
+				memset(&(x[count]), 0, k->q[i] * sizeof(scs_float));
+			} else {
+				x[count] = alpha;
+				scaleArray(&(x[count + 1]), alpha / s, k->q[i] - 1);
+			}
+		}
+		count += k->q[i];
+	}
+}
+
+int main(int argc, char **argv) {
+	scs_int numSoc = argc > 1 ? atoi(argv[1]) : 1000000;
+	scs_int qmin = argc > 2 ? atoi(argv[2]) : 3;
+	scs_int qmax = argc > 3 ? atoi(argv[3]) : 5;
+	scs_int rounds = argc > 4 ? atoi(argv[4]) : 5;
+	int seed = argc > 5 ? atoi(argv[5]) : 1;
+	scs_int i, r, m = 0;
+	scs_float t, tLoop = INFINITY, tLanes = INFINITY, maxDiff = 0.0, *x0, *xLoop, *xLanes;
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	ConeWork * c;
+	timer projTimer;
+
+	srand(seed);
+	k->qsize = numSoc;
+	k->q = scs_malloc(numSoc * sizeof(scs_int));
+	for (i = 0; i < numSoc; ++i) {
+		k->q[i] = qmin + rand() % (qmax - qmin + 1);
+		m += k->q[i];
+	}
+	x0 = scs_malloc(m * sizeof(scs_float));
+	xLoop = scs_malloc(m * sizeof(scs_float));
+	xLanes = scs_malloc(m * sizeof(scs_float));
+	randVec(x0, m);
+
+#ifdef OPENMP
+	omp_set_num_threads(1);
+#endif
+	c = initCone(k);
+	if (!c) {
+		scs_printf("initCone failed\n");
+		return -1;
+	}
+	for (r = 0; r < rounds; ++r) {
+		memcpy(xLoop, x0, m * sizeof(scs_float));
+		tic(&projTimer);
+		loopProj(xLoop, k);
+		t = tocq(&projTimer);
+		tLoop = MIN(tLoop, t);
+
+		memcpy(xLanes, x0, m * sizeof(scs_float));
+		tic(&projTimer);
+		projDualCone(xLanes, k, c, SCS_NULL, -1);
+		t = tocq(&projTimer);
+		tLanes = MIN(tLanes, t);
+	}
+	for (i = 0; i < m; ++i) {
+		maxDiff = MAX(maxDiff, ABS(xLoop[i] - xLanes[i]));
+	}
+
+	scs_printf("%li SOC blocks of dimension %li to %li, m = %li, fastest of %li\n", (long) numSoc, (long) qmin,
+			(long) qmax, (long) m, (long) rounds);
+	scs_printf("loop over blocks: %8.2f ms\n", tLoop);
+	scs_printf("projDualCone:     %8.2f ms (%.2fx), max difference %.1e\n", tLanes, tLoop / tLanes, maxDiff);
+
+	finishCone(c);
+	scs_free(k->q);
+	scs_free(k);
+	scs_free(x0);
+	scs_free(xLoop);
+	scs_free(xLanes);
+	return maxDiff > 1e-12;
+}
@@ -0,0 +1,76 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+
+/*
+ benchmark of the supernodal setting of the direct solver on a random SOCP with sqrt(n) nonzeros per column of A,
+ which fills the factor in: the KKT matrix is factored and solved once column at a time and once in supernodes.
+
+ usage: bench_supernodal [n] [iters] [seed]
+
+ both run the same number of iterations, so the iterates must agree up to the rounding of the two factorizations.
+ */
+
+static void freeSolVecs(Sol * sol) {
+	scs_free(sol->x);
+	scs_free(sol->y);
+	scs_free(sol->s);
+	sol->x = sol->y = sol->s = SCS_NULL;
+}
+
+int main(int argc, char **argv) {
+	scs_int n = argc > 1 ? atoi(argv[1]) : 2000;
+	scs_int iters = argc > 2 ? atoi(argv[2]) : 50;
+	int seed = argc > 3 ? atoi(argv[3]) : 1;
+	scs_int m = 3 * n, col_nnz = (scs_int) ceil(sqrt(n)), nnz = n * col_nnz, rows, size, i, mode;
+	scs_float diff = 0, nrm = 0;
+	Data * d = scs_calloc(1, sizeof(Data));
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	Sol opt = { 0 }, sol[2] = { { 0 }, { 0 } };
+	Info info[2] = { { 0 }, { 0 } };
+
+	srand(seed);
+	d->stgs = scs_calloc(1, sizeof(Settings));
+	d->m = m;
+	d->n = n;
+	k->f = n / 3;
+	k->l = n;
+	rows = m - k->f - k->l;
+	k->q = scs_malloc(rows * sizeof(scs_int));
+	while (rows > 0) {
+		/* MIN evaluates its arguments twice */
+		size = 3 + rand() % 5;
+		size = MIN(size, rows);
+		k->q[k->qsize++] = size;
+		rows -= size;
+	}
+	genRandomProbData(nnz, col_nnz, d, k, &opt);
+	setDefaultSettings(d);
+	d->stgs->verbose = 0;
+	d->stgs->max_iters = iters;
+	d->stgs->eps = 1e-12;
+	/* scs normalizes A in place, copied when COPYAMATRIX, so both solves see the same data */
+	for (mode = 0; mode < 2; ++mode) {
+		d->stgs->supernodal = mode;
+		scs(d, k, &(sol[mode]), &(info[mode]));
+		scs_printf("%-13s nnz(L) = %9li, ordering %8.2f ms, factorization %8.2f ms, solves %6.3f ms per iteration "
+				"(%li iterations)\n", mode ? "supernodal:" : "column LDL':", (long) info[mode].nnzL,
+				info[mode].orderingTime, info[mode].factorTime, info[mode].linSysTime / MAX(info[mode].iter, 1),
+				(long) info[mode].iter);
+	}
+	for (i = 0; i < n; ++i) {
+		diff += (sol[1].x[i] - sol[0].x[i]) * (sol[1].x[i] - sol[0].x[i]);
+		nrm += sol[0].x[i] * sol[0].x[i];
+	}
+	diff = SQRTF(diff / MAX(nrm, 1e-18));
+	scs_printf("n = %li, m = %li: factorization %.2fx, solves %.2fx, relative difference of x %.1e\n", (long) n,
+			(long) m, info[0].factorTime / MAX(info[1].factorTime, 1e-9),
+			info[0].linSysTime / MAX(info[1].linSysTime, 1e-9), diff);
+	freeSolVecs(&(sol[0]));
+	freeSolVecs(&(sol[1]));
+	freeData(d, k);
+	scs_free(opt.x);
+	scs_free(opt.y);
+	scs_free(opt.s);
+	return info[0].iter != info[1].iter || !(diff < 1e-6);
+}
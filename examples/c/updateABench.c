@@ -0,0 +1,138 @@
+#include "scs.h"
+#include "linsys/amatrix.h"
+#include "problemUtils.h"
+
+/*
+ benchmark of scs_update_A against a fresh scs_init, for one random SOCP whose A values are perturbed (same sparsity
+ pattern) and re-solved rounds times.
+
+ usage: bench_update [n] [rounds] [seed]
+
+ both paths normalize and factorize the same values with the same ordering, so the results must be identical.
+ */
+
+/* Data with its own copy of A (with values Ax) and the b, c, settings of d, since scs_init normalizes A in place */
+static Data * copyData(const Data * d, const scs_float * Ax) {
+	Data * dc = scs_calloc(1, sizeof(Data));
+	AMatrix * A = scs_calloc(1, sizeof(AMatrix));
+	scs_int nnz = d->A->p[d->n];
+	*dc = *d;
+	A->m = d->m;
+	A->n = d->n;
+	A->x = scs_malloc(nnz * sizeof(scs_float));
+	A->i = scs_malloc(nnz * sizeof(scs_int));
+	A->p = scs_malloc((d->n + 1) * sizeof(scs_int));
+	memcpy(A->x, Ax, nnz * sizeof(scs_float));
+	memcpy(A->i, d->A->i, nnz * sizeof(scs_int));
+	memcpy(A->p, d->A->p, (d->n + 1) * sizeof(scs_int));
+	dc->A = A;
+	return dc;
+}
+
+static void freeCopy(Data * dc) {
+	scs_free(dc->A->x);
+	scs_free(dc->A->i);
+	scs_free(dc->A->p);
+	scs_free(dc->A);
+	scs_free(dc);
+}
+
+static void freeSolVecs(Sol * sol) {
+	scs_free(sol->x);
+	scs_free(sol->y);
+	scs_free(sol->s);
+	sol->x = sol->y = sol->s = SCS_NULL;
+}
+
+int main(int argc, char **argv) {
+	scs_int n = argc > 1 ? atoi(argv[1]) : 1000;
+	scs_int rounds = argc > 2 ? atoi(argv[2]) : 5;
+	int seed = argc > 3 ? atoi(argv[3]) : 1;
+	scs_int m = 3 * n, col_nnz = (scs_int) ceil(sqrt(n)), nnz = n * col_nnz, rows, size, r, mismatches = 0;
+	scs_float tInit = 0, tUpdate = 0, t, *Ax0, *Ax;
+	Data * d = scs_calloc(1, sizeof(Data)), *dc;
+	Cone * k = scs_calloc(1, sizeof(Cone));
+	Sol opt = { 0 }, solUpdate = { 0 }, solInit = { 0 };
+	Info info = { 0 }, infoUpdate = { 0 }, infoInit = { 0 };
+	Work * w, *wc;
+	timer setupTimer;
+
+	srand(seed);
+	d->stgs = scs_calloc(1, sizeof(Settings));
+	d->m = m;
+	d->n = n;
+	k->f = n / 3;
+	k->l = n;
+	rows = m - k->f - k->l;
+	k->q = scs_malloc(rows * sizeof(scs_int));
+	while (rows > 0) {
+		/* MIN evaluates its arguments twice */
+		size = 3 + rand() % 5;
+		size = MIN(size, rows);
+		k->q[k->qsize++] = size;
+		rows -= size;
+	}
+	genRandomProbData(nnz, col_nnz, d, k, &opt);
+	setDefaultSettings(d);
+	d->stgs->verbose = 0;
+	/* the original values, d->A is normalized in place by scs_init */
+	Ax0 = scs_malloc(nnz * sizeof(scs_float));
+	Ax = scs_malloc(nnz * sizeof(scs_float));
+	memcpy(Ax0, d->A->x, nnz * sizeof(scs_float));
+
+	w = scs_init(d, k, &info);
+	if (!w) {
+		scs_printf("scs_init failed\n");
+		return -1;
+	}
+	for (r = 0; r < rounds; ++r) {
+		memcpy(Ax, Ax0, nnz * sizeof(scs_float));
+		perturbVector(Ax, nnz);
+
+		tic(&setupTimer);
+		if (scs_update_A(w, Ax) < 0) {
+			scs_printf("scs_update_A failed\n");
+			return -1;
+		}
+		tUpdate += t = tocq(&setupTimer);
+		scs_solve(w, d, k, &solUpdate, &infoUpdate);
+
+		dc = copyData(d, Ax);
+		tic(&setupTimer);
+		wc = scs_init(dc, k, &infoInit);
+		tInit += tocq(&setupTimer);
+		if (!wc) {
+			scs_printf("scs_init failed\n");
+			return -1;
+		}
+		scs_solve(wc, dc, k, &solInit, &infoInit);
+
+		if (infoUpdate.statusVal != infoInit.statusVal || infoUpdate.iter != infoInit.iter
+				|| memcmp(solUpdate.x, solInit.x, n * sizeof(scs_float))
+				|| memcmp(solUpdate.y, solInit.y, m * sizeof(scs_float))
+				|| memcmp(solUpdate.s, solInit.s, m * sizeof(scs_float))) {
+			scs_printf("round %li: result after scs_update_A differs from scs_init (%s in %li vs %s in %li iterations)\n",
+					(long) r, infoUpdate.status, (long) infoUpdate.iter, infoInit.status, (long) infoInit.iter);
+			mismatches++;
+		}
+		scs_printf("round %li: %s in %li iterations, update %.2f ms, init %.2f ms (ordering %.2f ms, factorization "
+				"%.2f ms)\n", (long) r, infoUpdate.status, (long) infoUpdate.iter, t, infoInit.setupTime,
+				infoInit.orderingTime, infoInit.factorTime);
+		scs_finish(wc);
+		freeCopy(dc);
+		freeSolVecs(&solUpdate);
+		freeSolVecs(&solInit);
+	}
+	scs_printf("n = %li, m = %li, %li rounds, %li mismatches\n", (long) n, (long) m, (long) rounds, (long) mismatches);
+	scs_printf("scs_init:     %8.2f ms per round\n", tInit / rounds);
+	scs_printf("scs_update_A: %8.2f ms per round (%.2fx)\n", tUpdate / rounds, tInit / tUpdate);
+
+	scs_finish(w);
+	freeData(d, k);
+	scs_free(Ax0);
+	scs_free(Ax);
+	scs_free(opt.x);
+	scs_free(opt.y);
+	scs_free(opt.s);
+	return mismatches > 0;
+}
@@ -191,13 +191,13 @@ y  = yy;
 
 iters = info.iter;
 switch info.status
-    case { 'Solved', 'Solved/Inaccurate', 'Inaccurate/Solved' },
+    case { 'Solved', 'Solved/Inaccurate', 'Inaccurate/Solved', 'Solved/Time limit' },
         tol = max([info.resPri,info.resDual,info.relGap]);
         status = 'Solved';
-    case { 'Unbounded', 'Unbounded/Inaccurate', 'Inaccurate/Unbounded' },
+    case { 'Unbounded', 'Unbounded/Inaccurate', 'Inaccurate/Unbounded', 'Unbounded/Time limit' },
         tol = info.resPri;
         status = 'Infeasible';
-    case { 'Infeasible', 'Infeasible/Inaccurate', 'Inaccurate/Infeasible' },
+    case { 'Infeasible', 'Infeasible/Inaccurate', 'Inaccurate/Infeasible', 'Infeasible/Time limit' },
         status = 'Unbounded';
         tol = info.resDual;
     otherwise,
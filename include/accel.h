@@ -0,0 +1,30 @@
+#ifndef ACCEL_H_GUARD
+#define ACCEL_H_GUARD
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "glbopts.h"
+
+/* Anderson acceleration of the (u, v) fixed-point iteration, private struct defined in accel.c */
+typedef struct SCS_ACCEL Accel;
+
+/* allocates acceleration workspace of depth w->stgs->acceleration_lookback, returns SCS_NULL on failure */
+Accel * initAccel(const Work * w);
+/* clears the stored iterate history, called at the start of every solve once w->u, w->v are initialized */
+void resetAccel(Accel * a, const Work * w);
+/*
+ * called between iterations: w->u (and w->v) hold the output of the last iteration,
+ * on return they hold the (possibly extrapolated) input to the next iteration.
+ * returns 1 if an accelerated step was taken, 0 otherwise
+ */
+scs_int accelerate(Work * w);
+void freeAccel(Accel * a);
+/* returns string containing summary information about acceleration, free will be called on output */
+char * getAccelSummary(Accel * a, const Info * info);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
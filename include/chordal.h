@@ -0,0 +1,43 @@
+#ifndef CHORDAL_H_GUARD
+#define CHORDAL_H_GUARD
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "glbopts.h"
+
+/* chordal decomposition of the large sparse SD blocks (chordal_decomposition), private struct defined in chordal.c */
+typedef struct SCS_CHORDAL_WORK ChordalWork;
+
+/*
+ * finds the SD blocks of k whose aggregate sparsity pattern (the entries with a nonempty row of d->A or a nonzero of
+ * d->b) has a chordal extension with much smaller maximal cliques, and rewrites the problem with each such block
+ * replaced by one SD block per clique, the cliques that share entries joined by consistency constraints.
+ * returns SCS_NULL if no block is worth decomposing (always without blas+lapack), or on failure
+ */
+ChordalWork * initChordal(const Data * d, const Cone * k);
+/* the decomposed problem, its b and c are filled by chordalForward and its settings are d->stgs of initChordal */
+Data * getChordalData(ChordalWork * ch);
+Cone * getChordalCone(ChordalWork * ch);
+/* the decomposed solution scs_solve works on */
+Sol * getChordalSol(ChordalWork * ch);
+/*
+ * maps b, c (and the warm start in sol if not SCS_NULL) of the original problem to bOut, cOut (and dsol) of the
+ * decomposed one. returns -1 if b has a nonzero outside the chordal extension of a decomposed block
+ */
+scs_int chordalForward(ChordalWork * ch, const scs_float * b, const scs_float * c, scs_float * bOut, scs_float * cOut,
+		const Sol * sol, Sol * dsol);
+/* maps the decomposed solution dsol back to sol, the dual variables outside the chordal extensions of the decomposed
+ * blocks are filled in by positive semidefinite completion. allocates the arrays of sol that are SCS_NULL */
+void chordalBackward(ChordalWork * ch, const Sol * dsol, Sol * sol);
+/* the values of the decomposed A for the new values Ax_new of the original one (scs_update_A) */
+const scs_float * chordalUpdateA(ChordalWork * ch, const scs_float * Ax_new);
+/* returns string describing the decomposition, free will be called on output */
+char * getChordalSummary(ChordalWork * ch);
+void finishChordal(ChordalWork * ch);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
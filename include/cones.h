@@ -21,18 +21,106 @@ struct SCS_CONE {
     scs_float *p; /* array of power cone params, must be \in [-1, 1],
                     negative values are interpreted as specifying the dual cone */
     scs_int psize; /* number of (primal and dual) power cone triples */
+    scs_int gpsize; /* number of generalized power cones {(x, z) | prod_i x_i^a_i >= ||z||, x >= 0} */
+    scs_int *gpm, *gpn; /* their numbers of x and z entries, the rows of each cone are x then z */
+    scs_float *gpa; /* their exponents a of x one cone after another, sum(gpm) entries, positive and summing to 1 in
+                       each cone */
+    scs_int bsize; /* length of the box cone {(t, s) | t * bl <= s <= t * bu}, including t (0 for none) */
+    scs_float *bl, *bu; /* its lower and upper bounds, arrays of length bsize - 1, entries beyond +/- 1e20 are
+                           infinite */
+    scs_int *cs; /* array of complex Hermitian PSD constraints */
+    scs_int cssize; /* length of Hermitian PSD array */
 };
 
+#define CONE_JOB_SOC (0)
+#define CONE_JOB_SD (1)
+#define CONE_JOB_CS (2)
+#define CONE_JOB_POW (3)
+#define CONE_JOB_GPOW (4)
+
+/* consecutive SOC, SD, Hermitian PSD, power or generalized power cone blocks that are projected together by one
+   thread */
+typedef struct {
+    scs_int type; /* CONE_JOB_SOC, CONE_JOB_SD, CONE_JOB_CS, CONE_JOB_POW or CONE_JOB_GPOW */
+    scs_int first, last; /* projects blocks first, ..., last - 1 of that cone type */
+    scs_int start; /* row of block first */
+    scs_float cost; /* estimated flops */
+} ConeJob;
+
+/* an SOC block of dimension q starting at row row */
+typedef struct {
+    scs_int q, row;
+} SocBlock;
+
+/* SD block index of size n starting at row row */
+typedef struct {
+    scs_int n, row, index;
+} SdBlockRef;
+
 #ifdef LAPACK_LIB_FOUND
-/* private data to help cone projection step */
+/* workspace for the eigenvector decompositions of one thread */
 typedef struct {
-    /* workspace for eigenvector decompositions: */
     scs_float * Xs, *Z, *e, *work;
     blasint *iwork, lwork, liwork;
-} ConeWork;
-#else
-typedef void * ConeWork;
+    /* for the warm-started partial decompositions (sdp_warm_eig), sized for the largest block that uses them */
+    scs_float * XV; /* X times the Ritz vectors */
+    scs_float * H, *Hz, *He; /* Rayleigh quotient of the subspace, its eigenvectors and eigenvalues */
+    scs_float * ritz, *coef; /* Ritz values kept, Gram-Schmidt coefficients */
+    scs_float * lanczos; /* Lanczos vectors of the complement check */
+    blasint * isuppz;
+} SdConeWork;
+
+/* state kept between the projections of one SD block */
+typedef struct {
+    /* definiteness pretests: a Cholesky factorization of X (or -X) shows the block is PSD (NSD) */
+    scs_int definite; /* 1 (-1) if the block was PSD (NSD) at its last projection, the first pretest tried */
+    /* warm-started partial decompositions (sdp_warm_eig) */
+    scs_float * V; /* n x k orthonormal, approximate eigenvectors of the k largest eigenvalues of sign * X at the last
+                      projection */
+    scs_int k; /* 0 if there are none, e.g. the block was not low rank */
+    scs_int sign; /* -1 if the negative eigenspace is the small one, the projection is X plus that of -X */
+    scs_int backoff, skip; /* after a failed warm start the next skip projections use the full decomposition */
+    /* projections since the last getConeInfo: all, found PSD, found NSD, by warm-started partial decomposition */
+    scs_int projections, psdHits, nsdHits, warmEigs;
+    /* the same counts up to the last getConeInfo, for getConeSummary */
+    scs_int lastProjections, lastPsdHits, lastNsdHits, lastWarmEigs;
+} SdBlockWork;
+
+/* workspace for the eigendecompositions of the Hermitian PSD blocks of one thread, complex arrays interleave the
+   real and imaginary parts */
+typedef struct {
+    scs_float * Xs, *Z, *e, *work, *rwork;
+    blasint *iwork, lwork, lrwork, liwork;
+} CsConeWork;
+#endif
+
+/* private data to help cone projection step */
+typedef struct {
+    scs_float totalConeTime; /* time spent in projDualCone since last getConeInfo (milliseconds) */
+    /* the part of totalConeTime spent on each cone family */
+    scs_float lpTime, socTime, sdTime, expTime, powTime, boxTime;
+    ConeJob * jobs; /* the SOC, SD, Hermitian PSD and (generalized) power cone blocks grouped into jobs, largest cost
+                       first */
+    scs_int numJobs;
+    scs_int numThreads; /* number of threads the jobs are spread over */
+    scs_int expStart; /* row of the first exponential cone */
+    SocBlock * socBlocks; /* the SOC blocks, within each job sorted by dimension so equal ones are projected together */
+    SdBlockRef * sdOrder; /* the SD blocks, within each job sorted by size so equal small ones are projected together */
+    scs_float * powScale; /* a^a (1-a)^(1-a) for each power cone, a = |p| */
+    scs_int * gpaStart; /* where the exponents of each generalized power cone start in gpa */
+    /* the box cone: its first row and length, its bounds, and those bounds in the coordinates of the rows of A scaled
+       by D (normalize) that projDualCone uses instead, SCS_NULL without scaling (setConeScaling) */
+    scs_int boxRow, boxLen;
+    const scs_float * bl, *bu;
+    scs_float * boxBl, *boxBu;
+    scs_int sdWarmEig; /* boolean, the sdp_warm_eig setting of the current solve */
+#ifdef LAPACK_LIB_FOUND
+    SdConeWork * sd; /* one eigenvector decomposition workspace per thread */
+    SdBlockWork * sdBlocks; /* one per SD block */
+    scs_int numSdBlocks;
+    CsConeWork * csWork; /* one Hermitian eigenvector decomposition workspace per thread */
 #endif
+} ConeWork;
 
 /*
  * boundaries will contain array of indices of rows of A corresponding to
@@ -43,6 +131,12 @@ scs_int getConeBoundaries(const Cone * k, scs_int ** boundaries);
 
 ConeWork * initCone(const Cone * k);
 char * getConeHeader(const Cone * k);
+/*
+ * D the row scaling of A (normalize): the box cone rows are scaled one by one, the other cones as a whole and so are
+ * invariant. sets D_t of the (empty) row t of the box cone from the bounds, which become bl_i D_t / D_i. SCS_NULL to
+ * project onto the cone as given. returns -1 on allocation failure
+ */
+scs_int setConeScaling(ConeWork * c, scs_float * D);
 scs_int validateCones(const Data * d, const Cone * k);
 
 /* pass in iter to control how accurate the cone projection
@@ -50,7 +144,9 @@ scs_int validateCones(const Data * d, const Cone * k);
  of solution, can be SCS_NULL*/
 scs_int projDualCone(scs_float * x, const Cone *k, ConeWork * c, const scs_float * warm_start, scs_int iter);
 void finishCone(ConeWork * coneWork);
-char * getConeSummary(const Info * info);
+char * getConeSummary(const Info * info, ConeWork * c);
+/* copies the projection times accumulated since the last call into info, then resets them */
+void getConeInfo(ConeWork * c, Info * info);
 
 #ifdef __cplusplus
 }
@@ -9,6 +9,7 @@ extern "C" {
 #define SCS_VERSION ("1.1.7") /* string literals automatically null-terminated */
 
 /* SCS returns one of the following integers:                           */
+#define SCS_TIME_LIMIT              (-8) /* hit time_limit, returns best iterate found */
 #define SCS_INFEASIBLE_INACCURATE   (-7)
 #define SCS_UNBOUNDED_INACCURATE    (-6)
 #define SCS_SIGINT                  (-5)
@@ -30,6 +31,22 @@ extern "C" {
 #define VERBOSE         (1)
 #define NORMALIZE       (1)
 #define WARM_START      (0)
+#define ACCEL_LOOKBACK  (0)
+#define ACCEL_TYPE      (2)
+#define ADAPTIVE_SCALE  (0)
+#define TIME_LIMIT      (0)
+#define MIXED_PRECISION (0)
+#define SDP_WARM_EIG    (0)
+#define CHORDAL_DECOMPOSITION (0)
+/* default of the supernodal setting, can be set at build time (make SUPERNODAL=0) */
+#ifndef SUPERNODAL
+#define SUPERNODAL      (1)
+#endif
+#ifndef NORMAL_EQUATIONS
+#define NORMAL_EQUATIONS (1)
+#endif
+#define FACTOR_CACHE    SCS_NULL
+#define TREE_PARALLEL   (0)
 
 #ifdef __cplusplus
 }
@@ -13,6 +13,16 @@ typedef struct PRIVATE_DATA Priv;
 Priv * initPriv(const AMatrix * A, const Settings * stgs);
 /* solves [d->RHO_X * I  A' ; A  -I] x = b for x, stores result in b, s contains warm-start, iter is current scs iteration count */
 scs_int solveLinSys(const AMatrix * A, const Settings * stgs, Priv * p, scs_float * b, const scs_float * s, scs_int iter);
+/* solves the same system as solveLinSys for nrhs right-hand sides b[0], ..., b[nrhs - 1] (results stored in b[j]),
+ * s[j] is the warm-start for b[j] (s can be SCS_NULL), shares passes over the factorization / data between them */
+scs_int solveLinSysBatch(const AMatrix * A, const Settings * stgs, Priv * p, scs_float ** b, const scs_float ** s,
+		scs_int nrhs, scs_int iter);
+/* selects whether subsequent solveLinSys calls use the full precision data or a single precision copy of it (made on
+ * first use and kept in sync by updateLinSys), used for mixed precision solves, returns negative num on failure */
+scs_int setLinSysPrecision(const AMatrix * A, Priv * p, scs_int single);
+/* called when the values of A (but not its sparsity pattern) or rho_x have changed since initPriv,
+ * refreshes the factorization / preconditioner in place, returns negative num on failure */
+scs_int updateLinSys(const AMatrix * A, const Settings * stgs, Priv * p);
 /* frees Priv structure and allocated memory in Priv */
 void freePriv(Priv * p);
 
@@ -26,16 +36,26 @@ scs_int validateLinSys(const AMatrix * A);
 
 /* returns string describing method, can return null, if not null free will be called on output */
 char * getLinSysMethod(const AMatrix * A, const Settings * stgs);
-/* returns string containing summary information about linear system solves, can return null, if not null free will be called on output */
+/* returns string containing summary information about linear system solves (info has been filled by getLinSysInfo),
+ * can return null, if not null free will be called on output */
 char * getLinSysSummary(Priv * p, const Info * info);
+/* copies the linear system statistics into info: solve / SpMV times and CG iterations accumulated since the last call
+ * (these are then reset), and the ordering / factorization times and nnz in L since initPriv */
+void getLinSysInfo(Priv * p, Info * info);
 
 /* Normalization routines, used if d->NORMALIZE is true */
 /* normalizes A matrix, sets w->E and w->D diagonal scaling matrices, Anew = d->SCALE * (D^-1)*A*(E^-1) (different to paper which is D*A*E)
  * D and E must be all positive entries, D must satisfy cone boundaries
- * must set (w->meanNormRowA = mean of norms of rows of normalized A) THEN scale resulting A by d->SCALE */
+ * must set (w->meanNormRowA = mean of norms of rows of normalized A) THEN scale resulting A by d->SCALE
+ * allocates scal->D and scal->E, k is only used if scal->boundaries is SCS_NULL (the cone boundaries are then stored in
+ * scal, so A can be renormalized after its values change without the cone) */
 void normalizeA(AMatrix * A, const Settings * stgs, const Cone * k, Scaling * scal);
 /* unnormalizes A matrix, unnormalizes by w->D and w->E and d->SCALE */
 void unNormalizeA(AMatrix * A, const Settings * stgs, const Scaling * scal);
+/* multiplies normalized A by factor, used when the scale is adapted during a solve */
+void rescaleA(AMatrix * A, scs_float factor);
+/* overwrites the values of A with Ax (same sparsity pattern, Ax in the same order as the values of A) */
+void setAMatrixValues(AMatrix * A, const scs_float * Ax);
 /* to free the memory allocated in AMatrix */
 void freeAMatrix(AMatrix * A);
 
@@ -19,8 +19,8 @@ void normalizeBC(Work * w) {
     }
     nm = calcNorm(c, w->n);
     w->sc_c = w->scal->meanNormRowA / MAX(nm, MIN_SCALE);
-    scaleArray(b, w->sc_b * w->stgs->scale, w->m);
-    scaleArray(c, w->sc_c * w->stgs->scale, w->n);
+    scaleArray(b, w->sc_b * w->scale, w->m);
+    scaleArray(c, w->sc_c * w->scale, w->n);
 }
 
 void calcScaledResids(Work * w, struct residuals * r) {
@@ -73,7 +73,7 @@ void normalizeWarmStart(Work * w) {
 		y[i] *= (D[i] * w->sc_c);
 	}
 	for (i = 0; i < w->m; ++i) {
-		s[i] /= (D[i] / (w->sc_b * w->stgs->scale));
+		s[i] /= (D[i] / (w->sc_b * w->scale));
 	}
 }
 
@@ -88,7 +88,7 @@ void unNormalizeSol(Work * w, Sol * sol) {
 		sol->y[i] /= (D[i] * w->sc_c);
 	}
 	for (i = 0; i < w->m; ++i) {
-		sol->s[i] *= D[i] / (w->sc_b * w->stgs->scale);
+		sol->s[i] *= D[i] / (w->sc_b * w->scale);
 	}
 }
 
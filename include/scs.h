@@ -13,6 +13,8 @@ extern "C" {
 #include "util.h"
 #include "ctrlc.h"
 #include "constants.h"
+#include "accel.h"
+#include "chordal.h"
 
 /* struct containing problem data */
 struct SCS_PROBLEM_DATA {
@@ -42,6 +44,32 @@ struct SCS_SETTINGS {
 	scs_float cg_rate; /* for indirect, tolerance goes down like (1/iter)^cg_rate: 2 */
 	scs_int verbose; /* boolean, write out progress: 1 */
 	scs_int warm_start; /* boolean, warm start (put initial guess in Sol struct): 0 */
+	/* the settings from here on are appended in the order they were added, those that cannot change for multiple
+	 * runs with the same call to scs_init say so */
+	/* memory depth for Anderson acceleration, 0 disables, cannot change after scs_init: 0 */
+	scs_int acceleration_lookback;
+	/* Anderson acceleration type, 1 or 2 (type-I or type-II), cannot change after scs_init: 2 */
+	scs_int acceleration_type;
+	scs_int adaptive_scale; /* max number of scale updates (each refactorizes) per solve, 0 disables: 0 */
+	scs_float time_limit; /* wall-clock limit per solve (milliseconds), returns the best iterate when hit, 0 disables: 0 */
+	scs_int mixed_precision; /* boolean, bulk of the iterations with single precision linear system data, then double: 0 */
+	scs_int sdp_warm_eig; /* boolean, warm start the projections of large SD blocks from the previous eigenvectors: 0 */
+	/* boolean, split large sparse SD blocks into the cliques of a chordal extension, cannot change after scs_init: 0.
+	 * b must then stay zero outside the pattern found by scs_init (scs_solve fails otherwise), and the dual variables
+	 * outside it are a positive semidefinite completion of the cliques' ones, so y is in the dual cone only up to the
+	 * tolerance eps */
+	scs_int chordal_decomposition;
+	/* boolean, direct only, factor the KKT matrix in dense supernodal blocks if it fills in, cannot change after
+	 * scs_init: 1 */
+	scs_int supernodal;
+	/* boolean, direct only, factor rho_x I + A'A instead if its factor is smaller, cannot change after scs_init: 1 */
+	scs_int normal_equations;
+	/* direct only, directory of the on-disk factorization cache, SCS_NULL disables, cannot change after scs_init:
+	 * SCS_NULL */
+	const char * factor_cache;
+	/* boolean, direct only, with OpenMP factor and solve independent subtrees in parallel, cannot change after
+	 * scs_init: 0 */
+	scs_int tree_parallel;
 };
 
 /* contains primal-dual solution arrays */
@@ -63,6 +91,22 @@ struct SCS_INFO {
 	scs_float relGap; /* relative duality gap */
 	scs_float setupTime; /* time taken for setup phase (milliseconds) */
 	scs_float solveTime; /* time taken for solve phase (milliseconds) */
+	scs_int refactorizations; /* number of linear system refactorizations due to scale updates */
+	scs_int singleIters; /* iterations taken with single precision linear system data (mixed_precision) */
+	/* per-phase totals for the solve (times in milliseconds), cheap enough to be always on */
+	scs_float linSysTime; /* linear system solves */
+	scs_float coneTime; /* cone projections, broken down by cone family below */
+	scs_float lpConeTime, socConeTime, sdConeTime, expConeTime, powConeTime, boxConeTime;
+	scs_int sdProjections; /* projections of SD blocks larger than 8x8 (the smaller ones use a Jacobi kernel) */
+	scs_int sdPsdHits, sdNsdHits; /* of those, found PSD (kept) or NSD (zeroed) by a Cholesky pretest */
+	scs_int sdWarmEigs; /* SD block projections by warm-started partial eigendecomposition (sdp_warm_eig) */
+	scs_float residualTime; /* residual computation */
+	scs_float spmvTime; /* products with A and A' (in residual computation and, for indirect, in CG) */
+	scs_int cgIters; /* total number of CG iterations (indirect only) */
+	scs_float orderingTime; /* fill-reducing ordering in scs_init (direct only) */
+	scs_float factorTime; /* factorization in scs_init plus any refactorizations since (indirect: preconditioner setup) */
+	scs_int nnzL; /* nonzeros in the factor L (direct only) */
+	scs_int factorCacheHit; /* factor_cache (direct only): 1 factorization loaded from it, 0 missed (stored), -1 unused */
 };
 
 
@@ -70,16 +114,29 @@ struct SCS_INFO {
 struct SCS_SCALING {
 	scs_float *D, *E; /* for normalization */
 	scs_float meanNormRowA, meanNormColA;
+	scs_int *boundaries, numBoundaries; /* cone boundaries of the rows of A, kept so scs_update_A can renormalize */
 };
 
 /*
  * main library api's:
  * scs_init: allocates memory etc (direct version factorizes matrix [I A; A^T -I])
  * scs_solve: can be called many times with different b,c data for one init call
+ * scs_solve_batch: solves nProblems problems with the same A and cones as the init call at once, problem j has data
+ *   b[j], c[j] and its solution / info (and warm-start) in sol[j], info[j]. the problems iterate together and share
+ *   each linear system solve, converged problems drop out. adaptive_scale, mixed_precision and sdp_warm_eig are ignored. returns
+ *   0, or SCS_FAILED / SCS_SIGINT if the batch was aborted (problems that had not converged get that status). the
+ *   per-phase timings and counters in each info[j] are the totals for the whole batch
+ * scs_update_A: the values of A changed (same sparsity pattern) since the init call, Ax_new holds them in the order of
+ *   d->A's values. redoes the normalization and the numeric factorization (indirect: A' and the preconditioner), keeping
+ *   the ordering and symbolic factorization. unless COPYAMATRIX is defined the new values are written into d->A (as
+ *   with scs_init). returns 0, or SCS_FAILED (w can then only be passed to scs_finish)
  * scs_finish: cleans up the memory (one per init call)
  */
 Work * scs_init(const Data * d, const Cone * k, Info * info);
 scs_int scs_solve(Work * w, const Data * d, const Cone * k, Sol * sol, Info * info);
+scs_int scs_solve_batch(Work * w, const Data * d, const Cone * k, scs_int nProblems, scs_float ** b, scs_float ** c,
+		Sol * sol, Info * info);
+scs_int scs_update_A(Work * w, const scs_float * Ax_new);
 void scs_finish(Work * w);
 /* scs calls scs_init, scs_solve, and scs_finish */
 scs_int scs(const Data * d, const Cone * k, Sol * sol, Info * info);
@@ -89,9 +146,11 @@ const char * scs_version(void);
 
 /* workspace for SCS */
 struct SCS_WORK {
-	scs_float *u, *v, *u_t, *u_prev; /* u_prev = u from previous iteration */
+	scs_float *u, *v, *u_t, *u_prev; /* u_prev = u from previous iteration (u and u_prev are swapped each iteration) */
 	scs_float *h, *g, *pr, *dr;
 	scs_float gTh, sc_b, sc_c, nm_b, nm_c;
+	scs_float scale; /* current data scale, starts at stgs->scale and changes if adaptive_scale is on */
+	scs_int lastScaleIter; /* iteration of the last scale update */
 	scs_float *b, *c; /* (possibly normalized) b and c vectors */
 	scs_int m, n; /* A has m rows, n cols */
 	AMatrix * A; /* (possibly normalized) A matrix */
@@ -99,6 +158,15 @@ struct SCS_WORK {
 	Settings * stgs; /* contains solver settings specified by user */
 	Scaling * scal; /* contains the re-scaling data */
 	ConeWork * coneWork; /* workspace for the cone projection step */
+	Accel * accel; /* Anderson acceleration workspace, SCS_NULL if disabled */
+	scs_float *u_best, *v_best; /* best iterate seen so far, only kept if time_limit > 0 */
+	scs_float bestDist; /* distance of the best iterate to the closest termination criterion */
+	scs_int bestIter; /* iteration of the best iterate, -1 if none */
+	scs_float residualTime; /* time spent in calcResiduals this solve (milliseconds) */
+	scs_int singlePrecision; /* the linear system is using its single precision data (mixed_precision) */
+	scs_float singleBestDist; /* smallest terminationDist in the single precision phase */
+	scs_int singleStall; /* convergence checks since singleBestDist last improved */
+	ChordalWork * chordal; /* chordal decomposition, the work is for the decomposed problem, SCS_NULL if none */
 };
 
 /* to hold residual information (unnormalized) */
@@ -17,18 +17,22 @@ extern "C" {
     /* single or double precision */
     #ifndef FLOAT
         #define BLAS(x) d ## x
+        #define BLASC(x) z ## x
     #else
         #define BLAS(x) s ## x
+        #define BLASC(x) c ## x
     #endif
 #else
     /* this extra indirection is needed for BLASSUFFIX to work correctly as a variable */
     #define stitch_(pre,x,post) pre ## x ## post
     #define stitch__(pre,x,post) stitch_(pre,x,post)
-    /* single or double precision */
+    /* single or double precision, BLASC for the complex routines of the same precision */
     #ifndef FLOAT
         #define BLAS(x) stitch__(d,x,BLASSUFFIX)
+        #define BLASC(x) stitch__(z,x,BLASSUFFIX)
     #else
         #define BLAS(x) stitch__(s,x,BLASSUFFIX)
+        #define BLASC(x) stitch__(c,x,BLASSUFFIX)
     #endif
 #endif
 
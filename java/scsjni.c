@@ -96,6 +96,17 @@ void populateParams(JNIEnv * env, jobject paramsJava, Data * d) {
     d->stgs->normalize = getBooleanUsingGetter(env, paramsJava, "isNormalize");
     d->stgs->scale = getFloatUsingGetter(env, paramsJava, "getScale");
     d->stgs->warm_start = getBooleanUsingGetter(env, paramsJava, "isWarmStart");
+    d->stgs->acceleration_lookback = ACCEL_LOOKBACK;
+    d->stgs->acceleration_type = ACCEL_TYPE;
+    d->stgs->adaptive_scale = ADAPTIVE_SCALE;
+    d->stgs->time_limit = TIME_LIMIT;
+    d->stgs->mixed_precision = MIXED_PRECISION;
+    d->stgs->sdp_warm_eig = SDP_WARM_EIG;
+    d->stgs->chordal_decomposition = CHORDAL_DECOMPOSITION;
+    d->stgs->supernodal = SUPERNODAL;
+    d->stgs->normal_equations = NORMAL_EQUATIONS;
+    d->stgs->factor_cache = FACTOR_CACHE;
+    d->stgs->tree_parallel = TREE_PARALLEL;
 }
 
 Data * getDataStruct(JNIEnv * env, jobject AJava, jdoubleArray bJava, jdoubleArray cJava, jobject paramsJava) {
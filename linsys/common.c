@@ -88,9 +88,14 @@ void normalizeA(AMatrix * A, const Settings * stgs, const Cone * k, Scaling * sc
 	scs_float * nms = scs_calloc(A->m, sizeof(scs_float));
 	scs_float minRowScale = MIN_SCALE * SQRTF((scs_float) A->n), maxRowScale = MAX_SCALE * SQRTF((scs_float) A->n);
 	scs_float minColScale = MIN_SCALE * SQRTF((scs_float) A->m), maxColScale = MAX_SCALE * SQRTF((scs_float) A->m);
-	scs_int i, j, l, count, delta, *boundaries, c1, c2;
+	scs_int i, j, l, count, delta, *boundaries, numBoundaries, c1, c2;
 	scs_float wrk, e;
-	scs_int numBoundaries = getConeBoundaries(k, &boundaries);
+
+	if (!scal->boundaries) {
+		scal->numBoundaries = getConeBoundaries(k, &(scal->boundaries));
+	}
+	boundaries = scal->boundaries;
+	numBoundaries = scal->numBoundaries;
 
 #if EXTRAVERBOSE > 0
 	timer normalizeTimer;
@@ -162,7 +167,6 @@ void normalizeA(AMatrix * A, const Settings * stgs, const Cone * k, Scaling * sc
 			Et[i] = (l == 0) ? E[i] : Et[i] * E[i];
 		}
 	}
-	scs_free(boundaries);
 	scs_free(D);
 	scs_free(E);
 
@@ -214,6 +218,16 @@ void unNormalizeA(AMatrix * A, const Settings * stgs, const Scaling * scal) {
 	}
 }
 
+void rescaleA(AMatrix * A, scs_float factor) {
+	scaleArray(A->x, factor, A->p[A->n]);
+}
+
+void setAMatrixValues(AMatrix * A, const scs_float * Ax) {
+	if (A->x != Ax) {
+		memcpy(A->x, Ax, A->p[A->n] * sizeof(scs_float));
+	}
+}
+
 void _accumByAtrans(scs_int n, scs_float * Ax, scs_int * Ai, scs_int * Ap, const scs_float *x, scs_float *y) {
     /* y += A'*x
        A in column compressed format
@@ -0,0 +1,299 @@
+#include "factorCache.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+/* first bytes of a cache file */
+#define FACTOR_CACHE_MAGIC "SCSFACT"
+/* the key: version, sizeof(scs_int), sizeof(scs_float), n, m, nnz(A), normalize, supernodal, normal_equations (then
+ * rho_x and scale, and A) */
+#define KEY_SIZE (9)
+/* the shape of the factorization: normal equations, supernodal, dimension, then nnz(L) or nsuper, maxRows, maxCols,
+ * nnz, number of rows and of entries of the supernodes */
+#define SHAPE_SIZE (9)
+
+/* FNV-1a over 64-bit words (and the bytes left), for the file names and the checksums. the product only carries
+ * bits upwards, so the high half is folded into the low one after each word */
+#define HASH_OFFSET (14695981039346656037ULL)
+#define HASH_PRIME (1099511628211ULL)
+
+typedef struct CACHE_FILE {
+	FILE * f;
+	uint64_t sum; /* of everything read or written so far */
+	scs_int ok;
+} CacheFile;
+
+static uint64_t hashBytes(uint64_t h, const void * data, size_t len) {
+	const unsigned char * c = (const unsigned char *) data;
+	uint64_t w;
+	size_t k;
+	for (k = 0; k + 8 <= len; k += 8) {
+		memcpy(&w, &(c[k]), 8);
+		h = (h ^ w) * HASH_PRIME;
+		h ^= h >> 32;
+	}
+	for (; k < len; ++k) {
+		h = (h ^ c[k]) * HASH_PRIME;
+	}
+	return h;
+}
+
+static void fillKey(const AMatrix * A, const Settings * stgs, scs_int * key, scs_float * fkey) {
+	key[0] = FACTOR_CACHE_VERSION;
+	key[1] = sizeof(scs_int);
+	key[2] = sizeof(scs_float);
+	key[3] = A->n;
+	key[4] = A->m;
+	key[5] = A->p[A->n];
+	key[6] = stgs->normalize;
+	key[7] = stgs->supernodal;
+	key[8] = stgs->normal_equations;
+	fkey[0] = stgs->rho_x;
+	fkey[1] = stgs->scale;
+}
+
+/* factor_cache/scs_<hash of the key>.factor */
+static char * cachePath(const AMatrix * A, const Settings * stgs) {
+	scs_int key[KEY_SIZE], Anz = A->p[A->n];
+	scs_float fkey[2];
+	uint64_t h = HASH_OFFSET;
+	char * path = scs_malloc(strlen(stgs->factor_cache) + 32);
+	if (!path) {
+		return SCS_NULL;
+	}
+	fillKey(A, stgs, key, fkey);
+	h = hashBytes(h, key, sizeof(key));
+	h = hashBytes(h, fkey, sizeof(fkey));
+	h = hashBytes(h, A->p, (A->n + 1) * sizeof(scs_int));
+	h = hashBytes(h, A->i, Anz * sizeof(scs_int));
+	h = hashBytes(h, A->x, Anz * sizeof(scs_float));
+	sprintf(path, "%s/scs_%08lx%08lx.factor", stgs->factor_cache, (unsigned long) (h >> 32),
+			(unsigned long) (h & 0xffffffffUL));
+	return path;
+}
+
+static void put(CacheFile * c, const void * data, size_t len) {
+	if (c->ok && len > 0 && fwrite(data, 1, len, c->f) != len) {
+		c->ok = 0;
+	}
+	c->sum = hashBytes(c->sum, data, len);
+}
+
+static void get(CacheFile * c, void * data, size_t len) {
+	if (c->ok && len > 0 && fread(data, 1, len, c->f) != len) {
+		c->ok = 0;
+	}
+	if (c->ok) {
+		c->sum = hashBytes(c->sum, data, len);
+	}
+}
+
+/* reads len bytes into a new array, SCS_NULL on failure */
+static void * getArray(CacheFile * c, size_t len) {
+	void * data = c->ok ? scs_malloc(MAX(len, 1)) : SCS_NULL;
+	if (!data) {
+		c->ok = 0;
+		return SCS_NULL;
+	}
+	get(c, data, len);
+	if (!c->ok) {
+		scs_free(data);
+		return SCS_NULL;
+	}
+	return data;
+}
+
+/* reads len bytes and checks they are those of data */
+static void getSame(CacheFile * c, const void * data, size_t len) {
+	void * tmp = getArray(c, len);
+	if (tmp && memcmp(tmp, data, len)) {
+		c->ok = 0;
+	}
+	if (tmp)
+		scs_free(tmp);
+}
+
+static void freeArrays(void ** arr, scs_int len) {
+	scs_int k;
+	for (k = 0; k < len; ++k) {
+		if (arr[k])
+			scs_free(arr[k]);
+	}
+}
+
+scs_int loadFactorCache(const AMatrix * A, const Settings * stgs, Priv * p) {
+	scs_int key[KEY_SIZE], shape[SHAPE_SIZE] = { 0 }, dim = A->n + A->m, Anz = A->p[A->n];
+	scs_int *P = SCS_NULL, *Parent = SCS_NULL, *Lnz = SCS_NULL, *Lp = SCS_NULL, *Li = SCS_NULL;
+	scs_float fkey[2], maxNnz, *D = SCS_NULL, *Lx = SCS_NULL;
+	uint64_t sum, stored = 0;
+	void * arr[5];
+	SuperFactor * F = SCS_NULL;
+	char * path = cachePath(A, stgs);
+	CacheFile c;
+	c.f = path ? fopen(path, "rb") : SCS_NULL;
+	if (path)
+		scs_free(path);
+	if (!c.f) {
+		return -1;
+	}
+	c.ok = 1;
+	c.sum = HASH_OFFSET;
+	fillKey(A, stgs, key, fkey);
+	getSame(&c, FACTOR_CACHE_MAGIC, sizeof(FACTOR_CACHE_MAGIC));
+	getSame(&c, key, sizeof(key));
+	getSame(&c, fkey, sizeof(fkey));
+	getSame(&c, A->p, (A->n + 1) * sizeof(scs_int));
+	getSame(&c, A->i, Anz * sizeof(scs_int));
+	getSame(&c, A->x, Anz * sizeof(scs_float));
+	get(&c, shape, sizeof(shape));
+	/* the sizes are checked before anything is allocated from them */
+	if (shape[0]) {
+		dim = A->n;
+	}
+	maxNnz = (scs_float) dim * dim;
+	if (shape[2] != dim || (shape[1] ? shape[3] < 1 || shape[3] > dim || shape[7] < 0 || shape[7] > maxNnz
+			|| shape[8] < 0 || shape[8] > maxNnz : shape[3] < 0 || shape[3] > maxNnz)) {
+		c.ok = 0;
+	}
+	P = getArray(&c, dim * sizeof(scs_int));
+	Parent = getArray(&c, dim * sizeof(scs_int));
+	Lnz = getArray(&c, dim * sizeof(scs_int));
+	D = getArray(&c, dim * sizeof(scs_float));
+	if (shape[1] && c.ok) {
+		F = scs_calloc(1, sizeof(SuperFactor));
+		if (!F) {
+			c.ok = 0;
+		} else {
+			F->n = dim;
+			F->nsuper = shape[3];
+			F->maxRows = shape[4];
+			F->maxCols = shape[5];
+			F->nnz = shape[6];
+			F->super = getArray(&c, (F->nsuper + 1) * sizeof(scs_int));
+			F->colSuper = getArray(&c, dim * sizeof(scs_int));
+			F->rowp = getArray(&c, (F->nsuper + 1) * sizeof(scs_int));
+			F->rows = getArray(&c, shape[7] * sizeof(scs_int));
+			F->xp = getArray(&c, (F->nsuper + 1) * sizeof(scs_int));
+			F->x = getArray(&c, shape[8] * sizeof(scs_float));
+			if (c.ok && (F->rowp[F->nsuper] != shape[7] || F->xp[F->nsuper] != shape[8])) {
+				c.ok = 0;
+			}
+		}
+	} else {
+		Lp = getArray(&c, (dim + 1) * sizeof(scs_int));
+		Li = getArray(&c, shape[3] * sizeof(scs_int));
+		Lx = getArray(&c, shape[3] * sizeof(scs_float));
+		if (c.ok && Lp[dim] != shape[3]) {
+			c.ok = 0;
+		}
+	}
+	sum = c.sum;
+	if (c.ok && fread(&stored, sizeof(stored), 1, c.f) != 1) {
+		c.ok = 0;
+	}
+	fclose(c.f);
+	if (!c.ok || stored != sum) {
+		arr[0] = P;
+		arr[1] = Parent;
+		arr[2] = Lnz;
+		arr[3] = D;
+		arr[4] = Lp;
+		freeArrays(arr, 5);
+		arr[0] = Li;
+		arr[1] = Lx;
+		freeArrays(arr, 2);
+		superFree(F);
+		return -1;
+	}
+	memcpy(p->P, P, dim * sizeof(scs_int));
+	memcpy(p->Parent, Parent, dim * sizeof(scs_int));
+	memcpy(p->Lnz, Lnz, dim * sizeof(scs_int));
+	scs_free(P);
+	scs_free(Parent);
+	scs_free(Lnz);
+	p->D = D;
+	p->normal = shape[0];
+	p->L->m = p->L->n = dim;
+	if (F) {
+		p->super = F;
+	} else {
+		p->L->p = Lp;
+		p->L->i = Li;
+		p->L->x = Lx;
+		p->L->nzmax = shape[3];
+	}
+	return 0;
+}
+
+scs_int saveFactorCache(const AMatrix * A, const Settings * stgs, const Priv * p) {
+	scs_int key[KEY_SIZE], shape[SHAPE_SIZE] = { 0 }, dim = p->L->n, Anz = A->p[A->n];
+	scs_float fkey[2];
+	uint64_t sum;
+	const SuperFactor * F = p->super;
+	char * tmp = SCS_NULL, * path = cachePath(A, stgs);
+	CacheFile c;
+	if (path) {
+		tmp = scs_malloc(strlen(path) + 32);
+	}
+	if (!tmp) {
+		if (path)
+			scs_free(path);
+		return -1;
+	}
+	/* concurrent writers of the same file each write their own, the last rename wins */
+	sprintf(tmp, "%s.%lx.tmp", path, (unsigned long) ((size_t) p ^ (size_t) clock() ^ (size_t) time(SCS_NULL)));
+	c.f = fopen(tmp, "wb");
+	c.ok = c.f != SCS_NULL;
+	c.sum = HASH_OFFSET;
+	fillKey(A, stgs, key, fkey);
+	shape[0] = p->normal;
+	shape[1] = F != SCS_NULL;
+	shape[2] = dim;
+	if (F) {
+		shape[3] = F->nsuper;
+		shape[4] = F->maxRows;
+		shape[5] = F->maxCols;
+		shape[6] = F->nnz;
+		shape[7] = F->rowp[F->nsuper];
+		shape[8] = F->xp[F->nsuper];
+	} else {
+		shape[3] = p->L->p[dim];
+	}
+	if (c.ok) {
+		put(&c, FACTOR_CACHE_MAGIC, sizeof(FACTOR_CACHE_MAGIC));
+		put(&c, key, sizeof(key));
+		put(&c, fkey, sizeof(fkey));
+		put(&c, A->p, (A->n + 1) * sizeof(scs_int));
+		put(&c, A->i, Anz * sizeof(scs_int));
+		put(&c, A->x, Anz * sizeof(scs_float));
+		put(&c, shape, sizeof(shape));
+		put(&c, p->P, dim * sizeof(scs_int));
+		put(&c, p->Parent, dim * sizeof(scs_int));
+		put(&c, p->Lnz, dim * sizeof(scs_int));
+		put(&c, p->D, dim * sizeof(scs_float));
+		if (F) {
+			put(&c, F->super, (F->nsuper + 1) * sizeof(scs_int));
+			put(&c, F->colSuper, dim * sizeof(scs_int));
+			put(&c, F->rowp, (F->nsuper + 1) * sizeof(scs_int));
+			put(&c, F->rows, shape[7] * sizeof(scs_int));
+			put(&c, F->xp, (F->nsuper + 1) * sizeof(scs_int));
+			put(&c, F->x, shape[8] * sizeof(scs_float));
+		} else {
+			put(&c, p->L->p, (dim + 1) * sizeof(scs_int));
+			put(&c, p->L->i, shape[3] * sizeof(scs_int));
+			put(&c, p->L->x, shape[3] * sizeof(scs_float));
+		}
+		sum = c.sum;
+		put(&c, &sum, sizeof(sum));
+		if (fclose(c.f) != 0) {
+			c.ok = 0;
+		}
+	}
+	if (!c.ok || rename(tmp, path) != 0) {
+		remove(tmp);
+		c.ok = 0;
+	}
+	scs_free(tmp);
+	scs_free(path);
+	return c.ok ? 0 : -1;
+}
@@ -0,0 +1,18 @@
+#ifndef FACTOR_CACHE_H_GUARD
+#define FACTOR_CACHE_H_GUARD
+
+#include "private.h"
+
+/* version of the layout of the cache files, files of other versions are ignored */
+#define FACTOR_CACHE_VERSION (1)
+
+/* on-disk cache of the factorization of initPriv in the directory stgs->factor_cache, one file per problem, named by
+ * a hash of A (normalized), rho_x, the normalization and the settings the factorization depends on. the file holds
+ * them too, so a hash collision is a miss, and a checksum of its contents.
+ * loadFactorCache fills in P, Parent, Lnz, D and L or super of p (not the schedules), returns -1 and leaves p as it
+ * was if there is no valid file for this problem */
+scs_int loadFactorCache(const AMatrix * A, const Settings * stgs, Priv * p);
+/* writes the factorization of p to the cache (through a temporary file, renamed), returns -1 if that fails */
+scs_int saveFactorCache(const AMatrix * A, const Settings * stgs, const Priv * p);
+
+#endif
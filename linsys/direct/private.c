@@ -1,7 +1,13 @@
 #include "private.h"
+#include "factorCache.h"
+#include "ctrlc.h"
 
-static timer linsysTimer;
-static scs_float totalSolveTime;
+#ifdef OPENMP
+#include <omp.h>
+#endif
+
+/* max number of right-hand sides solved together in one pass over L */
+#define BATCH_BLOCK SUPER_BATCH_MAX
 
 char * getLinSysMethod(const AMatrix * A, const Settings * s) {
 	char * tmp = scs_malloc(sizeof(char) * 128);
@@ -11,13 +17,25 @@ char * getLinSysMethod(const AMatrix * A, const Settings * s) {
 
 char * getLinSysSummary(Priv * p, const Info * info) {
 	char * str = scs_malloc(sizeof(char) * 128);
-	scs_int n = p->L->n;
-	sprintf(str, "\tLin-sys: nnz in L factor: %li, avg solve time: %1.2es\n", (long) (p->L->p[n] + n),
-			totalSolveTime / (info->iter + 1) / 1e3);
-	totalSolveTime = 0;
+	sprintf(str, "\tLin-sys: nnz in L factor: %li%s%s%s, avg solve time: %1.2es\n", (long) info->nnzL,
+			p->normal ? " (normal equations)" : "", p->super ? " (supernodal)" : "",
+			p->factorCache == 1 ? " (cached)" : "", info->linSysTime / (info->iter + 1) / 1e3);
 	return str;
 }
 
+void getLinSysInfo(Priv * p, Info * info) {
+	scs_int n = p->L->n;
+	info->linSysTime = p->totalSolveTime;
+	info->spmvTime = p->totalSpmvTime;
+	info->cgIters = 0;
+	info->orderingTime = p->orderingTime;
+	info->factorTime = p->factorTime;
+	info->nnzL = (p->super ? p->super->nnz : p->L->p[n]) + n;
+	info->factorCacheHit = p->factorCache;
+	p->totalSolveTime = 0;
+	p->totalSpmvTime = 0;
+}
+
 void freePriv(Priv * p) {
 	if (p) {
 		if (p->L)
@@ -26,8 +44,25 @@ void freePriv(Priv * p) {
 			scs_free(p->P);
 		if (p->D)
 			scs_free(p->D);
+		if (p->Parent)
+			scs_free(p->Parent);
+		if (p->Lnz)
+			scs_free(p->Lnz);
 		if (p->bp)
 			scs_free(p->bp);
+		if (p->Lxs)
+			scs_free(p->Lxs);
+		if (p->Ds)
+			scs_free(p->Ds);
+		if (p->bps)
+			scs_free(p->bps);
+		if (p->bpBatch)
+			scs_free(p->bpBatch);
+		if (p->super)
+			superFree(p->super);
+		if (p->superWork)
+			scs_free(p->superWork);
+		freeSchedule(p->sched);
 		scs_free(p);
 	}
 }
@@ -83,6 +118,91 @@ cs * formKKT(const AMatrix * A, const Settings * s) {
 	return (K_cs);
 }
 
+/* upper triangular part of the normal equations rho_x I + A'A, column compressed. the entries are those of the
+ * pattern of A'A, zero or not, so the same for any values of A. column j accumulates the rows of A in column j, in
+ * order, from the row-wise copy of A (columns ascending) */
+static cs * formNormal(const AMatrix * A, const Settings * s) {
+	scs_int i, j, k, q, r, nz, n = A->n, m = A->m, Anz = A->p[A->n];
+	scs_int *Rp = scs_calloc(m + 1, sizeof(scs_int)), *Rj = scs_malloc(MAX(Anz, 1) * sizeof(scs_int));
+	scs_int *Mark = scs_malloc(MAX(n, 1) * sizeof(scs_int));
+	scs_float *Rx = scs_malloc(MAX(Anz, 1) * sizeof(scs_float)), *acc = scs_calloc(MAX(n, 1), sizeof(scs_float));
+	cs * N = SCS_NULL;
+	if (Rp && Rj && Mark && Rx && acc) {
+		/* A row-wise */
+		for (k = 0; k < Anz; ++k) {
+			Rp[A->i[k] + 1]++;
+		}
+		for (r = 0; r < m; ++r) {
+			Rp[r + 1] += Rp[r];
+		}
+		for (j = 0; j < n; ++j) {
+			for (k = A->p[j]; k < A->p[j + 1]; ++k) {
+				q = Rp[A->i[k]]++;
+				Rj[q] = j;
+				Rx[q] = A->x[k];
+			}
+		}
+		for (r = m; r > 0; --r) {
+			Rp[r] = Rp[r - 1];
+		}
+		Rp[0] = 0;
+		/* pattern size, then the pattern and the values, diagonal first */
+		for (j = 0; j < n; ++j) {
+			Mark[j] = -1;
+		}
+		for (nz = 0, j = 0; j < n; ++j) {
+			Mark[j] = j;
+			nz++;
+			for (k = A->p[j]; k < A->p[j + 1]; ++k) {
+				for (q = Rp[A->i[k]]; q < Rp[A->i[k] + 1] && Rj[q] < j; ++q) {
+					if (Mark[Rj[q]] != j) {
+						Mark[Rj[q]] = j;
+						nz++;
+					}
+				}
+			}
+		}
+		N = cs_spalloc(n, n, nz, 1, 0);
+	}
+	if (N) {
+		for (j = 0; j < n; ++j) {
+			Mark[j] = -1;
+		}
+		for (nz = 0, j = 0; j < n; ++j) {
+			N->p[j] = nz;
+			N->i[nz++] = j;
+			Mark[j] = j;
+			acc[j] = s->rho_x;
+			for (k = A->p[j]; k < A->p[j + 1]; ++k) {
+				for (q = Rp[A->i[k]]; q < Rp[A->i[k] + 1] && Rj[q] <= j; ++q) {
+					i = Rj[q];
+					if (Mark[i] != j) {
+						Mark[i] = j;
+						N->i[nz++] = i;
+					}
+					acc[i] += A->x[k] * Rx[q];
+				}
+			}
+			for (q = N->p[j]; q < nz; ++q) {
+				N->x[q] = acc[N->i[q]];
+				acc[N->i[q]] = 0.0;
+			}
+		}
+		N->p[n] = nz;
+	}
+	if (Rp)
+		scs_free(Rp);
+	if (Rj)
+		scs_free(Rj);
+	if (Mark)
+		scs_free(Mark);
+	if (Rx)
+		scs_free(Rx);
+	if (acc)
+		scs_free(acc);
+	return N;
+}
+
 scs_int LDLInit(cs * A, scs_int P[], scs_float **info) {
 	*info = (scs_float *) scs_malloc(AMD_INFO * sizeof(scs_float));
 #ifdef DLONG
@@ -92,80 +212,475 @@ scs_int LDLInit(cs * A, scs_int P[], scs_float **info) {
 #endif
 }
 
-scs_int LDLFactor(cs * A, scs_int P[], scs_int Pinv[], cs **L, scs_float **D) {
-	scs_int kk, n = A->n;
-	scs_int * Parent = scs_malloc(n * sizeof(scs_int));
-	scs_int * Lnz = scs_malloc(n * sizeof(scs_int));
-	scs_int * Flag = scs_malloc(n * sizeof(scs_int));
-	scs_int * Pattern = scs_malloc(n * sizeof(scs_int));
-	scs_float * Y = scs_malloc(n * sizeof(scs_float));
-	(*L)->p = (scs_int *) scs_malloc((1 + n) * sizeof(scs_int));
+/* the normal equations rho_x I + A'A, with their AMD ordering written to P, if they are cheaper to solve with than
+ * the KKT matrix with AMD statistics info, otherwise SCS_NULL. a solve takes each column of the factor, with its
+ * diagonal, twice, with the normal equations A and A' once more each, so their factor plus A must be no larger than
+ * the factor of the KKT matrix. forming and factoring them is done once, at most twice the work of the KKT matrix.
+ * rows of A with c nonzeros cost c (c + 1) / 2 to form and give at least c (c - 1) / 2 entries, a dense row makes
+ * them dense, so that is checked first */
+static cs * normalEquations(const AMatrix * A, const Settings * stgs, const scs_float * info, scs_int * P) {
+	scs_int r, k, Anz = A->p[A->n], *cnt = scs_calloc(A->m, sizeof(scs_int));
+	scs_int *Pn = SCS_NULL;
+	scs_float formWork = 0, maxRowNz = 0, lnzKKT, *infoN = SCS_NULL;
+	cs * N = SCS_NULL;
+	if (!cnt) {
+		return SCS_NULL;
+	}
+	for (k = 0; k < Anz; ++k) {
+		cnt[A->i[k]]++;
+	}
+	for (r = 0; r < A->m; ++r) {
+		formWork += (scs_float) cnt[r] * (cnt[r] + 1) / 2;
+		maxRowNz = MAX(maxRowNz, (scs_float) cnt[r] * (cnt[r] - 1) / 2);
+	}
+	scs_free(cnt);
+	lnzKKT = info[AMD_LNZ] + A->n + A->m;
+	if (maxRowNz + A->n + Anz > lnzKKT || formWork > 2 * info[AMD_NMULTSUBS_LDL]) {
+		return SCS_NULL;
+	}
+	N = formNormal(A, stgs);
+	Pn = scs_malloc(MAX(A->n, 1) * sizeof(scs_int));
+	if (N && Pn && LDLInit(N, Pn, &infoN) >= 0 && infoN[AMD_LNZ] + A->n + Anz <= lnzKKT
+			&& formWork + infoN[AMD_NMULTSUBS_LDL] <= 2 * info[AMD_NMULTSUBS_LDL]) {
+		memcpy(P, Pn, A->n * sizeof(scs_int));
+	} else if (N) {
+		cs_spfree(N);
+		N = SCS_NULL;
+	}
+	if (infoN)
+		scs_free(infoN);
+	if (Pn)
+		scs_free(Pn);
+	return N;
+}
 
-	/*scs_int Parent[n], Lnz[n], Flag[n], Pattern[n]; */
-	/*scs_float Y[n]; */
+/* row k of L and D[k] as in LDL_numeric (up-looking, a sparse triangular solve with the columns of L before it), the
+ * columns of the rows in its subtree already done. Y is zero and Flag not k on entry. returns -1 on a zero pivot */
+static scs_int LDLNumericRow(const cs * C, cs * L, scs_float * D, const scs_int * Parent, scs_int * Lnz, scs_int k,
+		scs_float * Y, scs_int * Pattern, scs_int * Flag) {
+	scs_int i, p, p2, len, top = C->n, *Lp = L->p, *Li = L->i;
+	scs_float yi, lki, *Lx = L->x;
+	Flag[k] = k;
+	Lnz[k] = 0;
+	/* nonzero pattern of row k of L, in topological order */
+	for (p = C->p[k]; p < C->p[k + 1]; ++p) {
+		i = C->i[p];
+		if (i <= k) {
+			Y[i] += C->x[p];
+			for (len = 0; Flag[i] != k; i = Parent[i]) {
+				Pattern[len++] = i;
+				Flag[i] = k;
+			}
+			while (len > 0) {
+				Pattern[--top] = Pattern[--len];
+			}
+		}
+	}
+	D[k] = Y[k];
+	Y[k] = 0.0;
+	for (; top < C->n; ++top) {
+		i = Pattern[top];
+		yi = Y[i];
+		Y[i] = 0.0;
+		p2 = Lp[i] + Lnz[i];
+		for (p = Lp[i]; p < p2; ++p) {
+			Y[Li[p]] -= Lx[p] * yi;
+		}
+		lki = yi / D[i];
+		D[k] -= lki * yi;
+		Li[p] = k;
+		Lx[p] = lki;
+		Lnz[i]++;
+	}
+	return D[k] == 0.0 ? -1 : 0;
+}
 
-	LDL_symbolic(n, A->p, A->i, (*L)->p, Parent, Lnz, Flag, P, Pinv);
+/* numeric factorization of the permuted KKT matrix C into L and D, with the symbolic analysis (Parent, Lnz, L->p) and
+ * the schedule. the rows of the tasks only reach into columns of their own subtrees, so the tasks run in parallel, then
+ * the top rows. every entry gets the same operations in the same order as in LDL_numeric, on any number of threads */
+static scs_int LDLNumeric(const cs * C, Priv * p) {
+	scs_int k, t, n = C->n, failures = 0;
+	const TreeSchedule * S = p->sched;
+	scs_float * Y = scs_calloc(MAX(n, 1) * S->nthreads, sizeof(scs_float));
+	scs_int * Pattern = scs_malloc(MAX(n, 1) * S->nthreads * sizeof(scs_int));
+	scs_int * Flag = scs_malloc(MAX(n, 1) * S->nthreads * sizeof(scs_int));
+	if (!Y || !Pattern || !Flag) {
+		failures = 1;
+	}
+	for (k = 0; k < n * S->nthreads && !failures; ++k) {
+		Flag[k] = -1;
+	}
+#ifdef OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(S->nthreads) private(k) reduction(+:failures) \
+	if (S->ntasks > 1)
+#endif
+	for (t = 0; t < S->ntasks; ++t) {
+		scs_int thread = 0;
+#ifdef OPENMP
+		thread = omp_get_thread_num();
+#endif
+		for (k = S->first[t]; k <= S->last[t] && !failures; ++k) {
+			if (isInterrupted() || LDLNumericRow(C, p->L, p->D, p->Parent, p->Lnz, k, &(Y[thread * n]),
+					&(Pattern[thread * n]), &(Flag[thread * n])) < 0) {
+				failures++;
+			}
+		}
+	}
+	for (k = 0; k < S->ntop && !failures; ++k) {
+		if (isInterrupted() || LDLNumericRow(C, p->L, p->D, p->Parent, p->Lnz, S->top[k], Y, Pattern, Flag) < 0) {
+			failures++;
+		}
+	}
+	if (Y)
+		scs_free(Y);
+	if (Pattern)
+		scs_free(Pattern);
+	if (Flag)
+		scs_free(Flag);
+	return failures ? -1 : 0;
+}
 
-	(*L)->nzmax = *((*L)->p + n);
-	(*L)->x = (scs_float *) scs_malloc((*L)->nzmax * sizeof(scs_float));
-	(*L)->i = (scs_int *) scs_malloc((*L)->nzmax * sizeof(scs_int));
-	*D = (scs_float *) scs_malloc(n * sizeof(scs_float));
+/* solves PLDL'P' x = b for x, in place in b, with the permutation and the diagonal fused into the two sweeps over L.
+ * the tasks of the schedule run in parallel: in the forward solve a task updates the rows of its own subtrees and the
+ * columns' entries in the top rows are applied afterwards in column order, the backward solve reads the top rows,
+ * solved first. so every entry of x gets the same operations in the same order as in one pass over the columns */
+static void LDLSolve(scs_float * b, Priv * p) {
+	scs_int j, k, t, *Lp = p->L->p, *Li = p->L->i, *P = p->P;
+	scs_float xj, *Lx = p->L->x, *D = p->D, *x = p->bp;
+	const TreeSchedule * S = p->sched;
+	/* L x = P' b, the tasks */
+#ifdef OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(S->nthreads) private(j, k, xj) if (S->ntasks > 1)
+#endif
+	for (t = 0; t < S->ntasks; ++t) {
+		for (j = S->first[t]; j <= S->last[t]; ++j) {
+			x[j] = b[P[j]];
+		}
+		for (j = S->first[t]; j <= S->last[t]; ++j) {
+			xj = x[j];
+			for (k = Lp[j]; k < S->split[j]; ++k) {
+				x[Li[k]] -= Lx[k] * xj;
+			}
+		}
+	}
+	/* the top rows */
+	for (t = 0; t < S->ntop; ++t) {
+		x[S->top[t]] = b[P[S->top[t]]];
+	}
+	for (t = 0; t < S->nsweep; ++t) {
+		j = S->sweep[t];
+		xj = x[j];
+		for (k = S->split[j]; k < Lp[j + 1]; ++k) {
+			x[Li[k]] -= Lx[k] * xj;
+		}
+	}
+	/* L' x = D^-1 x, the top rows, then the tasks */
+	for (t = S->ntop - 1; t >= 0; --t) {
+		j = S->top[t];
+		xj = x[j] / D[j];
+		for (k = Lp[j]; k < Lp[j + 1]; ++k) {
+			xj -= Lx[k] * x[Li[k]];
+		}
+		x[j] = b[P[j]] = xj;
+	}
+#ifdef OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(S->nthreads) private(j, k, xj) if (S->ntasks > 1)
+#endif
+	for (t = 0; t < S->ntasks; ++t) {
+		for (j = S->last[t]; j >= S->first[t]; --j) {
+			xj = x[j] / D[j];
+			for (k = Lp[j]; k < Lp[j + 1]; ++k) {
+				xj -= Lx[k] * x[Li[k]];
+			}
+			x[j] = b[P[j]] = xj;
+		}
+	}
+}
 
-	if (!(*D) || !(*L)->i || !(*L)->x || !Y || !Pattern || !Flag || !Lnz || !Parent)
+/* the schedule of the column factorization and solves over the elimination tree Parent for nthreads threads */
+static scs_int LDLSchedule(Priv * p, scs_int nthreads) {
+	scs_int j, n = p->L->n, *work = scs_malloc(MAX(n, 1) * sizeof(scs_int));
+	if (!work) {
 		return -1;
+	}
+	/* the solve work of the columns, it balances the factorization well enough */
+	for (j = 0; j < n; ++j) {
+		work[j] = p->Lnz[j] + 1;
+	}
+	p->sched = treeSchedule(n, p->Parent, work, nthreads);
+	scs_free(work);
+	return p->sched ? 0 : -1;
+}
 
-#if EXTRAVERBOSE > 0
-	scs_printf("numeric factorization\n");
-#endif
-	kk = LDL_numeric(n, A->p, A->i, A->x, (*L)->p, Parent, Lnz, (*L)->i, (*L)->x, *D, Y, Pattern, Flag, P, Pinv);
-#if EXTRAVERBOSE > 0
-	scs_printf("finished numeric factorization\n");
-#endif
+/* where the columns' entries in top rows start, once L is filled in */
+static scs_int LDLSplit(Priv * p) {
+	scs_int j, k, lim, n = p->L->n, *Lp = p->L->p, *Li = p->L->i;
+	TreeSchedule * S = p->sched;
+	S->split = scs_malloc(MAX(n, 1) * sizeof(scs_int));
+	S->sweep = scs_malloc(MAX(n, 1) * sizeof(scs_int));
+	if (!S->split || !S->sweep) {
+		return -1;
+	}
+	/* the rows of a column are sorted, those of its task first, then the top ones (ancestors of the task's subtrees) */
+	for (j = 0; j < n; ++j) {
+		S->split[j] = Lp[j];
+		if (S->taskOf[j] >= 0) {
+			lim = S->last[S->taskOf[j]];
+			for (k = Lp[j]; k < Lp[j + 1] && Li[k] <= lim; ++k) {
+			}
+			S->split[j] = k;
+		}
+		if (S->taskOf[j] < 0 || S->split[j] < Lp[j + 1]) {
+			S->sweep[S->nsweep++] = j;
+		}
+	}
+	return 0;
+}
 
-	scs_free(Parent);
-	scs_free(Lnz);
-	scs_free(Flag);
-	scs_free(Pattern);
-	scs_free(Y);
-	return (kk - n);
-}
-
-void LDLSolve(scs_float *x, scs_float b[], cs * L, scs_float D[], scs_int P[], scs_float * bp) {
-	/* solves PLDL'P' x = b for x */
-	scs_int n = L->n;
-	if (P == SCS_NULL) {
-		if (x != b) /* if they're different addresses */
-			memcpy(x, b, n * sizeof(scs_float));
-		LDL_lsolve(n, x, L->p, L->i, L->x);
-		LDL_dsolve(n, x, D);
-		LDL_ltsolve(n, x, L->p, L->i, L->x);
-	} else {
-		LDL_perm(n, bp, b, P);
-		LDL_lsolve(n, bp, L->p, L->i, L->x);
-		LDL_dsolve(n, bp, D);
-		LDL_ltsolve(n, bp, L->p, L->i, L->x);
-		LDL_permt(n, x, bp, P);
+/* column factorization of the postordered C: L from the column counts Lnz, the schedule over the elimination tree
+ * Parent for nthreads threads, the numeric factorization, then where the columns' entries in top rows start */
+static scs_int LDLFactor(const cs * C, Priv * p, scs_int nthreads) {
+	scs_int j, n = C->n;
+	cs * L = p->L;
+	L->p = scs_malloc((n + 1) * sizeof(scs_int));
+	p->D = scs_malloc(MAX(n, 1) * sizeof(scs_float));
+	if (!L->p || !p->D) {
+		return -1;
+	}
+	L->p[0] = 0;
+	for (j = 0; j < n; ++j) {
+		L->p[j + 1] = L->p[j] + p->Lnz[j];
+	}
+	L->nzmax = L->p[n];
+	L->i = scs_malloc(MAX(L->nzmax, 1) * sizeof(scs_int));
+	L->x = scs_malloc(MAX(L->nzmax, 1) * sizeof(scs_float));
+	if (!L->i || !L->x || LDLSchedule(p, nthreads) < 0 || LDLNumeric(C, p) < 0) {
+		return -1;
+	}
+	return LDLSplit(p);
+}
+
+/* LDLSolve with the single precision copy Lx, D of the factorization, all arithmetic in single precision */
+static void LDLSolveSingle(scs_float *x, scs_float b[], cs * L, float * Lx, float * D, scs_int P[], float * X) {
+	scs_int j, k, n = L->n, *Lp = L->p, *Li = L->i;
+	float xj;
+	for (j = 0; j < n; ++j) {
+		X[j] = (float) b[P[j]];
+	}
+	/* L x = b */
+	for (j = 0; j < n; ++j) {
+		xj = X[j];
+		for (k = Lp[j]; k < Lp[j + 1]; ++k) {
+			X[Li[k]] -= Lx[k] * xj;
+		}
+	}
+	/* D x = b */
+	for (j = 0; j < n; ++j) {
+		X[j] /= D[j];
+	}
+	/* L' x = b */
+	for (j = n - 1; j >= 0; --j) {
+		xj = X[j];
+		for (k = Lp[j]; k < Lp[j + 1]; ++k) {
+			xj -= Lx[k] * X[Li[k]];
+		}
+		X[j] = xj;
+	}
+	for (j = 0; j < n; ++j) {
+		x[P[j]] = X[j];
+	}
+}
+
+/* solves PLDL'P' x = b[r] for nrhs <= BATCH_BLOCK right-hand sides, results stored in b[r].
+ * X holds the permuted right-hand sides interleaved (entry j of rhs r at X[j * ns + r]) so each entry of L is loaded
+ * once for all of them. the stride ns is nrhs rounded up to a multiple of 2, the padding is zero and stays zero, so the
+ * inner loops have a fixed trip count. same operations in the same order as LDLSolve for each right-hand side. */
+static void LDLSolveBatch(scs_float ** b, scs_int nrhs, cs * L, scs_float D[], scs_int P[], scs_float * X) {
+	scs_int j, k, r, n = L->n, ns = (nrhs + 1) / 2 * 2, *Lp = L->p, *Li = L->i;
+	scs_float *Lx = L->x, *xj, *xi, lij, xr[BATCH_BLOCK];
+	for (j = 0; j < n; ++j) {
+		for (r = 0; r < nrhs; ++r) {
+			X[j * ns + r] = b[r][P[j]];
+		}
+		for (r = nrhs; r < ns; ++r) {
+			X[j * ns + r] = 0;
+		}
+	}
+	/* L x = b */
+	for (j = 0; j < n; ++j) {
+		xj = &(X[j * ns]);
+		for (r = 0; r < ns; ++r) {
+			xr[r] = xj[r];
+		}
+		for (k = Lp[j]; k < Lp[j + 1]; ++k) {
+			xi = &(X[Li[k] * ns]);
+			lij = Lx[k];
+			for (r = 0; r < ns; r += 2) {
+				xi[r] -= lij * xr[r];
+				xi[r + 1] -= lij * xr[r + 1];
+			}
+		}
+	}
+	/* D x = b */
+	for (j = 0; j < n; ++j) {
+		xj = &(X[j * ns]);
+		for (r = 0; r < ns; ++r) {
+			xj[r] /= D[j];
+		}
+	}
+	/* L' x = b */
+	for (j = n - 1; j >= 0; --j) {
+		xj = &(X[j * ns]);
+		for (r = 0; r < ns; ++r) {
+			xr[r] = xj[r];
+		}
+		for (k = Lp[j]; k < Lp[j + 1]; ++k) {
+			xi = &(X[Li[k] * ns]);
+			lij = Lx[k];
+			for (r = 0; r < ns; r += 2) {
+				xr[r] -= lij * xi[r];
+				xr[r + 1] -= lij * xi[r + 1];
+			}
+		}
+		for (r = 0; r < ns; ++r) {
+			xj[r] = xr[r];
+		}
+	}
+	for (j = 0; j < n; ++j) {
+		for (r = 0; r < nrhs; ++r) {
+			b[r][P[j]] = X[j * ns + r];
+		}
+	}
+}
+
+/* LDLSolveBatch with the supernodal factorization, same layout of the right-hand sides in bpBatch */
+static void superSolveBatchPerm(scs_float ** b, scs_int nrhs, Priv * p) {
+	scs_int j, r, n = p->L->n, ns = (nrhs + 1) / 2 * 2, *P = p->P;
+	scs_float * X = p->bpBatch;
+	for (j = 0; j < n; ++j) {
+		for (r = 0; r < nrhs; ++r) {
+			X[j * ns + r] = b[r][P[j]];
+		}
+		for (r = nrhs; r < ns; ++r) {
+			X[j * ns + r] = 0;
+		}
+	}
+	superSolveBatch(p->super, p->D, p->superWork, X, ns);
+	for (j = 0; j < n; ++j) {
+		for (r = 0; r < nrhs; ++r) {
+			b[r][P[j]] = X[j * ns + r];
+		}
 	}
 }
 
 void accumByAtrans(const AMatrix * A, Priv * p, const scs_float *x, scs_float *y) {
+	timer spmvTimer;
+	tic(&spmvTimer);
 	_accumByAtrans(A->n, A->x, A->i, A->p, x, y);
+	p->totalSpmvTime += tocq(&spmvTimer);
 }
 
 void accumByA(const AMatrix * A, Priv * p, const scs_float *x, scs_float *y) {
+	timer spmvTimer;
+	tic(&spmvTimer);
 	_accumByA(A->n, A->x, A->i, A->p, x, y);
+	p->totalSpmvTime += tocq(&spmvTimer);
+}
+
+/* composes the AMD ordering P with the postorder of its elimination tree, so the columns of each subtree, and so of
+ * each supernode and each task of the solves, are contiguous (same fill), returns K permuted by it */
+static cs * postorderedKKT(const cs * K, Priv * p) {
+	scs_int k, n = K->n;
+	scs_int *Pinv, *post = scs_malloc(n * sizeof(scs_int)), *Pp = scs_malloc(n * sizeof(scs_int));
+	scs_int *Lp = scs_malloc((n + 1) * sizeof(scs_int)), *Flag = scs_malloc(n * sizeof(scs_int));
+	cs * C = SCS_NULL;
+	if (post && Pp && Lp && Flag) {
+		Pinv = cs_pinv(p->P, n);
+		C = cs_symperm(K, Pinv, 1);
+		scs_free(Pinv);
+	}
+	if (C) {
+		LDL_symbolic(n, C->p, C->i, Lp, p->Parent, p->Lnz, Flag, SCS_NULL, SCS_NULL);
+		superPostorder(n, p->Parent, post);
+		for (k = 0; k < n; ++k) {
+			Pp[k] = p->P[post[k]];
+		}
+		memcpy(p->P, Pp, n * sizeof(scs_int));
+		cs_spfree(C);
+		Pinv = cs_pinv(p->P, n);
+		C = cs_symperm(K, Pinv, 1);
+		scs_free(Pinv);
+	}
+	if (C) {
+		LDL_symbolic(n, C->p, C->i, Lp, p->Parent, p->Lnz, Flag, SCS_NULL, SCS_NULL);
+	}
+	if (post)
+		scs_free(post);
+	if (Pp)
+		scs_free(Pp);
+	if (Lp)
+		scs_free(Lp);
+	if (Flag)
+		scs_free(Flag);
+	return C;
+}
+
+/* the schedule of the supernodal factorization and solves for nthreads threads, and their workspace */
+static scs_int superPrepare(Priv * p, scs_int nthreads) {
+	if (superSchedule(p->super, nthreads) < 0) {
+		return -1;
+	}
+	/* sized for the multiple right-hand side solves */
+	p->superWork = scs_malloc(MAX(p->super->maxRows, 1) * MAX(BATCH_BLOCK, nthreads) * sizeof(scs_float));
+	return p->superWork ? 0 : -1;
+}
+
+/* supernodal factorization of the postordered C */
+static scs_int superFactorize(const cs * C, Priv * p, scs_int nthreads) {
+	scs_int n = C->n;
+	p->D = scs_malloc(n * sizeof(scs_float));
+	p->super = superSymbolic(C, p->Parent, p->Lnz);
+	if (!p->D || !p->super || superPrepare(p, nthreads) < 0) {
+		return -1;
+	}
+	return superNumeric(C, p->super, p->D);
+}
+
+/* threads of the factorization and solve schedules (tree_parallel), more than the processors only slow them down */
+static scs_int maxThreads(const Settings * stgs) {
+#ifdef OPENMP
+	return stgs->tree_parallel ? MIN(omp_get_max_threads(), omp_get_num_procs()) : 1;
+#else
+	return 1;
+#endif
 }
 
 scs_int factorize(const AMatrix * A, const Settings * stgs, Priv * p) {
 	scs_float *info;
-	scs_int *Pinv, amd_status, ldl_status;
-	cs *C, *K = formKKT(A, stgs);
+	scs_int amd_status, ldl_status, nthreads;
+	timer factorTimer;
+	cs *C, *N = SCS_NULL, *K = formKKT(A, stgs);
 	if (!K) {
 		return -1;
 	}
+	nthreads = maxThreads(stgs);
+	tic(&factorTimer);
 	amd_status = LDLInit(K, p->P, &info);
-	if (amd_status < 0)
+	if (amd_status >= 0 && stgs->normal_equations) {
+		N = normalEquations(A, stgs, info, p->P);
+	}
+	p->orderingTime = tocq(&factorTimer);
+	if (amd_status < 0) {
+		cs_spfree(K);
+		scs_free(info);
 		return (amd_status);
+	}
+	if (N) {
+		cs_spfree(K);
+		K = N;
+		p->normal = 1;
+		p->L->m = p->L->n = K->n;
+	}
 #if EXTRAVERBOSE > 0
 	if(stgs->verbose) {
 		scs_printf("Matrix factorization info:\n");
@@ -176,43 +691,211 @@ scs_int factorize(const AMatrix * A, const Settings * stgs, Priv * p) {
 #endif
 	}
 #endif
-	Pinv = cs_pinv(p->P, A->n + A->m);
+	tic(&factorTimer);
+	C = postorderedKKT(K, p);
+	if (!C) {
+		ldl_status = -1;
+	} else if (stgs->supernodal && superWorthwhile(C->n, p->Lnz)) {
+		ldl_status = superFactorize(C, p, nthreads);
+	} else {
+		ldl_status = LDLFactor(C, p, nthreads);
+	}
+	p->factorTime = tocq(&factorTimer);
+	if (C)
+		cs_spfree(C);
+	cs_spfree(K);
+	scs_free(info);
+	return (ldl_status);
+}
+
+/* entries of L in the single precision copy */
+static scs_int singleFactorSize(const Priv * p) {
+	return p->super ? p->super->xp[p->super->nsuper] : p->L->p[p->L->n];
+}
+
+/* rounds the factorization to the single precision copy */
+static void demoteFactor(Priv * p) {
+	scs_int j, n = p->L->n, nz = singleFactorSize(p);
+	const scs_float * Lx = p->super ? p->super->x : p->L->x;
+	for (j = 0; j < nz; ++j) {
+		p->Lxs[j] = (float) Lx[j];
+	}
+	for (j = 0; j < n; ++j) {
+		p->Ds[j] = (float) p->D[j];
+	}
+}
+
+scs_int setLinSysPrecision(const AMatrix * A, Priv * p, scs_int single) {
+	scs_int n = p->L->n, nbps = n;
+	const SuperFactor * F = p->super;
+	if (F) {
+		/* and the supernodal solve's workspace for each thread and for the top rows */
+		nbps += F->maxRows * F->sched->nthreads + F->sched->bufp[F->nsuper];
+	}
+	if (single && !p->Lxs) {
+		p->Lxs = scs_malloc(MAX(singleFactorSize(p), 1) * sizeof(float));
+		p->Ds = scs_malloc(n * sizeof(float));
+		p->bps = scs_malloc(MAX(nbps, 1) * sizeof(float));
+		if (!p->Lxs || !p->Ds || !p->bps) {
+			return -1;
+		}
+		demoteFactor(p);
+	}
+	p->single = single;
+	return 0;
+}
+
+/* A values or rho_x changed, same sparsity pattern: keep AMD ordering and symbolic factorization */
+scs_int updateLinSys(const AMatrix * A, const Settings * stgs, Priv * p) {
+	scs_int *Pinv, ldl_status;
+	timer factorTimer;
+	cs *C, *K;
+	tic(&factorTimer);
+	K = p->normal ? formNormal(A, stgs) : formKKT(A, stgs);
+	if (!K) {
+		return -1;
+	}
+	Pinv = cs_pinv(p->P, p->L->n);
 	C = cs_symperm(K, Pinv, 1);
-	ldl_status = LDLFactor(C, SCS_NULL, SCS_NULL, &p->L, &p->D);
+	if (p->super) {
+		ldl_status = (C && Pinv) ? superNumeric(C, p->super, p->D) : -1;
+		/* the column compressed copy, if the solves have made one */
+		if (ldl_status >= 0 && p->L->p) {
+			superToCsc(p->super, p->L);
+		}
+	} else {
+		ldl_status = (C && Pinv) ? LDLNumeric(C, p) : -1;
+	}
+	if (ldl_status >= 0 && p->Lxs) {
+		demoteFactor(p);
+	}
+	p->factorTime += tocq(&factorTimer);
 	cs_spfree(C);
 	cs_spfree(K);
 	scs_free(Pinv);
-	scs_free(info);
 	return (ldl_status);
 }
 
+/* with the normal equations the KKT system [rho_x I A'; A -I] [x; y] = [b_x; b_y] is solved as
+ * (rho_x I + A'A) x = b_x + A' b_y, then y = A x - b_y, in place in b */
+static void normalRhs(const AMatrix * A, scs_float * b) {
+	_accumByAtrans(A->n, A->x, A->i, A->p, &(b[A->n]), b);
+}
+
+static void normalSol(const AMatrix * A, scs_float * b) {
+	scaleArray(&(b[A->n]), -1.0, A->m);
+	_accumByA(A->n, A->x, A->i, A->p, b, &(b[A->n]));
+}
+
+/* the factorization from the factor_cache directory and its schedules, in place of factorize, -1 on a miss */
+static scs_int loadCachedFactor(const AMatrix * A, const Settings * stgs, Priv * p) {
+	scs_int status, nthreads = maxThreads(stgs);
+	timer factorTimer;
+	tic(&factorTimer);
+	if (loadFactorCache(A, stgs, p) < 0) {
+		return -1;
+	}
+	if (p->super) {
+		status = superPrepare(p, nthreads);
+	} else {
+		status = LDLSchedule(p, nthreads) < 0 ? -1 : LDLSplit(p);
+	}
+	p->factorTime = tocq(&factorTimer);
+	return status;
+}
+
 Priv * initPriv(const AMatrix * A, const Settings * stgs) {
 	Priv * p = scs_calloc(1, sizeof(Priv));
 	scs_int n_plus_m = A->n + A->m;
 	p->P = scs_malloc(sizeof(scs_int) * n_plus_m);
-	p->L = scs_malloc(sizeof(cs));
+	p->L = scs_calloc(1, sizeof(cs));
 	p->bp = scs_malloc(n_plus_m * sizeof(scs_float));
+	p->Parent = scs_malloc(n_plus_m * sizeof(scs_int));
+	p->Lnz = scs_malloc(n_plus_m * sizeof(scs_int));
 	p->L->m = n_plus_m;
 	p->L->n = n_plus_m;
 	p->L->nz = -1;
+	p->factorCache = -1;
 
-	if (factorize(A, stgs, p) < 0) {
+	if (stgs->factor_cache && loadCachedFactor(A, stgs, p) == 0) {
+		p->factorCache = 1;
+	} else if (factorize(A, stgs, p) < 0) {
 		freePriv(p);
 		return SCS_NULL;
+	} else if (stgs->factor_cache) {
+		/* a cache that cannot be written is only slower */
+		p->factorCache = 0;
+		saveFactorCache(A, stgs, p);
 	}
-	totalSolveTime = 0.0;
+	p->totalSolveTime = 0.0;
+	p->totalSpmvTime = 0.0;
 	return p;
 }
 
 scs_int solveLinSys(const AMatrix * A, const Settings * stgs, Priv * p, scs_float * b, const scs_float * s, scs_int iter) {
 	/* returns solution to linear system */
 	/* Ax = b with solution stored in b */
+	const SuperFactor * F;
+	float * V;
+	timer linsysTimer;
 	tic(&linsysTimer);
-	LDLSolve(b, b, p->L, p->D, p->P, p->bp);
-	totalSolveTime += tocq(&linsysTimer);
+	if (p->normal) {
+		normalRhs(A, b);
+	}
+	if (p->single && p->super) {
+		F = p->super;
+		V = &(p->bps[F->n]);
+		superSolveSingle(F, p->Lxs, p->Ds, p->P, V, &(V[F->maxRows * F->sched->nthreads]), p->bps, b);
+	} else if (p->single) {
+		LDLSolveSingle(b, b, p->L, p->Lxs, p->Ds, p->P, p->bps);
+	} else if (p->super) {
+		superSolve(p->super, p->D, p->P, p->superWork, p->bp, b);
+	} else {
+		LDLSolve(b, p);
+	}
+	if (p->normal) {
+		normalSol(A, b);
+	}
+	p->totalSolveTime += tocq(&linsysTimer);
 #if EXTRAVERBOSE > 0
 	scs_printf("linsys solve time: %1.2es\n", tocq(&linsysTimer) / 1e3);
 #endif
 	return 0;
 }
 
+scs_int solveLinSysBatch(const AMatrix * A, const Settings * stgs, Priv * p, scs_float ** b, const scs_float ** s,
+		scs_int nrhs, scs_int iter) {
+	/* warm-starts are not used by the direct solver */
+	scs_int j;
+	timer linsysTimer;
+	tic(&linsysTimer);
+	if (!p->bpBatch) {
+		p->bpBatch = scs_malloc((A->n + A->m) * BATCH_BLOCK * sizeof(scs_float));
+		if (!p->bpBatch) {
+			return -1;
+		}
+	}
+	for (j = 0; j < nrhs && p->normal; ++j) {
+		normalRhs(A, b[j]);
+	}
+	if (nrhs == 1 && p->super) {
+		superSolve(p->super, p->D, p->P, p->superWork, p->bp, b[0]);
+	} else if (nrhs == 1) {
+		LDLSolve(b[0], p);
+	}
+	for (j = 0; j < nrhs && nrhs > 1; j += BATCH_BLOCK) {
+		if (p->super) {
+			superSolveBatchPerm(&(b[j]), MIN(BATCH_BLOCK, nrhs - j), p);
+		} else {
+			LDLSolveBatch(&(b[j]), MIN(BATCH_BLOCK, nrhs - j), p->L, p->D, p->P, p->bpBatch);
+		}
+	}
+	for (j = 0; j < nrhs && p->normal; ++j) {
+		normalSol(A, b[j]);
+	}
+	p->totalSolveTime += tocq(&linsysTimer);
+#if EXTRAVERBOSE > 0
+	scs_printf("batch linsys solve time (%li right-hand sides): %1.2es\n", (long) nrhs, tocq(&linsysTimer) / 1e3);
+#endif
+	return 0;
+}
@@ -6,13 +6,30 @@
 #include "cs.h"
 #include "external/amd.h"
 #include "external/ldl.h"
+#include "supernodal.h"
 #include "../common.h"
 
 struct PRIVATE_DATA {
-	cs * L; /* KKT, and factorization matrix L resp. */
+	cs * L; /* KKT (or normal equations), and factorization matrix L resp. */
 	scs_float * D; /* diagonal matrix of factorization */
 	scs_int * P; /* permutation of KKT matrix for factorization */
+	scs_int * Parent, * Lnz; /* elimination tree and column counts of L, kept for numeric refactorization */
 	scs_float * bp; /* workspace memory for solves */
+	TreeSchedule * sched; /* of the numeric factorization and the solves, over the elimination tree of the columns */
+	/* supernodal factorization (supernodal setting), L is then only filled in for the multiple right-hand side
+	 * solves, on first use */
+	SuperFactor * super;
+	scs_float * superWork; /* workspace for the supernodal solves, per thread */
+	scs_float * bpBatch; /* workspace for multiple right-hand side solves, allocated on first use */
+	/* single precision copy of L (of super->x if super) and D, and solve workspace, for mixed precision, allocated on
+	 * first use */
+	float * Lxs, * Ds, * bps;
+	scs_int single; /* solveLinSys uses the single precision copy */
+	scs_int normal; /* L is the factor of rho_x I + A'A (normal_equations setting), not of the KKT matrix */
+	scs_int factorCache; /* factor_cache: 1 factorization loaded from it, 0 stored in it, -1 unused */
+	/* reporting */
+	scs_float totalSolveTime, totalSpmvTime; /* since the last getLinSysInfo */
+	scs_float orderingTime, factorTime; /* since initPriv */
 };
 
 #endif
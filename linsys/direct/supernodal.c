@@ -0,0 +1,1146 @@
+#include "supernodal.h"
+#include "scs_blas.h"
+
+/* relaxed amalgamation, as in CHOLMOD: a supernode is merged with the next one when that one is its parent and the
+ * merged supernode has at most SUPER_RELAX_0 columns, or at most SUPER_RELAX_1 (SUPER_RELAX_2) columns and a fraction
+ * of explicit zeros below SUPER_ZEROS_1 (SUPER_ZEROS_2), or any number of columns and below SUPER_ZEROS_3 zeros */
+#define SUPER_RELAX_0 (4)
+#define SUPER_RELAX_1 (16)
+#define SUPER_RELAX_2 (48)
+#define SUPER_ZEROS_1 (0.8)
+#define SUPER_ZEROS_2 (0.1)
+#define SUPER_ZEROS_3 (0.05)
+/* column panel width of the dense factorization of a supernode */
+#define SUPER_PANEL (32)
+/* columns of a supernode processed together in the solves */
+#define SUPER_SOLVE_BLOCK (4)
+/* dense kernels with fewer flops than this use plain loops rather than the BLAS call */
+#define SUPER_BLAS_MIN (512)
+/* supernodes pay off when the factorization does at least this many flops per entry of L, as in CHOLMOD */
+#define SUPER_MIN_FLOPS_PER_NZ (40)
+/* the solves are split into about this many tasks per thread, for the load balance */
+#define SCHEDULE_TASKS_PER_THREAD (4)
+/* solves over trees with less work than this (entries of L) are left to one thread */
+#define SCHEDULE_MIN_WORK (32768)
+/* so are those whose tasks have less than this work each on average, or less than this fraction of the total (the
+ * rest, on top, runs on one thread), where the threads cost more to start and join than they save */
+#define SCHEDULE_MIN_TASK_WORK (16384)
+#define SCHEDULE_MIN_PARALLEL (0.5)
+
+#ifdef OPENMP
+#include <omp.h>
+#endif
+
+#ifdef LAPACK_LIB_FOUND
+void BLAS(gemm)(const char *transa, const char *transb, const blasint *m, const blasint *n, const blasint *k,
+		const scs_float *alpha, const scs_float *a, const blasint *lda, const scs_float *b, const blasint *ldb,
+		const scs_float *beta, scs_float *c, const blasint *ldc);
+void BLAS(trsm)(const char *side, const char *uplo, const char *transa, const char *diag, const blasint *m,
+		const blasint *n, const scs_float *alpha, const scs_float *a, const blasint *lda, scs_float *b,
+		const blasint *ldb);
+#endif
+
+void superPostorder(scs_int n, const scs_int * Parent, scs_int * post) {
+	scs_int i, j, p, top, k = 0;
+	scs_int * head = scs_malloc(n * sizeof(scs_int));
+	scs_int * next = scs_malloc(n * sizeof(scs_int));
+	scs_int * stack = scs_malloc(n * sizeof(scs_int));
+	for (j = 0; j < n; ++j) {
+		head[j] = -1;
+	}
+	/* children in increasing order, so a postordered tree is left as it is */
+	for (j = n - 1; j >= 0; --j) {
+		if (Parent[j] != -1) {
+			next[j] = head[Parent[j]];
+			head[Parent[j]] = j;
+		}
+	}
+	for (j = 0; j < n; ++j) {
+		if (Parent[j] != -1) {
+			continue;
+		}
+		stack[0] = j;
+		top = 0;
+		while (top >= 0) {
+			p = stack[top];
+			i = head[p];
+			if (i == -1) {
+				post[k++] = p;
+				--top;
+			} else {
+				head[p] = next[i];
+				stack[++top] = i;
+			}
+		}
+	}
+	scs_free(head);
+	scs_free(next);
+	scs_free(stack);
+}
+
+TreeSchedule * treeSchedule(scs_int n, const scs_int * Parent, const scs_int * work, scs_int nthreads) {
+	scs_int j, r, t;
+	scs_float total = 0, target, taskWork = 0, parallelWork = 0;
+	scs_float * W = scs_malloc(MAX(n, 1) * sizeof(scs_float));
+	scs_int * size = scs_malloc(MAX(n, 1) * sizeof(scs_int));
+	TreeSchedule * S = scs_calloc(1, sizeof(TreeSchedule));
+	if (S) {
+		S->first = scs_malloc(MAX(n, 1) * sizeof(scs_int));
+		S->last = scs_malloc(MAX(n, 1) * sizeof(scs_int));
+		S->top = scs_malloc(MAX(n, 1) * sizeof(scs_int));
+		S->taskOf = scs_malloc(MAX(n, 1) * sizeof(scs_int));
+	}
+	if (!W || !size || !S || !S->first || !S->last || !S->top || !S->taskOf) {
+		if (W)
+			scs_free(W);
+		if (size)
+			scs_free(size);
+		freeSchedule(S);
+		return SCS_NULL;
+	}
+	/* work and size of the subtrees, the children come before their parent */
+	for (j = 0; j < n; ++j) {
+		W[j] = 0;
+		size[j] = 0;
+	}
+	for (j = 0; j < n; ++j) {
+		W[j] += work[j];
+		size[j] += 1;
+		total += work[j];
+		if (Parent[j] != -1) {
+			W[Parent[j]] += W[j];
+			size[Parent[j]] += size[j];
+		}
+	}
+	S->nthreads = total < SCHEDULE_MIN_WORK ? 1 : MAX(nthreads, 1);
+	target = S->nthreads > 1 ? total / (S->nthreads * SCHEDULE_TASKS_PER_THREAD) : total;
+	/* the largest subtrees with at most the target work, adjacent ones merged up to it, the rest is on top */
+	for (r = 0; r < n; ++r) {
+		if (W[r] > target) {
+			S->taskOf[r] = -1;
+			S->top[S->ntop++] = r;
+			continue;
+		}
+		if (Parent[r] != -1 && W[Parent[r]] <= target) {
+			continue;
+		}
+		t = S->ntasks - 1;
+		if (t >= 0 && S->last[t] == r - size[r] && taskWork + W[r] <= target) {
+			taskWork += W[r];
+		} else {
+			t = S->ntasks++;
+			S->first[t] = r - size[r] + 1;
+			taskWork = W[r];
+		}
+		S->last[t] = r;
+		parallelWork += W[r];
+		for (j = r - size[r] + 1; j <= r; ++j) {
+			S->taskOf[j] = t;
+		}
+	}
+	scs_free(W);
+	scs_free(size);
+	if (S->nthreads > 1 && (S->ntasks < 2 || parallelWork < SCHEDULE_MIN_TASK_WORK * S->ntasks
+			|| parallelWork < SCHEDULE_MIN_PARALLEL * total)) {
+		freeSchedule(S);
+		return treeSchedule(n, Parent, work, 1);
+	}
+	return S;
+}
+
+void freeSchedule(TreeSchedule * S) {
+	if (S) {
+		if (S->first)
+			scs_free(S->first);
+		if (S->last)
+			scs_free(S->last);
+		if (S->top)
+			scs_free(S->top);
+		if (S->taskOf)
+			scs_free(S->taskOf);
+		if (S->split)
+			scs_free(S->split);
+		if (S->sweep)
+			scs_free(S->sweep);
+		if (S->bufp)
+			scs_free(S->bufp);
+		if (S->buf)
+			scs_free(S->buf);
+		scs_free(S);
+	}
+}
+
+/* whether a supernode of w columns with zeros explicit zeros out of total stored entries is kept */
+static scs_int relaxedSupernode(scs_int w, scs_float zeros, scs_float total) {
+	scs_float frac = zeros / total;
+	return w <= SUPER_RELAX_0 || (w <= SUPER_RELAX_1 && frac < SUPER_ZEROS_1)
+			|| (w <= SUPER_RELAX_2 && frac < SUPER_ZEROS_2) || frac < SUPER_ZEROS_3;
+}
+
+/* entries of L stored for the columns f to l with the pattern of column l below them */
+static scs_float storedEntries(scs_int f, scs_int l, const scs_int * Lnz) {
+	scs_float w = l - f + 1;
+	return w * (w + 1) / 2 + w * Lnz[l];
+}
+
+scs_int superWorthwhile(scs_int n, const scs_int * Lnz) {
+	scs_int j;
+	scs_float flops = 0, nz = 0;
+	for (j = 0; j < n; ++j) {
+		flops += (scs_float) Lnz[j] * Lnz[j];
+		nz += Lnz[j];
+	}
+	return flops >= SUPER_MIN_FLOPS_PER_NZ * nz;
+}
+
+SuperFactor * superSymbolic(const cs * C, const scs_int * Parent, const scs_int * Lnz) {
+	scs_int j, k, l, p, s, f, w, nr, n = C->n, nsuper = 0;
+	scs_int *pos, *Flag;
+	scs_float openNz = 0, exactNz;
+	SuperFactor * F = scs_calloc(1, sizeof(SuperFactor));
+	if (!F) {
+		return SCS_NULL;
+	}
+	F->n = n;
+	F->super = scs_malloc((n + 1) * sizeof(scs_int));
+	F->colSuper = scs_malloc(MAX(n, 1) * sizeof(scs_int));
+	if (!F->super || !F->colSuper) {
+		superFree(F);
+		return SCS_NULL;
+	}
+	/* exact supernodes: column j + 1 continues column j if it is its parent and has its pattern without j + 1 */
+	for (j = 0; j < n; j = l + 1) {
+		exactNz = Lnz[j] + 1;
+		for (l = j; l + 1 < n && Parent[l] == l + 1 && Lnz[l] == Lnz[l + 1] + 1; ++l) {
+			exactNz += Lnz[l + 1] + 1;
+		}
+		if (nsuper > 0 && Parent[j - 1] == j) {
+			f = F->super[nsuper - 1];
+			if (relaxedSupernode(l - f + 1, storedEntries(f, l, Lnz) - openNz - exactNz, storedEntries(f, l, Lnz))) {
+				openNz += exactNz;
+				continue;
+			}
+		}
+		F->super[nsuper++] = j;
+		openNz = exactNz;
+	}
+	F->super[nsuper] = n;
+	F->nsuper = nsuper;
+	F->rowp = scs_malloc((nsuper + 1) * sizeof(scs_int));
+	F->xp = scs_malloc((nsuper + 1) * sizeof(scs_int));
+	pos = scs_malloc(MAX(nsuper, 1) * sizeof(scs_int));
+	Flag = scs_malloc(MAX(n, 1) * sizeof(scs_int));
+	if (!F->rowp || !F->xp || !pos || !Flag) {
+		if (pos)
+			scs_free(pos);
+		if (Flag)
+			scs_free(Flag);
+		superFree(F);
+		return SCS_NULL;
+	}
+	F->rowp[0] = F->xp[0] = 0;
+	for (s = 0; s < nsuper; ++s) {
+		f = F->super[s];
+		w = F->super[s + 1] - f;
+		nr = w + Lnz[F->super[s + 1] - 1];
+		for (j = f; j < f + w; ++j) {
+			F->colSuper[j] = s;
+		}
+		F->rowp[s + 1] = F->rowp[s] + nr;
+		F->xp[s + 1] = F->xp[s] + nr * w;
+		F->nnz += nr * w - (w * (w + 1)) / 2;
+		F->maxRows = MAX(F->maxRows, nr);
+		F->maxCols = MAX(F->maxCols, w);
+	}
+	F->rows = scs_malloc(MAX(F->rowp[nsuper], 1) * sizeof(scs_int));
+	F->x = scs_malloc(MAX(F->xp[nsuper], 1) * sizeof(scs_float));
+	if (!F->rows || !F->x) {
+		scs_free(pos);
+		scs_free(Flag);
+		superFree(F);
+		return SCS_NULL;
+	}
+	for (s = 0; s < nsuper; ++s) {
+		pos[s] = F->rowp[s];
+		for (j = F->super[s]; j < F->super[s + 1]; ++j) {
+			F->rows[pos[s]++] = j;
+		}
+	}
+	/* the rows below a supernode are the pattern of its last column: row k is in it if the column is in the row
+	 * subtree of k, visited in increasing k as in LDL_numeric, so the rows come out sorted */
+	for (k = 0; k < n; ++k) {
+		Flag[k] = k;
+		for (p = C->p[k]; p < C->p[k + 1]; ++p) {
+			for (j = C->i[p]; j < k && Flag[j] != k; j = Parent[j]) {
+				Flag[j] = k;
+				s = F->colSuper[j];
+				if (j == F->super[s + 1] - 1) {
+					F->rows[pos[s]++] = k;
+				}
+			}
+		}
+	}
+	scs_free(pos);
+	scs_free(Flag);
+	return F;
+}
+
+/* C -= A B' for A m x k and B n x k, all column-major */
+static void denseUpdate(scs_int m, scs_int n, scs_int k, const scs_float * A, scs_int lda, const scs_float * B,
+		scs_int ldb, scs_float * C, scs_int ldc) {
+	scs_int i, j, l;
+	scs_float b, *Cj;
+	const scs_float *Al;
+#ifdef LAPACK_LIB_FOUND
+	blasint mb = (blasint) m, nb = (blasint) n, kb = (blasint) k, ldab = (blasint) lda, ldbb = (blasint) ldb;
+	blasint ldcb = (blasint) ldc;
+	scs_float mOne = -1.0, pOne = 1.0;
+	if ((scs_float) m * n * k >= SUPER_BLAS_MIN) {
+		BLAS(gemm)("NoTranspose", "Transpose", &mb, &nb, &kb, &mOne, A, &ldab, B, &ldbb, &pOne, C, &ldcb);
+		return;
+	}
+#endif
+	for (j = 0; j < n; ++j) {
+		Cj = &(C[j * ldc]);
+		for (l = 0; l < k; ++l) {
+			b = B[j + l * ldb];
+			Al = &(A[l * lda]);
+			for (i = 0; i < m; ++i) {
+				Cj[i] -= Al[i] * b;
+			}
+		}
+	}
+}
+
+/* B = B L^-T for the m x n B and the unit lower triangular n x n L */
+static void denseTrsm(scs_int m, scs_int n, const scs_float * L, scs_int ldl, scs_float * B, scs_int ldb) {
+	scs_int i, j, l;
+	scs_float lj, *Bj;
+	const scs_float *Bl;
+#ifdef LAPACK_LIB_FOUND
+	blasint mb = (blasint) m, nb = (blasint) n, ldlb = (blasint) ldl, ldbb = (blasint) ldb;
+	scs_float pOne = 1.0;
+	if ((scs_float) m * n * n >= SUPER_BLAS_MIN) {
+		BLAS(trsm)("Right", "Lower", "Transpose", "Unit", &mb, &nb, &pOne, L, &ldlb, B, &ldbb);
+		return;
+	}
+#endif
+	for (j = 0; j < n; ++j) {
+		Bj = &(B[j * ldb]);
+		for (l = 0; l < j; ++l) {
+			lj = L[j + l * ldl];
+			Bl = &(B[l * ldb]);
+			for (i = 0; i < m; ++i) {
+				Bj[i] -= Bl[i] * lj;
+			}
+		}
+	}
+}
+
+/* L D L' of the nr x w block L (a supernode with the updates from the supernodes before it), in column panels:
+ * the diagonal block of a panel with loops, the rows below it by a triangular solve, then the columns after it by a
+ * rank-SUPER_PANEL update. W is workspace of size w * SUPER_PANEL. returns -1 on a zero pivot */
+static scs_int factorSupernode(scs_float * L, scs_int nr, scs_int w, scs_float * D, scs_float * W) {
+	scs_int c0, c1, i, j, k, pw;
+	scs_float d, ljk, *Lk, *Lj;
+	for (c0 = 0; c0 < w; c0 = c1) {
+		c1 = MIN(c0 + SUPER_PANEL, w);
+		pw = c1 - c0;
+		for (k = c0; k < c1; ++k) {
+			Lk = &(L[k * nr]);
+			d = Lk[k];
+			if (d == 0.0) {
+				return -1;
+			}
+			D[k] = d;
+			for (i = k + 1; i < c1; ++i) {
+				Lk[i] /= d;
+			}
+			for (j = k + 1; j < c1; ++j) {
+				Lj = &(L[j * nr]);
+				ljk = Lk[j] * d;
+				for (i = j; i < c1; ++i) {
+					Lj[i] -= Lk[i] * ljk;
+				}
+			}
+		}
+		if (c1 == nr) {
+			break;
+		}
+		/* rows below: X L11' = A21 with X = L21 D, and W = X for the rows of the trailing columns */
+		denseTrsm(nr - c1, pw, &(L[c0 + c0 * nr]), nr, &(L[c1 + c0 * nr]), nr);
+		for (k = c0; k < c1; ++k) {
+			Lk = &(L[k * nr]);
+			for (i = c1; i < w; ++i) {
+				W[i - c1 + (k - c0) * (w - c1)] = Lk[i];
+			}
+			for (i = c1; i < nr; ++i) {
+				Lk[i] /= D[k];
+			}
+		}
+		if (c1 < w) {
+			denseUpdate(nr - c1, w - c1, pw, &(L[c1 + c0 * nr]), nr, W, w - c1, &(L[c1 + c1 * nr]), nr);
+		}
+	}
+	return 0;
+}
+
+static scs_int getThreadNum(void) {
+#ifdef OPENMP
+	return omp_get_thread_num();
+#else
+	return 0;
+#endif
+}
+
+/* per thread workspace of superNumeric */
+typedef struct SUPER_NUMERIC_WORK {
+	scs_int * Map; /* row -> its position in the supernode being factored (size n) */
+	scs_int * RelMap; /* rows of an update -> their positions in it (size maxRows) */
+	scs_int * Upd; /* the supernodes updating it, sorted (size nsuper) */
+	scs_float * Cb, * W; /* an update, and the scaled rows of its columns (size rows * cols of the supernodes) */
+} SuperNumericWork;
+
+static int compareInts(const void * a, const void * b) {
+	scs_int x = *(const scs_int *) a, y = *(const scs_int *) b;
+	return x < y ? -1 : (x > y);
+}
+
+static void freeNumericWork(SuperNumericWork * Wk) {
+	if (Wk->Map)
+		scs_free(Wk->Map);
+	if (Wk->RelMap)
+		scs_free(Wk->RelMap);
+	if (Wk->Upd)
+		scs_free(Wk->Upd);
+	if (Wk->Cb)
+		scs_free(Wk->Cb);
+	if (Wk->W)
+		scs_free(Wk->W);
+}
+
+/* assembles supernode s from the lower triangle T of C (by columns) and the updates of the supernodes in its list
+ * (Head, Next), in increasing order, then factors it. the supernodes are then linked in the lists of the supernode of
+ * their next row (at Pos), if it is in the same task or inTop, else left for the top nodes. returns -1 on a zero
+ * pivot */
+static scs_int numericSupernode(const SuperFactor * F, scs_int s, const scs_int * Tp, const scs_int * Ti,
+		const scs_float * Tx, scs_float * D, scs_int * Head, scs_int * Next, scs_int * Pos, scs_int inTop,
+		SuperNumericWork * Wk) {
+	scs_int d, f, i, ii, jj, k, p, t, u, nupd = 0, wd, nrd, pd, pe, np1, np, *Rd;
+	scs_int w = F->super[s + 1] - F->super[s], nr = F->rowp[s + 1] - F->rowp[s], *R = &(F->rows[F->rowp[s]]);
+	scs_int *Map = Wk->Map, *RelMap = Wk->RelMap;
+	scs_float *Ls = &(F->x[F->xp[s]]), *Ld, *Lcol, *Cb = Wk->Cb, *W = Wk->W;
+	const TreeSchedule * S = F->sched;
+	f = F->super[s];
+	for (i = 0; i < nr; ++i) {
+		Map[R[i]] = i;
+	}
+	memset(Ls, 0, nr * w * sizeof(scs_float));
+	for (k = 0; k < w; ++k) {
+		for (p = Tp[f + k]; p < Tp[f + k + 1]; ++p) {
+			Ls[Map[Ti[p]] + k * nr] += Tx[p];
+		}
+	}
+	/* the order of the list depends on the schedule, the sorted one does not */
+	for (d = Head[s]; d != -1; d = Next[d]) {
+		Wk->Upd[nupd++] = d;
+	}
+	qsort(Wk->Upd, nupd, sizeof(scs_int), compareInts);
+	for (u = 0; u < nupd; ++u) {
+		d = Wk->Upd[u];
+		wd = F->super[d + 1] - F->super[d];
+		nrd = F->rowp[d + 1] - F->rowp[d];
+		Rd = &(F->rows[F->rowp[d]]);
+		Ld = &(F->x[F->xp[d]]);
+		pd = Pos[d];
+		for (pe = pd; pe < nrd && Rd[pe] < f + w; ++pe)
+			;
+		np1 = pe - pd;
+		np = nrd - pd;
+		/* Cb = L_d(rows pd:, :) D_d L_d(rows pd:pe, :)', its lower part scattered into the supernode */
+		for (k = 0; k < wd; ++k) {
+			for (i = 0; i < np1; ++i) {
+				W[i + k * np1] = Ld[pd + i + k * nrd] * D[F->super[d] + k];
+			}
+		}
+		memset(Cb, 0, np * np1 * sizeof(scs_float));
+		denseUpdate(np, np1, wd, &(Ld[pd]), nrd, W, np1, Cb, np);
+		for (ii = 0; ii < np; ++ii) {
+			RelMap[ii] = Map[Rd[pd + ii]];
+		}
+		for (jj = 0; jj < np1; ++jj) {
+			Lcol = &(Ls[(Rd[pd + jj] - f) * nr]);
+			for (ii = jj; ii < np; ++ii) {
+				Lcol[RelMap[ii]] += Cb[ii + jj * np];
+			}
+		}
+		Pos[d] = pe;
+	}
+	if (factorSupernode(Ls, nr, w, &(D[f]), W) < 0) {
+		return -1;
+	}
+	Pos[s] = w;
+	Wk->Upd[nupd++] = s;
+	for (u = 0; u < nupd; ++u) {
+		d = Wk->Upd[u];
+		nrd = F->rowp[d + 1] - F->rowp[d];
+		if (Pos[d] < nrd) {
+			t = F->colSuper[F->rows[F->rowp[d] + Pos[d]]];
+			if (inTop || S->taskOf[t] >= 0) {
+				Next[d] = Head[t];
+				Head[t] = d;
+			}
+		}
+	}
+	return 0;
+}
+
+/* left-looking: each supernode gathers the updates of the supernodes with rows in its columns, kept in linked lists
+ * (Head, Next) by the supernode of their next row (at Pos), then is factored densely. the tasks of the schedule run in
+ * parallel, each on its own subtrees, then the top nodes with the updates of all the supernodes with rows in them */
+scs_int superNumeric(const cs * C, SuperFactor * F, scs_float * D) {
+	scs_int d, j, k, p, s, t, nrd, n = F->n, nsuper = F->nsuper, failures = 0, rowsTask = 0, colsTask = 0;
+	scs_int *Tp = scs_calloc(n + 1, sizeof(scs_int)), *Ti = scs_malloc(MAX(C->p[n], 1) * sizeof(scs_int));
+	scs_float *Tx = scs_malloc(MAX(C->p[n], 1) * sizeof(scs_float));
+	scs_int *Head = scs_malloc(MAX(nsuper, 1) * sizeof(scs_int)), *Next = scs_malloc(MAX(nsuper, 1) * sizeof(scs_int));
+	scs_int *Pos = scs_malloc(MAX(nsuper, 1) * sizeof(scs_int));
+	const TreeSchedule * S = F->sched;
+	SuperNumericWork * Wk = scs_calloc(S->nthreads, sizeof(SuperNumericWork));
+	if (!Tp || !Ti || !Tx || !Head || !Next || !Pos || !Wk) {
+		failures = 1;
+	}
+	/* thread 0 also factors the top nodes, the others only those of the tasks */
+	for (s = 0; s < nsuper; ++s) {
+		if (S->taskOf[s] >= 0) {
+			rowsTask = MAX(rowsTask, F->rowp[s + 1] - F->rowp[s]);
+			colsTask = MAX(colsTask, F->super[s + 1] - F->super[s]);
+		}
+	}
+	for (t = 0; t < S->nthreads && !failures; ++t) {
+		Wk[t].Map = scs_malloc(MAX(n, 1) * sizeof(scs_int));
+		Wk[t].RelMap = scs_malloc(MAX(F->maxRows, 1) * sizeof(scs_int));
+		Wk[t].Upd = scs_malloc(MAX(nsuper, 1) * sizeof(scs_int));
+		k = t ? rowsTask * colsTask : F->maxRows * F->maxCols;
+		Wk[t].Cb = scs_malloc(MAX(k, 1) * sizeof(scs_float));
+		Wk[t].W = scs_malloc(MAX(k, 1) * sizeof(scs_float));
+		if (!Wk[t].Map || !Wk[t].RelMap || !Wk[t].Upd || !Wk[t].Cb || !Wk[t].W) {
+			failures = 1;
+		}
+	}
+	if (!failures) {
+		/* lower triangle of C, by columns, to assemble the columns of each supernode */
+		for (j = 0; j < n; ++j) {
+			for (p = C->p[j]; p < C->p[j + 1]; ++p) {
+				Tp[C->i[p] + 1]++;
+			}
+		}
+		for (j = 0; j < n; ++j) {
+			Tp[j + 1] += Tp[j];
+			Wk[0].Map[j] = Tp[j];
+		}
+		for (j = 0; j < n; ++j) {
+			for (p = C->p[j]; p < C->p[j + 1]; ++p) {
+				Ti[Wk[0].Map[C->i[p]]] = j;
+				Tx[Wk[0].Map[C->i[p]]++] = C->x[p];
+			}
+		}
+		for (s = 0; s < nsuper; ++s) {
+			Head[s] = -1;
+		}
+#ifdef OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(S->nthreads) private(s) reduction(+:failures) \
+	if (S->ntasks > 1)
+#endif
+		for (t = 0; t < S->ntasks; ++t) {
+			for (s = S->first[t]; s <= S->last[t] && !failures; ++s) {
+				if (numericSupernode(F, s, Tp, Ti, Tx, D, Head, Next, Pos, 0, &(Wk[getThreadNum()])) < 0) {
+					failures++;
+				}
+			}
+		}
+	}
+	if (!failures) {
+		/* the supernodes of the tasks with rows in the top nodes, in the lists of the first of them */
+		for (d = 0; d < nsuper; ++d) {
+			nrd = F->rowp[d + 1] - F->rowp[d];
+			if (S->taskOf[d] >= 0 && Pos[d] < nrd) {
+				t = F->colSuper[F->rows[F->rowp[d] + Pos[d]]];
+				Next[d] = Head[t];
+				Head[t] = d;
+			}
+		}
+		for (k = 0; k < S->ntop && !failures; ++k) {
+			if (numericSupernode(F, S->top[k], Tp, Ti, Tx, D, Head, Next, Pos, 1, &(Wk[0])) < 0) {
+				failures++;
+			}
+		}
+	}
+	if (Tp)
+		scs_free(Tp);
+	if (Ti)
+		scs_free(Ti);
+	if (Tx)
+		scs_free(Tx);
+	if (Head)
+		scs_free(Head);
+	if (Next)
+		scs_free(Next);
+	if (Pos)
+		scs_free(Pos);
+	if (Wk) {
+		for (t = 0; t < S->nthreads; ++t) {
+			freeNumericWork(&(Wk[t]));
+		}
+		scs_free(Wk);
+	}
+	return failures ? -1 : 0;
+}
+
+/* the solves use plain loops, the same operations in the same order for one right-hand side as for each of a batch.
+ * the entries of x in the rows of a supernode are gathered in v (the rows below it start at zero and are added back
+ * to x after), then its columns are processed in blocks of SUPER_SOLVE_BLOCK: forward, the rows below a block are
+ * updated by all its columns in one pass, backward, each column of a block takes its dot product with v below the
+ * block, so there are SUPER_SOLVE_BLOCK independent sums */
+/* L x = b in the columns of supernode s, in place in x: the updates of its rows below them are left in v */
+static void forwardSupernode(const SuperFactor * F, scs_int s, scs_float * v, scs_float * x) {
+	scs_int i, c, k0, k1, f = F->super[s], w = F->super[s + 1] - f, nr = F->rowp[s + 1] - F->rowp[s];
+	scs_float vi, x0, x1, x2, x3, *L = &(F->x[F->xp[s]]), *L0, *L1, *L2, *L3;
+	memcpy(v, &(x[f]), w * sizeof(scs_float));
+	memset(&(v[w]), 0, (nr - w) * sizeof(scs_float));
+	for (k0 = 0; k0 < w; k0 = k1) {
+		k1 = MIN(k0 + SUPER_SOLVE_BLOCK, w);
+		for (c = k0; c < k1; ++c) {
+			for (i = c + 1; i < k1; ++i) {
+				v[i] -= L[i + c * nr] * v[c];
+			}
+		}
+		if (k1 - k0 == SUPER_SOLVE_BLOCK) {
+			L0 = &(L[k0 * nr]);
+			L1 = &(L0[nr]);
+			L2 = &(L1[nr]);
+			L3 = &(L2[nr]);
+			x0 = v[k0];
+			x1 = v[k0 + 1];
+			x2 = v[k0 + 2];
+			x3 = v[k0 + 3];
+			for (i = k1; i < nr; ++i) {
+				vi = v[i];
+				vi -= L0[i] * x0;
+				vi -= L1[i] * x1;
+				vi -= L2[i] * x2;
+				vi -= L3[i] * x3;
+				v[i] = vi;
+			}
+		} else {
+			for (c = k0; c < k1; ++c) {
+				L0 = &(L[c * nr]);
+				x0 = v[c];
+				for (i = k1; i < nr; ++i) {
+					v[i] -= L0[i] * x0;
+				}
+			}
+		}
+	}
+	memcpy(&(x[f]), v, w * sizeof(scs_float));
+}
+
+/* L' x = D^-1 b in the columns of supernode s, in place in x (its rows below them are already solved), and copied to
+ * their rows of b */
+static void backwardSupernode(const SuperFactor * F, scs_int s, const scs_float * D, const scs_int * P, scs_float * v,
+		scs_float * x, scs_float * b) {
+	scs_int i, c, k0, k1, f = F->super[s], w = F->super[s + 1] - f, nr = F->rowp[s + 1] - F->rowp[s];
+	scs_int * R = &(F->rows[F->rowp[s]]);
+	scs_float vi, t0, t1, t2, t3, *L = &(F->x[F->xp[s]]), *L0, *L1, *L2, *L3;
+	for (i = 0; i < w; ++i) {
+		v[i] = x[f + i] / D[f + i];
+	}
+	for (i = w; i < nr; ++i) {
+		v[i] = x[R[i]];
+	}
+	for (k0 = (w - 1) / SUPER_SOLVE_BLOCK * SUPER_SOLVE_BLOCK; k0 >= 0; k0 -= SUPER_SOLVE_BLOCK) {
+		k1 = MIN(k0 + SUPER_SOLVE_BLOCK, w);
+		if (k1 - k0 == SUPER_SOLVE_BLOCK) {
+			L0 = &(L[k0 * nr]);
+			L1 = &(L0[nr]);
+			L2 = &(L1[nr]);
+			L3 = &(L2[nr]);
+			t0 = t1 = t2 = t3 = 0.0;
+			for (i = k1; i < nr; ++i) {
+				vi = v[i];
+				t0 += L0[i] * vi;
+				t1 += L1[i] * vi;
+				t2 += L2[i] * vi;
+				t3 += L3[i] * vi;
+			}
+			v[k0] -= t0;
+			v[k0 + 1] -= t1;
+			v[k0 + 2] -= t2;
+			v[k0 + 3] -= t3;
+		} else {
+			for (c = k0; c < k1; ++c) {
+				L0 = &(L[c * nr]);
+				t0 = 0.0;
+				for (i = k1; i < nr; ++i) {
+					t0 += L0[i] * v[i];
+				}
+				v[c] -= t0;
+			}
+		}
+		for (c = k1 - 1; c >= k0; --c) {
+			for (i = c + 1; i < k1; ++i) {
+				v[c] -= L[i + c * nr] * v[i];
+			}
+		}
+	}
+	for (i = 0; i < w; ++i) {
+		x[f + i] = v[i];
+		b[P[f + i]] = v[i];
+	}
+}
+
+scs_int superSchedule(SuperFactor * F, scs_int nthreads) {
+	scs_int i, s, nr, w, lim, *R, nsuper = F->nsuper, nbuf = 0;
+	scs_int * parent = scs_malloc(MAX(nsuper, 1) * sizeof(scs_int));
+	scs_int * work = scs_malloc(MAX(nsuper, 1) * sizeof(scs_int));
+	TreeSchedule * S;
+	if (!parent || !work) {
+		if (parent)
+			scs_free(parent);
+		if (work)
+			scs_free(work);
+		return -1;
+	}
+	/* the parent of a supernode has the first row below its columns, the parent column of its last one */
+	for (s = 0; s < nsuper; ++s) {
+		w = F->super[s + 1] - F->super[s];
+		nr = F->rowp[s + 1] - F->rowp[s];
+		parent[s] = nr > w ? F->colSuper[F->rows[F->rowp[s] + w]] : -1;
+		work[s] = nr * w;
+	}
+	freeSchedule(F->sched);
+	F->sched = S = treeSchedule(nsuper, parent, work, nthreads);
+	scs_free(parent);
+	scs_free(work);
+	if (!S) {
+		return -1;
+	}
+	S->split = scs_malloc(MAX(nsuper, 1) * sizeof(scs_int));
+	S->sweep = scs_malloc(MAX(nsuper, 1) * sizeof(scs_int));
+	S->bufp = scs_malloc((nsuper + 1) * sizeof(scs_int));
+	if (!S->split || !S->sweep || !S->bufp) {
+		return -1;
+	}
+	/* rows are sorted, those of the task come first, then the top ones (ancestors of the task's subtrees) */
+	for (s = 0; s < nsuper; ++s) {
+		w = F->super[s + 1] - F->super[s];
+		nr = F->rowp[s + 1] - F->rowp[s];
+		R = &(F->rows[F->rowp[s]]);
+		S->bufp[s] = nbuf;
+		S->split[s] = w;
+		if (S->taskOf[s] >= 0) {
+			lim = F->super[S->last[S->taskOf[s]] + 1];
+			for (i = w; i < nr && R[i] < lim; ++i) {
+			}
+			S->split[s] = i;
+			nbuf += nr - i;
+		}
+		if (S->taskOf[s] < 0 || S->split[s] < nr) {
+			S->sweep[S->nsweep++] = s;
+		}
+	}
+	S->bufp[nsuper] = nbuf;
+	S->buf = scs_malloc(MAX(nbuf, 1) * sizeof(scs_float));
+	return S->buf ? 0 : -1;
+}
+
+/* the tasks of the schedule run in parallel: in the forward solve a task updates the rows of its own subtrees and keeps
+ * those of the top rows in buf, added in the serial order afterwards, the backward solve reads the top rows, solved
+ * first. so every entry of x gets the same operations in the same order as in one pass over the supernodes */
+void superSolve(const SuperFactor * F, const scs_float * D, const scs_int * P, scs_float * V, scs_float * x,
+		scs_float * b) {
+	scs_int i, j, k, s, t, w, nr, *R;
+	scs_float * v;
+	const TreeSchedule * S = F->sched;
+	/* L x = P' b, the tasks */
+#ifdef OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(S->nthreads) private(i, j, s, w, nr, R, v) \
+	if (S->ntasks > 1)
+#endif
+	for (t = 0; t < S->ntasks; ++t) {
+		v = &(V[getThreadNum() * F->maxRows]);
+		for (j = F->super[S->first[t]]; j < F->super[S->last[t] + 1]; ++j) {
+			x[j] = b[P[j]];
+		}
+		for (s = S->first[t]; s <= S->last[t]; ++s) {
+			w = F->super[s + 1] - F->super[s];
+			nr = F->rowp[s + 1] - F->rowp[s];
+			R = &(F->rows[F->rowp[s]]);
+			forwardSupernode(F, s, v, x);
+			for (i = w; i < S->split[s]; ++i) {
+				x[R[i]] += v[i];
+			}
+			memcpy(&(S->buf[S->bufp[s]]), &(v[S->split[s]]), (nr - S->split[s]) * sizeof(scs_float));
+		}
+	}
+	/* the top rows */
+	v = V;
+	for (k = 0; k < S->ntop; ++k) {
+		for (j = F->super[S->top[k]]; j < F->super[S->top[k] + 1]; ++j) {
+			x[j] = b[P[j]];
+		}
+	}
+	for (k = 0; k < S->nsweep; ++k) {
+		s = S->sweep[k];
+		nr = F->rowp[s + 1] - F->rowp[s];
+		R = &(F->rows[F->rowp[s]]);
+		if (S->taskOf[s] < 0) {
+			forwardSupernode(F, s, v, x);
+		} else {
+			memcpy(&(v[S->split[s]]), &(S->buf[S->bufp[s]]), (nr - S->split[s]) * sizeof(scs_float));
+		}
+		for (i = S->split[s]; i < nr; ++i) {
+			x[R[i]] += v[i];
+		}
+	}
+	/* L' x = D^-1 x, the top rows, then the tasks */
+	for (k = S->ntop - 1; k >= 0; --k) {
+		backwardSupernode(F, S->top[k], D, P, v, x, b);
+	}
+#ifdef OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(S->nthreads) private(s) if (S->ntasks > 1)
+#endif
+	for (t = 0; t < S->ntasks; ++t) {
+		for (s = S->last[t]; s >= S->first[t]; --s) {
+			backwardSupernode(F, s, D, P, &(V[getThreadNum() * F->maxRows]), x, b);
+		}
+	}
+}
+
+/* forwardSupernode with the single precision copy xs of F->x, all arithmetic in single precision */
+static void forwardSupernodeSingle(const SuperFactor * F, const float * xs, scs_int s, float * v, float * x) {
+	scs_int i, c, k0, k1, f = F->super[s], w = F->super[s + 1] - f, nr = F->rowp[s + 1] - F->rowp[s];
+	float vi, x0, x1, x2, x3;
+	const float *L = &(xs[F->xp[s]]), *L0, *L1, *L2, *L3;
+	memcpy(v, &(x[f]), w * sizeof(float));
+	memset(&(v[w]), 0, (nr - w) * sizeof(float));
+	for (k0 = 0; k0 < w; k0 = k1) {
+		k1 = MIN(k0 + SUPER_SOLVE_BLOCK, w);
+		for (c = k0; c < k1; ++c) {
+			for (i = c + 1; i < k1; ++i) {
+				v[i] -= L[i + c * nr] * v[c];
+			}
+		}
+		if (k1 - k0 == SUPER_SOLVE_BLOCK) {
+			L0 = &(L[k0 * nr]);
+			L1 = &(L0[nr]);
+			L2 = &(L1[nr]);
+			L3 = &(L2[nr]);
+			x0 = v[k0];
+			x1 = v[k0 + 1];
+			x2 = v[k0 + 2];
+			x3 = v[k0 + 3];
+			for (i = k1; i < nr; ++i) {
+				vi = v[i];
+				vi -= L0[i] * x0;
+				vi -= L1[i] * x1;
+				vi -= L2[i] * x2;
+				vi -= L3[i] * x3;
+				v[i] = vi;
+			}
+		} else {
+			for (c = k0; c < k1; ++c) {
+				L0 = &(L[c * nr]);
+				x0 = v[c];
+				for (i = k1; i < nr; ++i) {
+					v[i] -= L0[i] * x0;
+				}
+			}
+		}
+	}
+	memcpy(&(x[f]), v, w * sizeof(float));
+}
+
+/* backwardSupernode with the single precision copies xs of F->x and Ds of D, the solution rounded back into b */
+static void backwardSupernodeSingle(const SuperFactor * F, const float * xs, scs_int s, const float * Ds,
+		const scs_int * P, float * v, float * x, scs_float * b) {
+	scs_int i, c, k0, k1, f = F->super[s], w = F->super[s + 1] - f, nr = F->rowp[s + 1] - F->rowp[s];
+	scs_int * R = &(F->rows[F->rowp[s]]);
+	float vi, t0, t1, t2, t3;
+	const float *L = &(xs[F->xp[s]]), *L0, *L1, *L2, *L3;
+	for (i = 0; i < w; ++i) {
+		v[i] = x[f + i] / Ds[f + i];
+	}
+	for (i = w; i < nr; ++i) {
+		v[i] = x[R[i]];
+	}
+	for (k0 = (w - 1) / SUPER_SOLVE_BLOCK * SUPER_SOLVE_BLOCK; k0 >= 0; k0 -= SUPER_SOLVE_BLOCK) {
+		k1 = MIN(k0 + SUPER_SOLVE_BLOCK, w);
+		if (k1 - k0 == SUPER_SOLVE_BLOCK) {
+			L0 = &(L[k0 * nr]);
+			L1 = &(L0[nr]);
+			L2 = &(L1[nr]);
+			L3 = &(L2[nr]);
+			t0 = t1 = t2 = t3 = 0.0f;
+			for (i = k1; i < nr; ++i) {
+				vi = v[i];
+				t0 += L0[i] * vi;
+				t1 += L1[i] * vi;
+				t2 += L2[i] * vi;
+				t3 += L3[i] * vi;
+			}
+			v[k0] -= t0;
+			v[k0 + 1] -= t1;
+			v[k0 + 2] -= t2;
+			v[k0 + 3] -= t3;
+		} else {
+			for (c = k0; c < k1; ++c) {
+				L0 = &(L[c * nr]);
+				t0 = 0.0f;
+				for (i = k1; i < nr; ++i) {
+					t0 += L0[i] * v[i];
+				}
+				v[c] -= t0;
+			}
+		}
+		for (c = k1 - 1; c >= k0; --c) {
+			for (i = c + 1; i < k1; ++i) {
+				v[c] -= L[i + c * nr] * v[i];
+			}
+		}
+	}
+	for (i = 0; i < w; ++i) {
+		x[f + i] = v[i];
+		b[P[f + i]] = v[i];
+	}
+}
+
+/* superSolve in single precision, over the same schedule */
+void superSolveSingle(const SuperFactor * F, const float * xs, const float * Ds, const scs_int * P, float * V,
+		float * buf, float * x, scs_float * b) {
+	scs_int i, j, k, s, t, w, nr, *R;
+	float * v;
+	const TreeSchedule * S = F->sched;
+	/* L x = P' b, the tasks */
+#ifdef OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(S->nthreads) private(i, j, s, w, nr, R, v) \
+	if (S->ntasks > 1)
+#endif
+	for (t = 0; t < S->ntasks; ++t) {
+		v = &(V[getThreadNum() * F->maxRows]);
+		for (j = F->super[S->first[t]]; j < F->super[S->last[t] + 1]; ++j) {
+			x[j] = (float) b[P[j]];
+		}
+		for (s = S->first[t]; s <= S->last[t]; ++s) {
+			w = F->super[s + 1] - F->super[s];
+			nr = F->rowp[s + 1] - F->rowp[s];
+			R = &(F->rows[F->rowp[s]]);
+			forwardSupernodeSingle(F, xs, s, v, x);
+			for (i = w; i < S->split[s]; ++i) {
+				x[R[i]] += v[i];
+			}
+			memcpy(&(buf[S->bufp[s]]), &(v[S->split[s]]), (nr - S->split[s]) * sizeof(float));
+		}
+	}
+	/* the top rows */
+	v = V;
+	for (k = 0; k < S->ntop; ++k) {
+		for (j = F->super[S->top[k]]; j < F->super[S->top[k] + 1]; ++j) {
+			x[j] = (float) b[P[j]];
+		}
+	}
+	for (k = 0; k < S->nsweep; ++k) {
+		s = S->sweep[k];
+		nr = F->rowp[s + 1] - F->rowp[s];
+		R = &(F->rows[F->rowp[s]]);
+		if (S->taskOf[s] < 0) {
+			forwardSupernodeSingle(F, xs, s, v, x);
+		} else {
+			memcpy(&(v[S->split[s]]), &(buf[S->bufp[s]]), (nr - S->split[s]) * sizeof(float));
+		}
+		for (i = S->split[s]; i < nr; ++i) {
+			x[R[i]] += v[i];
+		}
+	}
+	/* L' x = D^-1 x, the top rows, then the tasks */
+	for (k = S->ntop - 1; k >= 0; --k) {
+		backwardSupernodeSingle(F, xs, S->top[k], Ds, P, v, x, b);
+	}
+#ifdef OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(S->nthreads) private(s) if (S->ntasks > 1)
+#endif
+	for (t = 0; t < S->ntasks; ++t) {
+		for (s = S->last[t]; s >= S->first[t]; --s) {
+			backwardSupernodeSingle(F, xs, s, Ds, P, &(V[getThreadNum() * F->maxRows]), x, b);
+		}
+	}
+}
+
+void superSolveBatch(const SuperFactor * F, const scs_float * D, scs_float * V, scs_float * X, scs_int ns) {
+	scs_int i, c, r, k0, k1, s, f, w, nr, *R;
+	scs_float l0, l1, l2, l3, *L, *vi, *vc, xr[SUPER_SOLVE_BLOCK][SUPER_BATCH_MAX], t[SUPER_SOLVE_BLOCK][SUPER_BATCH_MAX];
+	/* L x = b */
+	for (s = 0; s < F->nsuper; ++s) {
+		f = F->super[s];
+		w = F->super[s + 1] - f;
+		nr = F->rowp[s + 1] - F->rowp[s];
+		R = &(F->rows[F->rowp[s]]);
+		L = &(F->x[F->xp[s]]);
+		memcpy(V, &(X[f * ns]), w * ns * sizeof(scs_float));
+		memset(&(V[w * ns]), 0, (nr - w) * ns * sizeof(scs_float));
+		for (k0 = 0; k0 < w; k0 = k1) {
+			k1 = MIN(k0 + SUPER_SOLVE_BLOCK, w);
+			for (c = k0; c < k1; ++c) {
+				memcpy(xr[c - k0], &(V[c * ns]), ns * sizeof(scs_float));
+				for (i = c + 1; i < k1; ++i) {
+					vi = &(V[i * ns]);
+					l0 = L[i + c * nr];
+					for (r = 0; r < ns; ++r) {
+						vi[r] -= l0 * xr[c - k0][r];
+					}
+				}
+			}
+			if (k1 - k0 == SUPER_SOLVE_BLOCK) {
+				for (i = k1; i < nr; ++i) {
+					vi = &(V[i * ns]);
+					l0 = L[i + k0 * nr];
+					l1 = L[i + (k0 + 1) * nr];
+					l2 = L[i + (k0 + 2) * nr];
+					l3 = L[i + (k0 + 3) * nr];
+					for (r = 0; r < ns; r += 2) {
+						vi[r] = vi[r] - l0 * xr[0][r] - l1 * xr[1][r] - l2 * xr[2][r] - l3 * xr[3][r];
+						vi[r + 1] = vi[r + 1] - l0 * xr[0][r + 1] - l1 * xr[1][r + 1] - l2 * xr[2][r + 1]
+								- l3 * xr[3][r + 1];
+					}
+				}
+			} else {
+				for (c = k0; c < k1; ++c) {
+					for (i = k1; i < nr; ++i) {
+						vi = &(V[i * ns]);
+						l0 = L[i + c * nr];
+						for (r = 0; r < ns; ++r) {
+							vi[r] -= l0 * xr[c - k0][r];
+						}
+					}
+				}
+			}
+		}
+		memcpy(&(X[f * ns]), V, w * ns * sizeof(scs_float));
+		for (i = w; i < nr; ++i) {
+			vi = &(X[R[i] * ns]);
+			for (r = 0; r < ns; ++r) {
+				vi[r] += V[i * ns + r];
+			}
+		}
+	}
+	/* D x = b */
+	for (i = 0; i < F->n; ++i) {
+		for (r = 0; r < ns; ++r) {
+			X[i * ns + r] /= D[i];
+		}
+	}
+	/* L' x = b */
+	for (s = F->nsuper - 1; s >= 0; --s) {
+		f = F->super[s];
+		w = F->super[s + 1] - f;
+		nr = F->rowp[s + 1] - F->rowp[s];
+		R = &(F->rows[F->rowp[s]]);
+		L = &(F->x[F->xp[s]]);
+		memcpy(V, &(X[f * ns]), w * ns * sizeof(scs_float));
+		for (i = w; i < nr; ++i) {
+			memcpy(&(V[i * ns]), &(X[R[i] * ns]), ns * sizeof(scs_float));
+		}
+		for (k0 = (w - 1) / SUPER_SOLVE_BLOCK * SUPER_SOLVE_BLOCK; k0 >= 0; k0 -= SUPER_SOLVE_BLOCK) {
+			k1 = MIN(k0 + SUPER_SOLVE_BLOCK, w);
+			memset(t, 0, sizeof(t));
+			if (k1 - k0 == SUPER_SOLVE_BLOCK) {
+				for (i = k1; i < nr; ++i) {
+					vi = &(V[i * ns]);
+					l0 = L[i + k0 * nr];
+					l1 = L[i + (k0 + 1) * nr];
+					l2 = L[i + (k0 + 2) * nr];
+					l3 = L[i + (k0 + 3) * nr];
+					for (r = 0; r < ns; ++r) {
+						t[0][r] += l0 * vi[r];
+						t[1][r] += l1 * vi[r];
+						t[2][r] += l2 * vi[r];
+						t[3][r] += l3 * vi[r];
+					}
+				}
+			} else {
+				for (c = k0; c < k1; ++c) {
+					for (i = k1; i < nr; ++i) {
+						vi = &(V[i * ns]);
+						l0 = L[i + c * nr];
+						for (r = 0; r < ns; ++r) {
+							t[c - k0][r] += l0 * vi[r];
+						}
+					}
+				}
+			}
+			for (c = k1 - 1; c >= k0; --c) {
+				vc = &(V[c * ns]);
+				for (r = 0; r < ns; ++r) {
+					xr[0][r] = vc[r] - t[c - k0][r];
+				}
+				for (i = c + 1; i < k1; ++i) {
+					vi = &(V[i * ns]);
+					l0 = L[i + c * nr];
+					for (r = 0; r < ns; ++r) {
+						xr[0][r] -= l0 * vi[r];
+					}
+				}
+				memcpy(vc, xr[0], ns * sizeof(scs_float));
+			}
+		}
+		memcpy(&(X[f * ns]), V, w * ns * sizeof(scs_float));
+	}
+}
+
+scs_int superToCsc(const SuperFactor * F, cs * L) {
+	scs_int i, k, s, f, w, nr, *R, nz = 0;
+	scs_float * Ls;
+	if (!L->p) {
+		L->p = scs_malloc((F->n + 1) * sizeof(scs_int));
+		L->i = scs_malloc(MAX(F->nnz, 1) * sizeof(scs_int));
+		L->x = scs_malloc(MAX(F->nnz, 1) * sizeof(scs_float));
+		L->nzmax = F->nnz;
+		if (!L->p || !L->i || !L->x) {
+			return -1;
+		}
+	}
+	for (s = 0; s < F->nsuper; ++s) {
+		f = F->super[s];
+		w = F->super[s + 1] - f;
+		nr = F->rowp[s + 1] - F->rowp[s];
+		R = &(F->rows[F->rowp[s]]);
+		Ls = &(F->x[F->xp[s]]);
+		for (k = 0; k < w; ++k) {
+			L->p[f + k] = nz;
+			for (i = k + 1; i < nr; ++i) {
+				L->i[nz] = R[i];
+				L->x[nz++] = Ls[i + k * nr];
+			}
+		}
+	}
+	L->p[F->n] = nz;
+	return 0;
+}
+
+void superFree(SuperFactor * F) {
+	if (F) {
+		if (F->super)
+			scs_free(F->super);
+		if (F->colSuper)
+			scs_free(F->colSuper);
+		if (F->rowp)
+			scs_free(F->rowp);
+		if (F->rows)
+			scs_free(F->rows);
+		if (F->xp)
+			scs_free(F->xp);
+		if (F->x)
+			scs_free(F->x);
+		freeSchedule(F->sched);
+		scs_free(F);
+	}
+}
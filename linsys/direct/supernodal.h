@@ -0,0 +1,72 @@
+#ifndef SUPERNODAL_H_GUARD
+#define SUPERNODAL_H_GUARD
+
+#include "glbopts.h"
+#include "scs.h"
+#include "cs.h"
+
+/* max number of right-hand sides of superSolveBatch */
+#define SUPER_BATCH_MAX 16
+
+/* schedule of the numeric factorization and the triangular solves over an elimination tree (of columns or of
+ * supernodes) numbered in postorder: the tasks are ranges of nodes made of whole subtrees, independent of each other
+ * and run in parallel, the top nodes are their ancestors and run on one thread after (before, in the backward solve)
+ * them. with one thread everything is one task */
+typedef struct TREE_SCHEDULE {
+	scs_int nthreads;
+	scs_int ntasks, * first, * last; /* task t is the nodes first[t] to last[t] */
+	scs_int ntop, * top; /* the nodes in no task, ascending */
+	scs_int * taskOf; /* task of each node, -1 for the top nodes */
+	/* filled in by the solver: the entries (or rows) of node j in top rows start at split[j], the forward solve
+	 * finishes with the nodes sweep[0] to sweep[nsweep - 1] (ascending), the top nodes and those with entries in top
+	 * rows. the supernodal solve keeps the updates of the top rows from the tasks at buf + bufp[s] */
+	scs_int * split, nsweep, * sweep, * bufp;
+	scs_float * buf;
+} TreeSchedule;
+
+/* supernodal LDL' factorization of a quasi-definite matrix (no pivoting): consecutive columns of L with the same
+ * pattern below their diagonal block (up to a few relaxed zeros) form a supernode, stored as a dense column-major
+ * block of its rows and factored and solved with dense (BLAS-3 when available) kernels */
+typedef struct SUPERNODAL_FACTOR {
+	scs_int n; /* dimension */
+	scs_int nsuper; /* number of supernodes */
+	scs_int * super; /* supernode s is the columns super[s] to super[s + 1] - 1 (size nsuper + 1) */
+	scs_int * colSuper; /* supernode of each column (size n) */
+	scs_int * rowp, * rows; /* rows[rowp[s]] to rows[rowp[s + 1] - 1] are the rows of supernode s, its columns first */
+	scs_int * xp; /* supernode s is the (rowp[s + 1] - rowp[s]) x (super[s + 1] - super[s]) block at x + xp[s] */
+	scs_float * x;
+	scs_int maxRows, maxCols; /* largest supernode, sizes the solve and factorization workspace */
+	scs_int nnz; /* entries of L stored below the diagonal, including the relaxed zeros */
+	TreeSchedule * sched; /* of superNumeric and superSolve, over the tree of supernodes */
+} SuperFactor;
+
+/* post[k] is the k-th column of the postorder of the elimination tree Parent of an n x n matrix */
+void superPostorder(scs_int n, const scs_int * Parent, scs_int * post);
+/* schedule of the solves over the postordered tree Parent of n nodes with work[j] at node j, for nthreads threads,
+ * or one if the tasks would be too small or leave too much on top. split, sweep, bufp and buf are left to the solver */
+TreeSchedule * treeSchedule(scs_int n, const scs_int * Parent, const scs_int * work, scs_int nthreads);
+void freeSchedule(TreeSchedule * S);
+/* whether the factor with column counts Lnz is dense enough for the supernodal factorization to be faster */
+scs_int superWorthwhile(scs_int n, const scs_int * Lnz);
+/* supernodes of the upper triangular C with elimination tree Parent and column counts Lnz (from LDL_symbolic) */
+SuperFactor * superSymbolic(const cs * C, const scs_int * Parent, const scs_int * Lnz);
+/* numeric factorization of C = L D L' into F and D, reuses the symbolic analysis and the schedule, returns -1 on a
+ * zero pivot. the same operations in the same order on any number of threads */
+scs_int superNumeric(const cs * C, SuperFactor * F, scs_float * D);
+/* schedules superNumeric and superSolve for nthreads threads, before superNumeric */
+scs_int superSchedule(SuperFactor * F, scs_int nthreads);
+/* solves P L D L' P' x = b for x, in place in b, with workspace x of size F->n and V of size F->maxRows per thread */
+void superSolve(const SuperFactor * F, const scs_float * D, const scs_int * P, scs_float * V, scs_float * x,
+		scs_float * b);
+/* superSolve with the single precision copies xs of F->x and Ds of D, all arithmetic in single precision, with
+ * workspace x of size F->n, V of size F->maxRows per thread and buf of size F->sched->bufp[F->nsuper] */
+void superSolveSingle(const SuperFactor * F, const float * xs, const float * Ds, const scs_int * P, float * V,
+		float * buf, float * x, scs_float * b);
+/* L D L' x = b (without the permutation) for an even ns <= SUPER_BATCH_MAX right-hand sides interleaved in X (entry j of rhs r at X[j * ns + r]), with
+ * workspace V of size F->maxRows * ns. for each right-hand side the same operations in the same order as superSolve */
+void superSolveBatch(const SuperFactor * F, const scs_float * D, scs_float * V, scs_float * X, scs_int ns);
+/* copies F to the column compressed L (strictly lower part, allocated on the first call) for the simplicial solves */
+scs_int superToCsc(const SuperFactor * F, cs * L);
+void superFree(SuperFactor * F);
+
+#endif
@@ -3,10 +3,8 @@
 #define CG_BEST_TOL 1e-9
 #define CG_MIN_TOL 1e-1
 #define PRINT_INTERVAL 100
-
-static scs_int totCgIts;
-static timer linsysTimer;
-static scs_float totalSolveTime;
+/* max number of right-hand sides solved together, each CG step does one pass over A and A' for all of them */
+#define BATCH_BLOCK 16
 
 char * getLinSysMethod(const AMatrix * A, const Settings * s) {
 	char * str = scs_malloc(sizeof(char) * 128);
@@ -17,12 +15,23 @@ char * getLinSysMethod(const AMatrix * A, const Settings * s) {
 char * getLinSysSummary(Priv * p, const Info * info) {
 	char * str = scs_malloc(sizeof(char) * 128);
 	sprintf(str, "\tLin-sys: avg # CG iterations: %2.2f, avg solve time: %1.2es\n",
-			(scs_float ) totCgIts / (info->iter + 1), totalSolveTime / (info->iter + 1) / 1e3);
-	totCgIts = 0;
-	totalSolveTime = 0;
+			(scs_float ) info->cgIters / (info->iter + 1), info->linSysTime / (info->iter + 1) / 1e3);
 	return str;
 }
 
+void getLinSysInfo(Priv * p, Info * info) {
+	info->linSysTime = p->totalSolveTime;
+	info->spmvTime = p->totalSpmvTime;
+	info->cgIters = p->totCgIts;
+	info->orderingTime = 0;
+	info->factorTime = p->factorTime;
+	info->nnzL = 0;
+	info->factorCacheHit = -1;
+	p->totCgIts = 0;
+	p->totalSolveTime = 0;
+	p->totalSpmvTime = 0;
+}
+
 /* M = inv ( diag ( RHO_X * I + A'A ) ) */
 void getPreconditioner(const AMatrix * A, const Settings * stgs, Priv * p) {
 	scs_int i;
@@ -108,26 +117,77 @@ void freePriv(Priv * p) {
 			scs_free(p->z);
 		if (p->M)
 			scs_free(p->M);
+		if (p->batch)
+			scs_free(p->batch);
+		if (p->Axs)
+			scs_free(p->Axs);
+		if (p->Atxs)
+			scs_free(p->Atxs);
 		scs_free(p);
 	}
 }
 
+/* y += A'x with single precision values of A (A has n columns), same order of operations as _accumByAtrans */
+static void accumByAtransSingle(scs_int n, const float * Ax, const scs_int * Ai, const scs_int * Ap,
+		const scs_float * x, scs_float * y) {
+	scs_int p, j;
+	scs_float yj;
+#ifdef OPENMP
+#pragma omp parallel for private(p,yj)
+#endif
+	for (j = 0; j < n; j++) {
+		yj = y[j];
+		for (p = Ap[j]; p < Ap[j + 1]; p++) {
+			yj += Ax[p] * x[Ai[p]];
+		}
+		y[j] = yj;
+	}
+}
+
+/* the products with A' and A inside solveLinSys, with the single precision values when p->single is set */
+static void solveAccumByAtrans(const AMatrix * A, Priv * p, const scs_float *x, scs_float *y) {
+	timer spmvTimer;
+	if (!p->single) {
+		accumByAtrans(A, p, x, y);
+		return;
+	}
+	tic(&spmvTimer);
+	accumByAtransSingle(A->n, p->Axs, A->i, A->p, x, y);
+	p->totalSpmvTime += tocq(&spmvTimer);
+}
+static void solveAccumByA(const AMatrix * A, Priv * p, const scs_float *x, scs_float *y) {
+	timer spmvTimer;
+	if (!p->single) {
+		accumByA(A, p, x, y);
+		return;
+	}
+	tic(&spmvTimer);
+	accumByAtransSingle(p->At->n, p->Atxs, p->At->i, p->At->p, x, y);
+	p->totalSpmvTime += tocq(&spmvTimer);
+}
+
 /* solves (I+A'A)x = b, s warm start, solution stored in b */
 /*y = (RHO_X * I + A'A)x */
 static void matVec(const AMatrix * A, const Settings * s, Priv * p, const scs_float * x, scs_float * y) {
 	scs_float * tmp = p->tmp;
 	memset(tmp, 0, A->m * sizeof(scs_float));
-	accumByA(A, p, x, tmp);
+	solveAccumByA(A, p, x, tmp);
 	memset(y, 0, A->n * sizeof(scs_float));
-	accumByAtrans(A, p, tmp, y);
+	solveAccumByAtrans(A, p, tmp, y);
 	addScaledArray(y, x, A->n, s->rho_x);
 }
 
 void accumByAtrans(const AMatrix * A, Priv * p, const scs_float *x, scs_float *y) {
+	timer spmvTimer;
+	tic(&spmvTimer);
 	_accumByAtrans(A->n, A->x, A->i, A->p, x, y);
+	p->totalSpmvTime += tocq(&spmvTimer);
 }
 void accumByA(const AMatrix * A, Priv * p, const scs_float *x, scs_float *y) {
+	timer spmvTimer;
+	tic(&spmvTimer);
 	_accumByAtrans(p->At->n, p->At->x, p->At->i, p->At->p, x, y);
+	p->totalSpmvTime += tocq(&spmvTimer);
 }
 static void applyPreConditioner(scs_float * M, scs_float * z, scs_float * r, scs_int n, scs_float *ipzr) {
 	scs_int i;
@@ -140,6 +200,7 @@ static void applyPreConditioner(scs_float * M, scs_float * z, scs_float * r, scs
 
 Priv * initPriv(const AMatrix * A, const Settings * stgs) {
 	Priv * p = scs_calloc(1, sizeof(Priv));
+	timer factorTimer;
 	p->p = scs_malloc((A->n) * sizeof(scs_float));
 	p->r = scs_malloc((A->n) * sizeof(scs_float));
 	p->Gp = scs_malloc((A->n) * sizeof(scs_float));
@@ -152,15 +213,18 @@ Priv * initPriv(const AMatrix * A, const Settings * stgs) {
 	p->At->i = scs_malloc((A->p[A->n]) * sizeof(scs_int));
 	p->At->p = scs_malloc((A->m + 1) * sizeof(scs_int));
 	p->At->x = scs_malloc((A->p[A->n]) * sizeof(scs_float));
+	tic(&factorTimer);
 	transpose(A, p);
 
 	/* preconditioner memory */
 	p->z = scs_malloc((A->n) * sizeof(scs_float));
 	p->M = scs_malloc((A->n) * sizeof(scs_float));
 	getPreconditioner(A, stgs, p);
+	p->factorTime = tocq(&factorTimer);
 
-	totalSolveTime = 0;
-	totCgIts = 0;
+	p->totalSolveTime = 0;
+	p->totalSpmvTime = 0;
+	p->totCgIts = 0;
 	if (!p->p || !p->r || !p->Gp || !p->tmp || !p->At || !p->At->i || !p->At->p || !p->At->x) {
 		freePriv(p);
 		return SCS_NULL;
@@ -168,6 +232,41 @@ Priv * initPriv(const AMatrix * A, const Settings * stgs) {
 	return p;
 }
 
+/* rounds the values of A and A' to the single precision copies */
+static void demoteA(const AMatrix * A, Priv * p) {
+	scs_int j;
+	for (j = 0; j < A->p[A->n]; ++j) {
+		p->Axs[j] = (float) A->x[j];
+		p->Atxs[j] = (float) p->At->x[j];
+	}
+}
+
+scs_int setLinSysPrecision(const AMatrix * A, Priv * p, scs_int single) {
+	if (single && !p->Axs) {
+		p->Axs = scs_malloc(A->p[A->n] * sizeof(float));
+		p->Atxs = scs_malloc(A->p[A->n] * sizeof(float));
+		if (!p->Axs || !p->Atxs) {
+			return -1;
+		}
+		demoteA(A, p);
+	}
+	p->single = single;
+	return 0;
+}
+
+/* A values or rho_x changed, same sparsity pattern: refresh A transpose and preconditioner */
+scs_int updateLinSys(const AMatrix * A, const Settings * stgs, Priv * p) {
+	timer factorTimer;
+	tic(&factorTimer);
+	transpose(A, p);
+	getPreconditioner(A, stgs, p);
+	if (p->Axs) {
+		demoteA(A, p);
+	}
+	p->factorTime += tocq(&factorTimer);
+	return 0;
+}
+
 static scs_int pcg(const AMatrix * A, const Settings * stgs, Priv * pr, const scs_float * s, scs_float * b, scs_int max_its,
 		scs_float tol) {
 	scs_int i, n = A->n;
@@ -219,26 +318,278 @@ static scs_int pcg(const AMatrix * A, const Settings * stgs, Priv * pr, const sc
 
 scs_int solveLinSys(const AMatrix * A, const Settings * stgs, Priv * p, scs_float * b, const scs_float * s, scs_int iter) {
 	scs_int cgIts;
+	timer linsysTimer;
 	scs_float cgTol = calcNorm(b, A->n)
 			* (iter < 0 ? CG_BEST_TOL : CG_MIN_TOL / POWF((scs_float) iter + 1, stgs->cg_rate));
 
 	tic(&linsysTimer);
 	/* solves Mx = b, for x but stores result in b */
 	/* s contains warm-start (if available) */
-	accumByAtrans(A, p, &(b[A->n]), b);
+	solveAccumByAtrans(A, p, &(b[A->n]), b);
 	/* solves (I+A'A)x = b, s warm start, solution stored in b */
 	cgIts = pcg(A, stgs, p, s, b, A->n, MAX(cgTol, CG_BEST_TOL));
 	scaleArray(&(b[A->n]), -1, A->m);
-	accumByA(A, p, b, &(b[A->n]));
+	solveAccumByA(A, p, b, &(b[A->n]));
 
 	if (iter >= 0) {
-		totCgIts += cgIts;
+		p->totCgIts += cgIts;
 	}
 
-	totalSolveTime += tocq(&linsysTimer);
+	p->totalSolveTime += tocq(&linsysTimer);
 #if EXTRAVERBOSE > 0
 	scs_printf("linsys solve time: %1.2es\n", tocq(&linsysTimer) / 1e3);
 #endif
 	return 0;
 }
 
+/* y += A'x for nrhs interleaved vectors (entry i of vector r at x[i * nrhs + r]), only for the vectors listed in act,
+ * A has n columns in column compressed format, same order of operations as _accumByAtrans for each vector */
+static void accumByAtransBatch(Priv * p, scs_int n, const scs_float * Ax, const scs_int * Ai, const scs_int * Ap,
+		const scs_float * x, scs_float * y, scs_int nrhs, const scs_int * act, scs_int nAct) {
+	scs_int j, k, a;
+	scs_float akj, *yj;
+	const scs_float * xk;
+	timer spmvTimer;
+	tic(&spmvTimer);
+#ifdef OPENMP
+#pragma omp parallel for private(k,a,akj,xk,yj)
+#endif
+	for (j = 0; j < n; ++j) {
+		yj = &(y[j * nrhs]);
+		for (k = Ap[j]; k < Ap[j + 1]; ++k) {
+			akj = Ax[k];
+			xk = &(x[Ai[k] * nrhs]);
+			if (nAct == nrhs) {
+				/* no vector has dropped out, contiguous access */
+				for (a = 0; a < nrhs; ++a) {
+					yj[a] += akj * xk[a];
+				}
+			} else {
+				for (a = 0; a < nAct; ++a) {
+					yj[act[a]] += akj * xk[act[a]];
+				}
+			}
+		}
+	}
+	p->totalSpmvTime += tocq(&spmvTimer);
+}
+
+/* y = (RHO_X * I + A'A)x for the interleaved vectors listed in act */
+static void matVecBatch(const AMatrix * A, const Settings * s, Priv * p, const scs_float * x, scs_float * y,
+		scs_float * tmp, scs_int nrhs, const scs_int * act, scs_int nAct) {
+	scs_int i, a;
+	for (i = 0; i < A->m; ++i) {
+		for (a = 0; a < nAct; ++a) {
+			tmp[i * nrhs + act[a]] = 0;
+		}
+	}
+	accumByAtransBatch(p, p->At->n, p->At->x, p->At->i, p->At->p, x, tmp, nrhs, act, nAct);
+	for (i = 0; i < A->n; ++i) {
+		for (a = 0; a < nAct; ++a) {
+			y[i * nrhs + act[a]] = 0;
+		}
+	}
+	accumByAtransBatch(p, A->n, A->x, A->i, A->p, tmp, y, nrhs, act, nAct);
+	for (i = 0; i < A->n; ++i) {
+		for (a = 0; a < nAct; ++a) {
+			y[i * nrhs + act[a]] += s->rho_x * x[i * nrhs + act[a]];
+		}
+	}
+}
+
+/* nrm[r] = ||x_r||_2 for the interleaved vectors listed in act */
+static void calcNormBatch(const scs_float * x, scs_int n, scs_int nrhs, const scs_int * act, scs_int nAct,
+		scs_float * nrm) {
+	scs_int i, a;
+	for (a = 0; a < nAct; ++a) {
+		nrm[act[a]] = 0;
+	}
+	for (i = 0; i < n; ++i) {
+		for (a = 0; a < nAct; ++a) {
+			nrm[act[a]] += x[i * nrhs + act[a]] * x[i * nrhs + act[a]];
+		}
+	}
+	for (a = 0; a < nAct; ++a) {
+		nrm[act[a]] = SQRTF(nrm[act[a]]);
+	}
+}
+
+static void applyPreConditionerBatch(const scs_float * M, scs_float * z, const scs_float * r, scs_int n, scs_int nrhs,
+		const scs_int * act, scs_int nAct, scs_float * ipzr) {
+	scs_int i, a, j;
+	for (a = 0; a < nAct; ++a) {
+		ipzr[act[a]] = 0;
+	}
+	for (i = 0; i < n; ++i) {
+		for (a = 0; a < nAct; ++a) {
+			j = i * nrhs + act[a];
+			z[j] = r[j] * M[i];
+			ipzr[act[a]] += z[j] * r[j];
+		}
+	}
+}
+
+/* drops the vectors whose residual norm is below tol from act, sets their iteration count, returns new nAct */
+static scs_int dropConverged(scs_int * act, scs_int nAct, const scs_float * nrm, const scs_float * tol, scs_int * its,
+		scs_int i) {
+	scs_int a = 0;
+	while (a < nAct) {
+		if (nrm[act[a]] < tol[act[a]]) {
+			its[act[a]] = i;
+			act[a] = act[--nAct];
+		} else {
+			++a;
+		}
+	}
+	return nAct;
+}
+
+/* pcg run independently on nrhs interleaved right-hand sides in x (solutions stored in x), vectors drop out of the
+ * shared matrix-vector products as they converge, its[r] is set to the number of CG iterations for vector r */
+static void pcgBatch(const AMatrix * A, const Settings * stgs, Priv * pr, const scs_float ** s, scs_float * x,
+		scs_int nrhs, scs_int max_its, const scs_float * tol, scs_int * its) {
+	scs_int i, j, a, r, n = A->n, nAct = nrhs, act[BATCH_BLOCK];
+	scs_float ipzr[BATCH_BLOCK], ipzrOld[BATCH_BLOCK], alpha[BATCH_BLOCK], tmpTol[BATCH_BLOCK];
+	scs_float *res = &(x[n * nrhs]); /* cg residuals */
+	scs_float *z = &(res[n * nrhs]); /* for preconditioning */
+	scs_float *p = &(z[n * nrhs]); /* cg directions */
+	scs_float *Gp = &(p[n * nrhs]); /* updated cg directions */
+	scs_float *tmp = &(Gp[n * nrhs]); /* size m * nrhs */
+
+	for (r = 0; r < nrhs; ++r) {
+		act[r] = r;
+		tmpTol[r] = MIN(tol[r], 1e-18);
+	}
+	if (s == SCS_NULL) {
+		memcpy(res, x, n * nrhs * sizeof(scs_float));
+		memset(x, 0, n * nrhs * sizeof(scs_float));
+	} else {
+		for (i = 0; i < n; ++i) {
+			for (r = 0; r < nrhs; ++r) {
+				p[i * nrhs + r] = s[r][i];
+			}
+		}
+		matVecBatch(A, stgs, pr, p, res, tmp, nrhs, act, nAct);
+		for (j = 0; j < n * nrhs; ++j) {
+			res[j] = -(res[j] - x[j]);
+		}
+		memcpy(x, p, n * nrhs * sizeof(scs_float));
+	}
+
+	/* check to see if we need to run CG at all */
+	calcNormBatch(res, n, nrhs, act, nAct, alpha);
+	nAct = dropConverged(act, nAct, alpha, tmpTol, its, 0);
+
+	applyPreConditionerBatch(pr->M, z, res, n, nrhs, act, nAct, ipzr);
+	memcpy(p, z, n * nrhs * sizeof(scs_float));
+
+	for (i = 0; i < max_its && nAct > 0; ++i) {
+		matVecBatch(A, stgs, pr, p, Gp, tmp, nrhs, act, nAct);
+		for (a = 0; a < nAct; ++a) {
+			alpha[act[a]] = 0;
+		}
+		for (j = 0; j < n; ++j) {
+			for (a = 0; a < nAct; ++a) {
+				alpha[act[a]] += p[j * nrhs + act[a]] * Gp[j * nrhs + act[a]];
+			}
+		}
+		for (a = 0; a < nAct; ++a) {
+			alpha[act[a]] = ipzr[act[a]] / alpha[act[a]];
+		}
+		for (j = 0; j < n; ++j) {
+			for (a = 0; a < nAct; ++a) {
+				r = act[a];
+				x[j * nrhs + r] += alpha[r] * p[j * nrhs + r];
+				res[j * nrhs + r] += -alpha[r] * Gp[j * nrhs + r];
+			}
+		}
+
+		calcNormBatch(res, n, nrhs, act, nAct, alpha);
+		nAct = dropConverged(act, nAct, alpha, tol, its, i + 1);
+
+		for (a = 0; a < nAct; ++a) {
+			ipzrOld[act[a]] = ipzr[act[a]];
+		}
+		applyPreConditionerBatch(pr->M, z, res, n, nrhs, act, nAct, ipzr);
+		for (a = 0; a < nAct; ++a) {
+			alpha[act[a]] = ipzr[act[a]] / ipzrOld[act[a]];
+		}
+		for (j = 0; j < n; ++j) {
+			for (a = 0; a < nAct; ++a) {
+				r = act[a];
+				p[j * nrhs + r] = p[j * nrhs + r] * alpha[r] + z[j * nrhs + r];
+			}
+		}
+	}
+	for (a = 0; a < nAct; ++a) {
+		its[act[a]] = i;
+	}
+}
+
+/* solveLinSys for nrhs <= BATCH_BLOCK right-hand sides, returns total number of CG iterations */
+static scs_int solveLinSysBlock(const AMatrix * A, const Settings * stgs, Priv * p, scs_float ** b,
+		const scs_float ** s, scs_int nrhs, scs_int iter) {
+	scs_int i, r, n = A->n, m = A->m, cgIts = 0, act[BATCH_BLOCK], its[BATCH_BLOCK];
+	scs_float tol[BATCH_BLOCK];
+	scs_float *x = p->batch, *y = &(x[(5 * n + m) * nrhs]);
+	for (r = 0; r < nrhs; ++r) {
+		act[r] = r;
+		tol[r] = calcNorm(b[r], n) * (iter < 0 ? CG_BEST_TOL : CG_MIN_TOL / POWF((scs_float) iter + 1, stgs->cg_rate));
+		tol[r] = MAX(tol[r], CG_BEST_TOL);
+	}
+	for (i = 0; i < n; ++i) {
+		for (r = 0; r < nrhs; ++r) {
+			x[i * nrhs + r] = b[r][i];
+		}
+	}
+	for (i = 0; i < m; ++i) {
+		for (r = 0; r < nrhs; ++r) {
+			y[i * nrhs + r] = b[r][n + i];
+		}
+	}
+	accumByAtransBatch(p, A->n, A->x, A->i, A->p, y, x, nrhs, act, nrhs);
+	pcgBatch(A, stgs, p, s, x, nrhs, n, tol, its);
+	for (i = 0; i < m * nrhs; ++i) {
+		y[i] = -y[i];
+	}
+	accumByAtransBatch(p, p->At->n, p->At->x, p->At->i, p->At->p, x, y, nrhs, act, nrhs);
+	for (i = 0; i < n; ++i) {
+		for (r = 0; r < nrhs; ++r) {
+			b[r][i] = x[i * nrhs + r];
+		}
+	}
+	for (i = 0; i < m; ++i) {
+		for (r = 0; r < nrhs; ++r) {
+			b[r][n + i] = y[i * nrhs + r];
+		}
+	}
+	for (r = 0; r < nrhs; ++r) {
+		cgIts += its[r];
+	}
+	return cgIts;
+}
+
+scs_int solveLinSysBatch(const AMatrix * A, const Settings * stgs, Priv * p, scs_float ** b, const scs_float ** s,
+		scs_int nrhs, scs_int iter) {
+	scs_int j, cgIts = 0;
+	timer linsysTimer;
+	tic(&linsysTimer);
+	if (!p->batch) {
+		/* x, residual, z, p, Gp (size n each), tmp and y (size m each) for BATCH_BLOCK vectors */
+		p->batch = scs_malloc((5 * A->n + 2 * A->m) * BATCH_BLOCK * sizeof(scs_float));
+		if (!p->batch) {
+			return -1;
+		}
+	}
+	for (j = 0; j < nrhs; j += BATCH_BLOCK) {
+		cgIts += solveLinSysBlock(A, stgs, p, &(b[j]), s ? &(s[j]) : SCS_NULL, MIN(BATCH_BLOCK, nrhs - j), iter);
+	}
+	if (iter >= 0) {
+		p->totCgIts += cgIts;
+	}
+	p->totalSolveTime += tocq(&linsysTimer);
+#if EXTRAVERBOSE > 0
+	scs_printf("batch linsys solve time (%li right-hand sides): %1.2es\n", (long) nrhs, tocq(&linsysTimer) / 1e3);
+#endif
+	return 0;
+}
@@ -17,6 +17,15 @@ struct PRIVATE_DATA {
 	/* preconditioning */
 	scs_float * z;
 	scs_float * M;
+	/* workspace for multiple right-hand side solves, allocated on first use */
+	scs_float * batch;
+	/* single precision copies of the values of A and A' for mixed precision, allocated on first use */
+	float * Axs, * Atxs;
+	scs_int single; /* solveLinSys uses the single precision copies */
+	/* reporting */
+	scs_int totCgIts;
+	scs_float totalSolveTime, totalSpmvTime; /* since the last getLinSysInfo */
+	scs_float factorTime; /* A transpose and preconditioner setup since initPriv */
 };
 
 #endif
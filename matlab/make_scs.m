@@ -9,7 +9,7 @@ flags.LCFLAG = '-DMATLAB_MEX_FILE -DLAPACK_LIB_FOUND -DDLONG -DCTRLC=1 -DCOPYAMA
 flags.INCS = '';
 flags.LOCS = '';
 
-common_scs = '../src/linAlg.c ../src/cones.c ../src/cs.c ../src/util.c ../src/scs.c ../src/ctrlc.c ../linsys/common.c ../src/scs_version.c scs_mex.c';
+common_scs = '../src/linAlg.c ../src/cones.c ../src/cs.c ../src/util.c ../src/scs.c ../src/ctrlc.c ../linsys/common.c ../src/scs_version.c ../src/accel.c ../src/chordal.c scs_mex.c';
 if (~isempty (strfind (computer, '64')))
     flags.arr = '-largeArrayDims';
 else
@@ -12,8 +12,8 @@ function [x, y, s, info] = scs_direct(data, cone, params)
 % this uses the direct linear equation solver version of SCS
 %
 % K is product of cones in this particular order:
-% free cone, lp cone, second order cone(s), semi-definite cone(s), primal
-% exponential cones, dual exponential cones
+% free cone, lp cone, second order cone(s), semi-definite cone(s), complex
+% semi-definite cone(s), primal exponential cones, dual exponential cones
 %
 % data must consist of data.A, data.b, data.c, where A,b,c used as above.
 %  
@@ -22,8 +22,12 @@ function [x, y, s, info] = scs_direct(data, cone, params)
 % cone.l, length of lp cone
 % cone.q, array of SOC lengths
 % cone.s, array of SD lengths
+% cone.cs, array of complex Hermitian PSD lengths
 % cone.ep, number of primal exp cones
 % cone.ed, number of dual exp cones
+% cone.gpm, cone.gpn, cone.gpa, numbers of x and z entries of the generalized power
+%   cones prod(x.^a) >= norm(z) and their exponents a, one cone after another (optional)
+% cone.bl, cone.bu, lower and upper bounds of the box cone (optional, of equal length)
 %
 % Optional fields in the params struct are:
 %   alpha       : over-relaxation parameter, between (0,2).
@@ -33,6 +37,17 @@ function [x, y, s, info] = scs_direct(data, cone, params)
 %   verbose     : verbosity level (0 or 1)
 %   normalize   : heuristic data rescaling (0 or 1, off or on)
 %   scale       : rescales data up by this factor (only used if normalize=1)
+%   acceleration_lookback : memory depth for Anderson acceleration (0 disables)
+%   acceleration_type     : Anderson acceleration type, 1 or 2 (type-I or type-II)
+%   adaptive_scale        : max number of scale updates per solve (0 disables, only used if normalize=1)
+%   time_limit            : wall-clock limit per solve in milliseconds, returns the best iterate when hit (0 disables)
+%   mixed_precision       : bulk of the iterations with single precision linear system data, then double (0 or 1)
+%   sdp_warm_eig          : warm start the projections of large SD blocks from the previous eigenvectors (0 or 1)
+%   chordal_decomposition : split large sparse SD blocks into the cliques of a chordal extension (0 or 1, default 0)
+%   supernodal            : direct only, factor the KKT matrix in dense supernodal blocks if it fills in (0 or 1, default 1)
+%   normal_equations      : direct only, factor rho_x I + A'A instead if its factor is smaller (0 or 1, default 1)
+%   factor_cache          : direct only, directory of the on-disk factorization cache (string, default none)
+%   tree_parallel         : direct only, with OpenMP factor and solve independent subtrees in parallel (0 or 1, default 0)
 %
 % to warm-start the solver add guesses for (x, y, s) to the data struct
 %
@@ -38,23 +38,40 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
 	const mxArray *kl;
 	const mxArray *kq;
 	const mxArray *ks;
+	const mxArray *kcs;
 	const mxArray *kep;
 	const mxArray *ked;
 	const mxArray *kp;
+	const mxArray *kbl;
+	const mxArray *kbu;
+	const mxArray *kgpm;
+	const mxArray *kgpn;
+	const mxArray *kgpa;
 	const scs_float *q_mex;
     const scs_float *s_mex;
+    const scs_float *cs_mex;
     const scs_float *p_mex;
+    const scs_float *bl_mex;
+    const scs_float *gpm_mex;
+    const scs_float *gpn_mex;
+    const scs_float *gpa_mex;
+    scs_int gpaLen;
+    const scs_float *bu_mex;
     const size_t *q_dims;
     const size_t *s_dims;
+    const size_t *cs_dims;
     const size_t *p_dims;
 
 	const mxArray *cone;
 	const mxArray *settings;
 
 	const mwSize one[1] = { 1 };
-	const int numInfoFields = 11;
+	const int numInfoFields = 32;
 	const char * infoFields[] = { "iter", "status", "pobj", "dobj", "resPri", "resDual", "resInfeas", "resUnbdd",
-		"relGap", "setupTime", "solveTime" };
+		"relGap", "setupTime", "solveTime", "refactorizations", "singleIters", "linSysTime", "coneTime", "lpConeTime",
+		"socConeTime", "sdConeTime", "expConeTime", "powConeTime", "boxConeTime", "sdProjections", "sdPsdHits",
+		"sdNsdHits", "sdWarmEigs", "residualTime", "spmvTime", "cgIters", "orderingTime", "factorTime", "nnzL",
+		"factorCacheHit" };
 	mxArray *tmp;
 
 
@@ -145,6 +162,50 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
 	if (tmp != SCS_NULL)
 		d->stgs->normalize = (scs_int) *mxGetPr(tmp);
 
+	tmp = mxGetField(settings, 0, "acceleration_lookback");
+	if (tmp != SCS_NULL)
+		d->stgs->acceleration_lookback = (scs_int) *mxGetPr(tmp);
+
+	tmp = mxGetField(settings, 0, "acceleration_type");
+	if (tmp != SCS_NULL)
+		d->stgs->acceleration_type = (scs_int) *mxGetPr(tmp);
+
+	tmp = mxGetField(settings, 0, "adaptive_scale");
+	if (tmp != SCS_NULL)
+		d->stgs->adaptive_scale = (scs_int) *mxGetPr(tmp);
+
+	tmp = mxGetField(settings, 0, "time_limit");
+	if (tmp != SCS_NULL)
+		d->stgs->time_limit = (scs_float) *mxGetPr(tmp);
+
+	tmp = mxGetField(settings, 0, "mixed_precision");
+	if (tmp != SCS_NULL)
+		d->stgs->mixed_precision = (scs_int) *mxGetPr(tmp);
+
+	tmp = mxGetField(settings, 0, "sdp_warm_eig");
+	if (tmp != SCS_NULL)
+		d->stgs->sdp_warm_eig = (scs_int) *mxGetPr(tmp);
+
+	tmp = mxGetField(settings, 0, "chordal_decomposition");
+	if (tmp != SCS_NULL)
+		d->stgs->chordal_decomposition = (scs_int) *mxGetPr(tmp);
+
+	tmp = mxGetField(settings, 0, "supernodal");
+	if (tmp != SCS_NULL)
+		d->stgs->supernodal = (scs_int) *mxGetPr(tmp);
+
+	tmp = mxGetField(settings, 0, "normal_equations");
+	if (tmp != SCS_NULL)
+		d->stgs->normal_equations = (scs_int) *mxGetPr(tmp);
+
+	tmp = mxGetField(settings, 0, "factor_cache");
+	if (tmp != SCS_NULL && mxIsChar(tmp))
+		d->stgs->factor_cache = mxArrayToString(tmp);
+
+	tmp = mxGetField(settings, 0, "tree_parallel");
+	if (tmp != SCS_NULL)
+		d->stgs->tree_parallel = (scs_int) *mxGetPr(tmp);
+
 	/* cones */
 	kf = mxGetField(cone, 0, "f");
 	if (kf && !mxIsEmpty(kf))
@@ -206,6 +267,24 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
 		k->s = SCS_NULL;
 	}
 
+	kcs = mxGetField(cone, 0, "cs");
+	if (kcs && !mxIsEmpty(kcs)) {
+		cs_mex = mxGetPr(kcs);
+		ns = (scs_int) mxGetNumberOfDimensions(kcs);
+		cs_dims = mxGetDimensions(kcs);
+		k->cssize = (scs_int) cs_dims[0];
+		if (ns > 1 && cs_dims[0] == 1) {
+			k->cssize = (scs_int) cs_dims[1];
+		}
+		k->cs = mxMalloc(sizeof(scs_int) * k->cssize);
+		for (i = 0; i < k->cssize; i++) {
+			k->cs[i] = (scs_int) cs_mex[i];
+		}
+	} else {
+		k->cssize = 0;
+		k->cs = SCS_NULL;
+	}
+
     kp = mxGetField(cone, 0, "p");
     if (kp && !mxIsEmpty(kp)) {
         p_mex = mxGetPr(kp);
@@ -224,6 +303,58 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
         k->p = SCS_NULL;
     }
 
+    kbl = mxGetField(cone, 0, "bl");
+    kbu = mxGetField(cone, 0, "bu");
+    if (kbl && !mxIsEmpty(kbl) && kbu && !mxIsEmpty(kbu)) {
+        if (mxGetNumberOfElements(kbl) != mxGetNumberOfElements(kbu)) {
+            mexErrMsgTxt("cone.bl and cone.bu must have the same length");
+        }
+        bl_mex = mxGetPr(kbl);
+        bu_mex = mxGetPr(kbu);
+        /* the box cone has a row for t before the bounded ones */
+        k->bsize = (scs_int) mxGetNumberOfElements(kbl) + 1;
+        k->bl = mxMalloc(sizeof(scs_float) * (k->bsize - 1));
+        k->bu = mxMalloc(sizeof(scs_float) * (k->bsize - 1));
+        for (i = 0; i < k->bsize - 1; i++) {
+            k->bl[i] = (scs_float) bl_mex[i];
+            k->bu[i] = (scs_float) bu_mex[i];
+        }
+    } else {
+        k->bsize = 0;
+        k->bl = k->bu = SCS_NULL;
+    }
+
+    kgpm = mxGetField(cone, 0, "gpm");
+    kgpn = mxGetField(cone, 0, "gpn");
+    kgpa = mxGetField(cone, 0, "gpa");
+    if (kgpm && !mxIsEmpty(kgpm)) {
+        if (!kgpn || !kgpa || mxGetNumberOfElements(kgpn) != mxGetNumberOfElements(kgpm)) {
+            mexErrMsgTxt("cone.gpm and cone.gpn must have the same length, with the exponents in cone.gpa");
+        }
+        gpm_mex = mxGetPr(kgpm);
+        gpn_mex = mxGetPr(kgpn);
+        gpa_mex = mxGetPr(kgpa);
+        k->gpsize = (scs_int) mxGetNumberOfElements(kgpm);
+        k->gpm = mxMalloc(sizeof(scs_int) * k->gpsize);
+        k->gpn = mxMalloc(sizeof(scs_int) * k->gpsize);
+        for (i = 0, gpaLen = 0; i < k->gpsize; i++) {
+            k->gpm[i] = (scs_int) gpm_mex[i];
+            k->gpn[i] = (scs_int) gpn_mex[i];
+            gpaLen += k->gpm[i];
+        }
+        if (gpaLen != (scs_int) mxGetNumberOfElements(kgpa)) {
+            mexErrMsgTxt("cone.gpa must have sum(cone.gpm) entries");
+        }
+        k->gpa = mxMalloc(sizeof(scs_float) * gpaLen);
+        for (i = 0; i < gpaLen; i++) {
+            k->gpa[i] = (scs_float) gpa_mex[i];
+        }
+    } else {
+        k->gpsize = 0;
+        k->gpm = k->gpn = SCS_NULL;
+        k->gpa = SCS_NULL;
+    }
+
     A = scs_malloc(sizeof(AMatrix));
     A->n = d->n;
     A->m = d->m;
@@ -304,6 +435,90 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
 	mxSetField(plhs[3], 0, "solveTime", tmp);
 	*mxGetPr(tmp) = info.solveTime;
 
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "refactorizations", tmp);
+	*mxGetPr(tmp) = (scs_float) info.refactorizations;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "singleIters", tmp);
+	*mxGetPr(tmp) = (scs_float) info.singleIters;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "linSysTime", tmp);
+	*mxGetPr(tmp) = info.linSysTime;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "coneTime", tmp);
+	*mxGetPr(tmp) = info.coneTime;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "lpConeTime", tmp);
+	*mxGetPr(tmp) = info.lpConeTime;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "socConeTime", tmp);
+	*mxGetPr(tmp) = info.socConeTime;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "sdConeTime", tmp);
+	*mxGetPr(tmp) = info.sdConeTime;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "expConeTime", tmp);
+	*mxGetPr(tmp) = info.expConeTime;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "powConeTime", tmp);
+	*mxGetPr(tmp) = info.powConeTime;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "boxConeTime", tmp);
+	*mxGetPr(tmp) = info.boxConeTime;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "sdProjections", tmp);
+	*mxGetPr(tmp) = (scs_float) info.sdProjections;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "sdPsdHits", tmp);
+	*mxGetPr(tmp) = (scs_float) info.sdPsdHits;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "sdNsdHits", tmp);
+	*mxGetPr(tmp) = (scs_float) info.sdNsdHits;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "sdWarmEigs", tmp);
+	*mxGetPr(tmp) = (scs_float) info.sdWarmEigs;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "residualTime", tmp);
+	*mxGetPr(tmp) = info.residualTime;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "spmvTime", tmp);
+	*mxGetPr(tmp) = info.spmvTime;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "cgIters", tmp);
+	*mxGetPr(tmp) = (scs_float) info.cgIters;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "orderingTime", tmp);
+	*mxGetPr(tmp) = info.orderingTime;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "factorTime", tmp);
+	*mxGetPr(tmp) = info.factorTime;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "nnzL", tmp);
+	*mxGetPr(tmp) = (scs_float) info.nnzL;
+
+	tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+	mxSetField(plhs[3], 0, "factorCacheHit", tmp);
+	*mxGetPr(tmp) = (scs_float) info.factorCacheHit;
+
 	freeMex(d, k);
 	return;
 }
@@ -313,10 +528,23 @@ void freeMex(Data * d, Cone * k) {
 		scs_free(k->q);
 	if (k->s)
         scs_free(k->s);
+	if (k->cs)
+        scs_free(k->cs);
+	if (k->gpm)
+        scs_free(k->gpm);
+	if (k->gpn)
+        scs_free(k->gpn);
+	if (k->gpa)
+        scs_free(k->gpa);
     if (k->p)
         scs_free(k->p);
+    if (k->bl)
+        scs_free(k->bl);
+    if (k->bu)
+        scs_free(k->bu);
     if (d) {
         if(d->A) scs_free(d->A);
+        if(d->stgs && d->stgs->factor_cache) mxFree((char *) d->stgs->factor_cache);
         if(d->stgs) scs_free(d->stgs);
         scs_free(d);
     }
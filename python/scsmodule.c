@@ -199,8 +199,20 @@ static void freePyData(Data * d, Cone * k, struct ScsPyData * ps) {
             scs_free(k->q);
         if (k->s)
             scs_free(k->s);
+        if (k->cs)
+            scs_free(k->cs);
+        if (k->gpm)
+            scs_free(k->gpm);
+        if (k->gpn)
+            scs_free(k->gpn);
+        if (k->gpa)
+            scs_free(k->gpa);
         if (k->p)
             scs_free(k->p);
+        if (k->bl)
+            scs_free(k->bl);
+        if (k->bu)
+            scs_free(k->bu);
         scs_free(k);
     }
     if (d) {
@@ -236,14 +248,17 @@ static PyObject *csolve(PyObject* self, PyObject *args, PyObject *kwargs) {
     AMatrix * A;
 	Sol sol = { 0 };
 	Info info;
+	scs_int blsize = 0, busize = 0, gpnsize = 0, gpasize = 0, i;
 	static char *kwlist[] = { "shape", "Ax", "Ai", "Ap", "b", "c", "cone", "warm",
-        "verbose", "normalize", "max_iters", "scale", "eps", "cg_rate", "alpha", "rho_x", SCS_NULL };
+        "verbose", "normalize", "max_iters", "scale", "eps", "cg_rate", "alpha", "rho_x",
+        "acceleration_lookback", "acceleration_type", "adaptive_scale", "time_limit", "mixed_precision",
+        "sdp_warm_eig", "chordal_decomposition", "supernodal", "normal_equations", "factor_cache", "tree_parallel", SCS_NULL };
 	
     /* parse the arguments and ensure they are the correct type */
 #ifdef DLONG
-	static char *argparse_string = "(ll)O!O!O!O!O!O!|O!O!O!lddddd";
+	static char *argparse_string = "(ll)O!O!O!O!O!O!|O!O!O!ldddddllldlllllzl";
 #else
-	static char *argparse_string = "(ii)O!O!O!O!O!O!|O!O!O!iddddd";
+	static char *argparse_string = "(ii)O!O!O!O!O!O!|O!O!O!idddddiiidiiiiizi";
 #endif
     npy_intp veclen[1];
     PyObject *x, *y, *s, *returnDict, *infoDict;
@@ -270,7 +285,18 @@ static PyObject *csolve(PyObject* self, PyObject *args, PyObject *kwargs) {
         &(d->stgs->eps),
         &(d->stgs->cg_rate),
         &(d->stgs->alpha),
-        &(d->stgs->rho_x)) ) {
+        &(d->stgs->rho_x),
+        &(d->stgs->acceleration_lookback),
+        &(d->stgs->acceleration_type),
+        &(d->stgs->adaptive_scale),
+        &(d->stgs->time_limit),
+        &(d->stgs->mixed_precision),
+        &(d->stgs->sdp_warm_eig),
+        &(d->stgs->chordal_decomposition),
+        &(d->stgs->supernodal),
+        &(d->stgs->normal_equations),
+        &(d->stgs->factor_cache),
+        &(d->stgs->tree_parallel)) ) {
         PySys_WriteStderr("error parsing inputs\n");
         return SCS_NULL; 
     }
@@ -343,15 +369,44 @@ static PyObject *csolve(PyObject* self, PyObject *args, PyObject *kwargs) {
 	if (getConeArrDim("s", &(k->s), &(k->ssize), cone) < 0) {
 		return finishWithErr(d, k, &ps, "failed to parse cone field s");
 	}
+	if (getConeArrDim("cs", &(k->cs), &(k->cssize), cone) < 0) {
+		return finishWithErr(d, k, &ps, "failed to parse cone field cs");
+	}
 	if (getConeFloatArr("p", &(k->p), &(k->psize), cone) < 0) {
 		return finishWithErr(d, k, &ps, "failed to parse cone field p");
 	}
+	if (getConeArrDim("gpm", &(k->gpm), &(k->gpsize), cone) < 0) {
+		return finishWithErr(d, k, &ps, "failed to parse cone field gpm");
+	}
+	if (getConeArrDim("gpn", &(k->gpn), &gpnsize, cone) < 0) {
+		return finishWithErr(d, k, &ps, "failed to parse cone field gpn");
+	}
+	if (getConeFloatArr("gpa", &(k->gpa), &gpasize, cone) < 0) {
+		return finishWithErr(d, k, &ps, "failed to parse cone field gpa");
+	}
+	for (i = 0; i < k->gpsize; ++i) {
+		gpasize -= k->gpm[i];
+	}
+	if (gpnsize != k->gpsize || gpasize != 0) {
+		return finishWithErr(d, k, &ps, "cone fields gpm and gpn must have the same length and gpa sum(gpm)");
+	}
 	if (getPosIntParam("ep", &(k->ep), 0, cone) < 0) {
 		return finishWithErr(d, k, &ps, "failed to parse cone field ep");
 	}
 	if (getPosIntParam("ed", &(k->ed), 0, cone) < 0) {
 		return finishWithErr(d, k, &ps, "failed to parse cone field ed");
 	}
+	if (getConeFloatArr("bl", &(k->bl), &blsize, cone) < 0) {
+		return finishWithErr(d, k, &ps, "failed to parse cone field bl");
+	}
+	if (getConeFloatArr("bu", &(k->bu), &busize, cone) < 0) {
+		return finishWithErr(d, k, &ps, "failed to parse cone field bu");
+	}
+	if (blsize != busize) {
+		return finishWithErr(d, k, &ps, "cone fields bl and bu must have the same length");
+	}
+	/* the box cone has a row for t before the bounded ones */
+	k->bsize = blsize > 0 ? blsize + 1 : 0;
 
     d->stgs->verbose = verbose ? (scs_int) PyObject_IsTrue(verbose) : VERBOSE;
     d->stgs->normalize = normalize ? (scs_int) PyObject_IsTrue(normalize) : NORMALIZE;
@@ -373,6 +428,15 @@ static PyObject *csolve(PyObject* self, PyObject *args, PyObject *kwargs) {
     if(d->stgs->rho_x < 0) {
 		return finishWithErr(d, k, &ps, "rho_x must be positive");
 	}
+    if(d->stgs->acceleration_lookback < 0) {
+		return finishWithErr(d, k, &ps, "acceleration_lookback must be non-negative");
+	}
+    if(d->stgs->adaptive_scale < 0) {
+		return finishWithErr(d, k, &ps, "adaptive_scale must be non-negative");
+	}
+    if(d->stgs->time_limit < 0) {
+		return finishWithErr(d, k, &ps, "time_limit must be non-negative");
+	}
 	/* parse warm start if set */
     d->stgs->warm_start = WARM_START;
 	if (warm) {
@@ -415,12 +479,24 @@ static PyObject *csolve(PyObject* self, PyObject *args, PyObject *kwargs) {
 	s = PyArray_SimpleNewFromData(1, veclen, NPY_DOUBLE, sol.s);
     PyArray_ENABLEFLAGS((PyArrayObject *) s, NPY_ARRAY_OWNDATA);
 
-    infoDict = Py_BuildValue("{s:l,s:l,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:s}",
+    infoDict = Py_BuildValue("{s:l,s:l,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:s,s:l,s:l,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:l,s:l,s:l,s:l,s:d,s:d,s:l,s:d,s:d,s:l,s:l}",
 			"statusVal", (scs_int) info.statusVal, "iter", (scs_int) info.iter, "pobj", (scs_float) info.pobj,
 			"dobj", (scs_float) info.dobj, "resPri", (scs_float) info.resPri, "resDual", (scs_float) info.resDual,
 			"relGap", (scs_float) info.relGap, "resInfeas", (scs_float) info.resInfeas, "resUnbdd", (scs_float) info.resUnbdd,
 			"solveTime", (scs_float) (info.solveTime), "setupTime", (scs_float) (info.setupTime),
-			"status", info.status);
+			"status", info.status, "refactorizations", (long) info.refactorizations,
+			"singleIters", (long) info.singleIters,
+			"linSysTime", (scs_float) info.linSysTime, "coneTime", (scs_float) info.coneTime,
+			"lpConeTime", (scs_float) info.lpConeTime, "socConeTime", (scs_float) info.socConeTime,
+			"sdConeTime", (scs_float) info.sdConeTime, "expConeTime", (scs_float) info.expConeTime,
+			"powConeTime", (scs_float) info.powConeTime, "boxConeTime", (scs_float) info.boxConeTime,
+			"sdProjections", (long) info.sdProjections,
+			"sdPsdHits", (long) info.sdPsdHits, "sdNsdHits", (long) info.sdNsdHits,
+			"sdWarmEigs", (long) info.sdWarmEigs,
+			"residualTime", (scs_float) info.residualTime,
+			"spmvTime", (scs_float) info.spmvTime, "cgIters", (long) info.cgIters,
+			"orderingTime", (scs_float) info.orderingTime, "factorTime", (scs_float) info.factorTime,
+			"nnzL", (long) info.nnzL, "factorCacheHit", (long) info.factorCacheHit);
 
     returnDict = Py_BuildValue("{s:O,s:O,s:O,s:O}", "x", x, "y", y, "s", s, "info", infoDict);
 	/* give up ownership to the return dictionary */
@@ -9,7 +9,7 @@ from numpy.distutils.system_info import get_info, BlasNotFoundError
 def install_scs(USE_64_BIT_BLAS, blas_info, lapack_info, USE_OPENMP, rootDir): 
     libraries = []
     if system() == 'Linux':
-        libraries += ['rt']
+        libraries += ['rt', 'pthread']
    
     sources = ['scsmodule.c', ] + glob(rootDir + 'src/*.c') + glob(rootDir + 'linsys/*.c')
     include_dirs = [rootDir, rootDir + 'include', get_include(), rootDir + 'linsys']
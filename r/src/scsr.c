@@ -47,6 +47,14 @@ scs_int getIntFromListWithDefault(SEXP list, const char *str, scs_int def) {
     return INTEGER(val)[0];
 }
 
+const char * getStringFromListWithDefault(SEXP list, const char *str, const char * def) {
+    SEXP val = getListElement(list, str);
+    if (val == R_NilValue || !isString(val)) {
+        return def;
+    }
+    return CHAR(STRING_ELT(val, 0));
+}
+
 scs_float * getFloatVectorFromList(SEXP list, const char *str, scs_int * len) {
     SEXP vec = getListElement(list, str);
     *len = length(vec);
@@ -136,7 +144,7 @@ SEXP populateInfoR(Info * info, scs_int * num_protectaddr) {
 }
 
 SEXP scsr(SEXP data, SEXP cone, SEXP params) {
-    scs_int len, num_protected = 0;
+    scs_int len, blsize, busize, gpnsize, gpasize, i, num_protected = 0;
     SEXP ret, retnames, infor, xr, yr, sr;
 
     /* allocate memory */
@@ -169,6 +177,17 @@ SEXP scsr(SEXP data, SEXP cone, SEXP params) {
     stgs->eps        = getFloatFromListWithDefault(params, "eps", EPS);
     /* TODO add warm starting */
     stgs->warm_start = getIntFromListWithDefault(params, "warm_start", WARM_START);
+    stgs->acceleration_lookback = getIntFromListWithDefault(params, "acceleration_lookback", ACCEL_LOOKBACK);
+    stgs->acceleration_type = getIntFromListWithDefault(params, "acceleration_type", ACCEL_TYPE);
+    stgs->adaptive_scale = getIntFromListWithDefault(params, "adaptive_scale", ADAPTIVE_SCALE);
+    stgs->time_limit = getFloatFromListWithDefault(params, "time_limit", TIME_LIMIT);
+    stgs->mixed_precision = getIntFromListWithDefault(params, "mixed_precision", MIXED_PRECISION);
+    stgs->sdp_warm_eig = getIntFromListWithDefault(params, "sdp_warm_eig", SDP_WARM_EIG);
+    stgs->chordal_decomposition = getIntFromListWithDefault(params, "chordal_decomposition", CHORDAL_DECOMPOSITION);
+    stgs->supernodal = getIntFromListWithDefault(params, "supernodal", SUPERNODAL);
+    stgs->normal_equations = getIntFromListWithDefault(params, "normal_equations", NORMAL_EQUATIONS);
+    stgs->factor_cache = getStringFromListWithDefault(params, "factor_cache", FACTOR_CACHE);
+    stgs->tree_parallel = getIntFromListWithDefault(params, "tree_parallel", TREE_PARALLEL);
     d->stgs = stgs;
 
     k->f = getIntFromListWithDefault(cone, "f", 0);
@@ -177,7 +196,22 @@ SEXP scsr(SEXP data, SEXP cone, SEXP params) {
     k->ed = getIntFromListWithDefault(cone, "ed", 0);
     k->q = getIntVectorFromList(cone, "q", &(k->qsize));
     k->s = getIntVectorFromList(cone, "s", &(k->ssize));
+    k->cs = getIntVectorFromList(cone, "cs", &(k->cssize));
     k->p = getFloatVectorFromList(cone, "p", &(k->psize));
+    k->bl = getFloatVectorFromList(cone, "bl", &blsize);
+    k->bu = getFloatVectorFromList(cone, "bu", &busize);
+    /* the box cone has a row for t before the bounded ones, unequal lengths fail the cone dimension check */
+    k->bsize = blsize > 0 && blsize == busize ? blsize + 1 : 0;
+    k->gpm = getIntVectorFromList(cone, "gpm", &(k->gpsize));
+    k->gpn = getIntVectorFromList(cone, "gpn", &gpnsize);
+    k->gpa = getFloatVectorFromList(cone, "gpa", &gpasize);
+    for (i = 0; i < k->gpsize; ++i) {
+        gpasize -= k->gpm[i];
+    }
+    /* inconsistent lengths fail validateCones */
+    if (gpnsize != k->gpsize || gpasize != 0) {
+        k->gpa = SCS_NULL;
+    }
     
     /* solve! */
     scs(d, k, sol, info);
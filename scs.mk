@@ -21,7 +21,7 @@ LDFLAGS += -lm
 SHARED = dll
 else
 # we're on a linux system, use accurate timer provided by clock_gettime()
-LDFLAGS += -lm -lrt
+LDFLAGS += -lm -lrt -lpthread
 SHARED = so
 endif
 
@@ -69,6 +69,10 @@ COPYAMATRIX = 1
 ifneq ($(COPYAMATRIX), 0)
 CFLAGS += -DCOPYAMATRIX=$(COPYAMATRIX) # if normalize, copy A
 endif
+SUPERNODAL = 1
+ifeq ($(SUPERNODAL), 0)
+CFLAGS += -DSUPERNODAL=0 # direct: column at a time LDL' factorization by default (supernodal setting)
+endif
 
 ### VERBOSITY LEVELS: 0,1,2
 EXTRAVERBOSE = 0
@@ -77,7 +81,8 @@ CFLAGS += -DEXTRAVERBOSE=$(EXTRAVERBOSE) # extra verbosity level
 endif
 
 ############ OPENMP: ############
-# set USE_OPENMP = 1 to allow openmp (multi-threaded matrix multiplies):
+# set USE_OPENMP = 1 to allow openmp (multi-threaded matrix multiplies, cone projections, direct factorization and
+# solves):
 # set the number of threads to, for example, 4 by entering the command:
 # export OMP_NUM_THREADS=4
 
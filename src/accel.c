@@ -0,0 +1,260 @@
+#include "scs.h"
+#include "accel.h"
+
+/*
+ * Anderson acceleration, see Walker & Ni, "Anderson acceleration for fixed-point iterations"
+ * and Zhang, O'Donoghue & Boyd, "Globally convergent type-I Anderson acceleration".
+ * The fixed-point map g takes the stacked iterate x = [u; v] to the output of one scs iteration,
+ * with residual f = g(x) - x. Given the last k differences S = [dx], Y = [df] the next iterate is
+ *
+ *      x+ = g(x) - (S + Y) * gamma,
+ *
+ * where gamma = (Y'Y) \ Y'f (type-II) or gamma = (S'Y) \ S'f (type-I).
+ */
+
+/* extrapolated step is rejected if it increases the fixed-point residual by more than this factor */
+#define ACCEL_SAFEGUARD_FACTOR (1.0)
+/* regularization added to the diagonal of the small system, relative to its frobenius norm */
+#define ACCEL_REGULARIZATION (1e-10)
+/* pivots smaller than this (relative) mean the small system is numerically singular */
+#define ACCEL_PIVOT_TOL (1e-14)
+
+struct SCS_ACCEL {
+	scs_int k; /* memory depth */
+	scs_int l; /* length of stacked iterate [u; v] */
+	scs_int type1; /* boolean, type-I (1) or type-II (0) */
+	scs_int iter; /* number of difference pairs computed since last reset */
+	scs_int hasPrev; /* boolean, xPrev and fPrev are populated */
+	scs_int extrapolated; /* boolean, current iterate is the output of an extrapolation */
+	scs_float *g; /* output of last iteration, copy of [u; v] */
+	scs_float *x, *f; /* input to last iteration, and fixed-point residual g(x) - x */
+	scs_float *xPrev, *fPrev; /* same, one iteration earlier */
+	scs_float *S, *Y; /* l x k column-major, circular buffers of differences in x and f */
+	scs_float *M; /* k x k column-major, S'Y (type-I) or Y'Y (type-II) */
+	scs_float *A, *gamma; /* workspace for the small linear system */
+	scs_float *gSafe; /* un-extrapolated iterate, restored if extrapolation is rejected */
+	scs_float nmfSafe; /* residual norm at last extrapolation */
+	scs_int totalAccepted, totalRejected;
+};
+
+Accel * initAccel(const Work * w) {
+	Accel * a = scs_calloc(1, sizeof(Accel));
+	scs_int k = w->stgs->acceleration_lookback;
+	scs_int l = 2 * (w->n + w->m + 1);
+	if (!a) {
+		return SCS_NULL;
+	}
+	a->k = k;
+	a->l = l;
+	a->type1 = (w->stgs->acceleration_type == 1);
+	a->g = scs_malloc(l * sizeof(scs_float));
+	a->x = scs_malloc(l * sizeof(scs_float));
+	a->f = scs_malloc(l * sizeof(scs_float));
+	a->xPrev = scs_malloc(l * sizeof(scs_float));
+	a->fPrev = scs_malloc(l * sizeof(scs_float));
+	a->gSafe = scs_malloc(l * sizeof(scs_float));
+	a->S = scs_malloc(l * k * sizeof(scs_float));
+	a->Y = scs_malloc(l * k * sizeof(scs_float));
+	a->M = scs_calloc(k * k, sizeof(scs_float));
+	a->A = scs_malloc(k * k * sizeof(scs_float));
+	a->gamma = scs_malloc(k * sizeof(scs_float));
+	if (!a->g || !a->x || !a->f || !a->xPrev || !a->fPrev || !a->gSafe || !a->S || !a->Y || !a->M || !a->A || !a->gamma) {
+		freeAccel(a);
+		return SCS_NULL;
+	}
+	return a;
+}
+
+/* u and v are separate arrays in Work, x = [u; v] */
+static void getIterate(const Work * w, scs_float * x) {
+	scs_int l = w->n + w->m + 1;
+	memcpy(x, w->u, l * sizeof(scs_float));
+	memcpy(&(x[l]), w->v, l * sizeof(scs_float));
+}
+
+static void setIterate(Work * w, const scs_float * x) {
+	scs_int l = w->n + w->m + 1;
+	memcpy(w->u, x, l * sizeof(scs_float));
+	memcpy(w->v, &(x[l]), l * sizeof(scs_float));
+}
+
+void resetAccel(Accel * a, const Work * w) {
+	getIterate(w, a->x);
+	a->iter = 0;
+	a->hasPrev = 0;
+	a->extrapolated = 0;
+	a->totalAccepted = 0;
+	a->totalRejected = 0;
+}
+
+void freeAccel(Accel * a) {
+	if (a) {
+		if (a->g)
+			scs_free(a->g);
+		if (a->x)
+			scs_free(a->x);
+		if (a->f)
+			scs_free(a->f);
+		if (a->xPrev)
+			scs_free(a->xPrev);
+		if (a->fPrev)
+			scs_free(a->fPrev);
+		if (a->gSafe)
+			scs_free(a->gSafe);
+		if (a->S)
+			scs_free(a->S);
+		if (a->Y)
+			scs_free(a->Y);
+		if (a->M)
+			scs_free(a->M);
+		if (a->A)
+			scs_free(a->A);
+		if (a->gamma)
+			scs_free(a->gamma);
+		scs_free(a);
+	}
+}
+
+char * getAccelSummary(Accel * a, const Info * info) {
+	char * str = scs_malloc(sizeof(char) * 128);
+	sprintf(str, "\tAcceleration: type-%s, lookback: %li, accepted steps: %li, rejected steps: %li\n",
+			a->type1 ? "I" : "II", (long) a->k, (long) a->totalAccepted, (long) a->totalRejected);
+	return str;
+}
+
+/* recomputes row and column c of M after column c of S and Y was replaced */
+static void updateGram(Accel * a, scs_int c, scs_int mem) {
+	scs_int j, k = a->k, l = a->l;
+	scs_float * Sc = &(a->S[c * l]);
+	scs_float * Yc = &(a->Y[c * l]);
+	for (j = 0; j < mem; ++j) {
+		if (a->type1) {
+			a->M[c + j * k] = innerProd(Sc, &(a->Y[j * l]), l);
+			a->M[j + c * k] = innerProd(&(a->S[j * l]), Yc, l);
+		} else {
+			a->M[c + j * k] = a->M[j + c * k] = innerProd(Yc, &(a->Y[j * l]), l);
+		}
+	}
+}
+
+/* solves the mem x mem system for gamma by gaussian elimination with partial pivoting, f is residual */
+static scs_int solveGamma(Accel * a, const scs_float * f, scs_int mem) {
+	scs_int i, j, r, piv, k = a->k, l = a->l;
+	scs_float * A = a->A;
+	scs_float * gamma = a->gamma;
+	scs_float reg, tmp, nmA = 0;
+	for (j = 0; j < mem; ++j) {
+		gamma[j] = innerProd(a->type1 ? &(a->S[j * l]) : &(a->Y[j * l]), f, l);
+		for (i = 0; i < mem; ++i) {
+			A[i + j * mem] = a->M[i + j * k];
+			nmA += A[i + j * mem] * A[i + j * mem];
+		}
+	}
+	nmA = SQRTF(nmA);
+	if (nmA <= 0 || nmA != nmA) {
+		return -1;
+	}
+	reg = ACCEL_REGULARIZATION * nmA;
+	for (i = 0; i < mem; ++i) {
+		A[i + i * mem] += reg;
+	}
+	for (j = 0; j < mem; ++j) {
+		piv = j;
+		for (r = j + 1; r < mem; ++r) {
+			if (ABS(A[r + j * mem]) > ABS(A[piv + j * mem]))
+				piv = r;
+		}
+		if (ABS(A[piv + j * mem]) < ACCEL_PIVOT_TOL * nmA) {
+			return -1;
+		}
+		if (piv != j) {
+			for (i = j; i < mem; ++i) {
+				tmp = A[j + i * mem];
+				A[j + i * mem] = A[piv + i * mem];
+				A[piv + i * mem] = tmp;
+			}
+			tmp = gamma[j];
+			gamma[j] = gamma[piv];
+			gamma[piv] = tmp;
+		}
+		for (r = j + 1; r < mem; ++r) {
+			tmp = A[r + j * mem] / A[j + j * mem];
+			for (i = j + 1; i < mem; ++i) {
+				A[r + i * mem] -= tmp * A[j + i * mem];
+			}
+			gamma[r] -= tmp * gamma[j];
+		}
+	}
+	for (j = mem - 1; j >= 0; --j) {
+		for (i = j + 1; i < mem; ++i) {
+			gamma[j] -= A[j + i * mem] * gamma[i];
+		}
+		gamma[j] /= A[j + j * mem];
+		if (gamma[j] != gamma[j]) {
+			return -1;
+		}
+	}
+	return 0;
+}
+
+scs_int accelerate(Work * w) {
+	Accel * a = w->accel;
+	scs_int i, j, c, mem, l = a->l;
+	scs_float * g = a->g;
+	scs_float nmf, *tmp;
+
+	getIterate(w, g);
+	for (i = 0; i < l; ++i) {
+		a->f[i] = g[i] - a->x[i];
+	}
+	nmf = calcNorm(a->f, l);
+
+	/* safeguard: only keep extrapolated iterate if it did not increase the residual */
+	if (a->extrapolated) {
+		a->extrapolated = 0;
+		if (!(nmf <= ACCEL_SAFEGUARD_FACTOR * a->nmfSafe)) {
+			setIterate(w, a->gSafe);
+			memcpy(a->x, a->gSafe, l * sizeof(scs_float));
+			a->iter = 0;
+			a->hasPrev = 0;
+			a->totalRejected++;
+			return 0;
+		}
+		a->totalAccepted++;
+	}
+
+	if (a->hasPrev) {
+		c = a->iter % a->k;
+		for (i = 0; i < l; ++i) {
+			a->S[c * l + i] = a->x[i] - a->xPrev[i];
+			a->Y[c * l + i] = a->f[i] - a->fPrev[i];
+		}
+		a->iter++;
+		updateGram(a, c, MIN(a->iter, a->k));
+	}
+	/* rotate buffers, xPrev and fPrev now hold current values */
+	tmp = a->xPrev;
+	a->xPrev = a->x;
+	a->x = tmp;
+	tmp = a->fPrev;
+	a->fPrev = a->f;
+	a->f = tmp;
+	a->hasPrev = 1;
+
+	mem = MIN(a->iter, a->k);
+	/* short-memory type-I steps are unreliable, after a rejection wait until the history is full again */
+	if (mem == 0 || (a->type1 && a->totalRejected > 0 && mem < a->k) || solveGamma(a, a->fPrev, mem) < 0) {
+		memcpy(a->x, g, l * sizeof(scs_float));
+		return 0;
+	}
+	memcpy(a->gSafe, g, l * sizeof(scs_float));
+	a->nmfSafe = nmf;
+	for (j = 0; j < mem; ++j) {
+		addScaledArray(g, &(a->S[j * l]), l, -a->gamma[j]);
+		addScaledArray(g, &(a->Y[j * l]), l, -a->gamma[j]);
+	}
+	memcpy(a->x, g, l * sizeof(scs_float));
+	setIterate(w, g);
+	a->extrapolated = 1;
+	return 1;
+}
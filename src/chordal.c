@@ -0,0 +1,908 @@
+#include "scs.h"
+#include "chordal.h"
+#include "linsys/amatrix.h"
+#include "scs_blas.h" /* contains BLAS(X) macros and type info */
+
+/*
+ * Chordal decomposition of sparse SD blocks, see Fukuda, Kojima, Murota & Nakata, "Exploiting sparsity in
+ * semidefinite programming via matrix completion I", and Vandenberghe & Andersen, "Chordal graphs and semidefinite
+ * optimization". The slack S of an n x n SD block is zero outside the aggregate sparsity pattern P of the block (the
+ * entries whose rows of A are empty and of b zero). If F is a chordal extension of P with maximal cliques
+ * C_1, ..., C_p then
+ *
+ *      S PSD and zero outside F   <=>   S = sum_c E_c' S_c E_c with every |C_c| x |C_c| S_c PSD,
+ *
+ * and the dual variable Y (free outside P) has a PSD completion iff every Y_{C_c C_c} is PSD. The block is replaced
+ * by the SD blocks S_c. Each entry of F is owned by the first clique (in postorder of the clique tree) that contains
+ * it, its original row moves to that clique. The row of every other clique containing the entry gets s = t for a new
+ * variable t, which is also subtracted from the owner's row, so the S_c sum to the original S and the dual variables
+ * of the cliques agree on their overlaps.
+ */
+
+#define CHORDAL_MIN_SIZE (16) /* smaller SD blocks are never decomposed */
+#define CHORDAL_MAX_FLOP_RATIO (0.25) /* decompose if sum |C|^3 over the cliques is at most this fraction of n^3 */
+#define CHORDAL_PINV_TOL (1e-12) /* eigenvalues below this (relative) are dropped from Y_SS^+ in the completion */
+#define CHORDAL_SHIFT (2.0) /* the completion is of Y + delta I, delta this times the most negative clique eigenvalue */
+
+#ifdef LAPACK_LIB_FOUND
+void BLAS(syevr)(const char *jobz, const char *range, const char *uplo, blasint *n, scs_float *a, blasint *lda,
+		scs_float *vl, scs_float *vu, blasint *il, blasint *iu, scs_float *abstol, blasint *m, scs_float *w,
+		scs_float *z, blasint *ldz, blasint *isuppz, scs_float *work, blasint *lwork, blasint *iwork, blasint *liwork,
+		blasint *info);
+void BLAS(gemm)(const char *transa, const char *transb, const blasint *m, const blasint *n, const blasint *k,
+		const scs_float *alpha, const scs_float *a, const blasint *lda, const scs_float *b, const blasint *ldb,
+		const scs_float *beta, scs_float *c, const blasint *ldc);
+#endif
+
+/* one decomposed SD block */
+typedef struct {
+	scs_int n; /* size of the original block */
+	scs_int row; /* its first row in the original problem */
+	scs_int numCliques; /* in postorder of the clique tree, children before parents */
+	scs_int * start; /* clique c has vertices verts[start[c]], ..., verts[start[c + 1] - 1], increasing */
+	scs_int * verts;
+	scs_int * owner; /* owner[v] = the clique nearest the root that contains vertex v */
+	scs_int maxClique;
+	scs_int numDropped; /* entries outside the chordal extension, filled in by completeBlock */
+} ChordalBlock;
+
+struct SCS_CHORDAL_WORK {
+	scs_int m, n; /* of the original problem */
+	Data * d; /* decomposed problem, owns A, b and c */
+	Cone * k; /* decomposed cones, owns s, the other arrays are the original cone's */
+	Sol * sol; /* decomposed solution */
+	scs_int haveSol; /* sol is the last solution mapped back by chordalBackward, the reference of a warm start */
+	scs_int * rowMap; /* original row -> the decomposed row it moves to (the owner's for an entry of a decomposed
+	                     block), -1 for the entries outside the chordal extensions */
+	scs_int * origRow; /* decomposed row -> original row */
+	scs_int * aMap; /* nonzero of the original A -> nonzero of the decomposed A */
+	scs_float * Ax; /* values of the decomposed A, for scs_update_A */
+	ChordalBlock * blocks;
+	scs_int numBlocks; /* decomposed SD blocks */
+	scs_int numCliques, maxClique, maxSize; /* cliques of all blocks, the largest clique and block */
+	scs_int numOverlaps; /* consistency variables t */
+};
+
+/* bit adjacency matrix of the elimination graph, one row of rowBytes bytes per vertex */
+#define ADJ_TEST(adj, rowBytes, i, j) ((adj)[(i) * (rowBytes) + ((j) >> 3)] & (1 << ((j) & 7)))
+#define ADJ_SET(adj, rowBytes, i, j) ((adj)[(i) * (rowBytes) + ((j) >> 3)] |= (unsigned char) (1 << ((j) & 7)))
+#define ADJ_CLEAR(adj, rowBytes, i, j) ((adj)[(i) * (rowBytes) + ((j) >> 3)] &= (unsigned char) ~(1 << ((j) & 7)))
+
+static void freeBlock(ChordalBlock * blk) {
+	if (blk->start)
+		scs_free(blk->start);
+	if (blk->verts)
+		scs_free(blk->verts);
+	if (blk->owner)
+		scs_free(blk->owner);
+}
+
+#ifdef LAPACK_LIB_FOUND
+static int compareInts(const void * a, const void * b) {
+	scs_int ia = *(const scs_int *) a, ib = *(const scs_int *) b;
+	return ia < ib ? -1 : (ia > ib);
+}
+
+static scs_float cube(scs_int x) {
+	return (scs_float) x * x * x;
+}
+
+/* the clique snode s was merged into */
+static scs_int findClique(const scs_int * rep, scs_int s) {
+	while (rep[s] != s) {
+		s = rep[s];
+	}
+	return s;
+}
+
+/* minimum degree elimination of the pattern of the n x n block at row (the entries i > j with rowUsed set), the
+ * neighbours v has when it is eliminated at step pos[v] are nbrs[nbrStart[pos[v]]], ..., nbrs[nbrStart[pos[v] + 1] - 1].
+ * returns the number of neighbour entries, 0 if some vertex had so many that the block is not worth decomposing or
+ * on allocation failure */
+static scs_int eliminate(const scs_int * rowUsed, scs_int row, scs_int n, scs_int * pos, scs_int * perm,
+		scs_int * nbrStart, scs_int ** nbrsp) {
+	scs_int i, j, a, b, k, v, cnt, nnb = 0, cap = n, rowBytes = (n + 7) / 8, idx = row;
+	scs_int * deg = scs_calloc(n, sizeof(scs_int));
+	scs_int * tmp = scs_malloc(n * sizeof(scs_int));
+	scs_int * nbrs, *grown;
+	unsigned char * adj = scs_calloc(n * rowBytes, sizeof(unsigned char));
+	if (!deg || !tmp || !adj) {
+		nnb = -1;
+		goto out;
+	}
+	for (j = 0; j < n; ++j) {
+		++idx; /* the diagonal */
+		for (i = j + 1; i < n; ++i, ++idx) {
+			if (rowUsed[idx]) {
+				ADJ_SET(adj, rowBytes, i, j);
+				ADJ_SET(adj, rowBytes, j, i);
+				deg[i]++;
+				deg[j]++;
+				cap += 2;
+			}
+		}
+	}
+	if (!(nbrs = scs_malloc(cap * sizeof(scs_int)))) {
+		nnb = -1;
+		goto out;
+	}
+	*nbrsp = nbrs;
+	for (i = 0; i < n; ++i) {
+		pos[i] = -1;
+	}
+	nbrStart[0] = 0;
+	for (k = 0; k < n; ++k) {
+		v = -1;
+		for (i = 0; i < n; ++i) {
+			if (pos[i] < 0 && (v < 0 || deg[i] < deg[v])) {
+				v = i;
+			}
+		}
+		/* its neighbours and v form a clique of the extension */
+		if (cube(deg[v] + 1) > CHORDAL_MAX_FLOP_RATIO * cube(n)) {
+			nnb = -1;
+			goto out;
+		}
+		cnt = 0;
+		for (j = 0; j < rowBytes; ++j) {
+			if (adj[v * rowBytes + j]) {
+				for (i = 8 * j; i < MIN(8 * j + 8, n); ++i) {
+					if (ADJ_TEST(adj, rowBytes, v, i)) {
+						tmp[cnt++] = i;
+					}
+				}
+			}
+		}
+		if (nnb + cnt > cap) {
+			cap = 2 * (nnb + cnt);
+			if (!(grown = scs_malloc(cap * sizeof(scs_int)))) {
+				nnb = -1;
+				goto out;
+			}
+			memcpy(grown, nbrs, nnb * sizeof(scs_int));
+			scs_free(nbrs);
+			*nbrsp = nbrs = grown;
+		}
+		memcpy(&(nbrs[nnb]), tmp, cnt * sizeof(scs_int));
+		nnb += cnt;
+		nbrStart[k + 1] = nnb;
+		/* fill in */
+		for (a = 0; a < cnt; ++a) {
+			for (b = a + 1; b < cnt; ++b) {
+				if (!ADJ_TEST(adj, rowBytes, tmp[a], tmp[b])) {
+					ADJ_SET(adj, rowBytes, tmp[a], tmp[b]);
+					ADJ_SET(adj, rowBytes, tmp[b], tmp[a]);
+					deg[tmp[a]]++;
+					deg[tmp[b]]++;
+				}
+			}
+			ADJ_CLEAR(adj, rowBytes, tmp[a], v);
+			deg[tmp[a]]--;
+		}
+		pos[v] = k;
+		perm[k] = v;
+	}
+out:
+	if (deg)
+		scs_free(deg);
+	if (tmp)
+		scs_free(tmp);
+	if (adj)
+		scs_free(adj);
+	return nnb < 0 ? 0 : MAX(nnb, 1);
+}
+
+/*
+ * chordal extension of the pattern of the n x n block at row by minimum degree elimination, and its clique tree: the
+ * supernodes (chains of vertices whose neighbour sets at elimination are nested) give the maximal cliques, a child is
+ * merged into its parent whenever that does not increase sum |C|^3. fills blk, returns 0 if the block is not worth
+ * decomposing (or on allocation failure)
+ */
+static scs_int decomposeBlock(ChordalBlock * blk, const scs_int * rowUsed, scs_int row, scs_int n) {
+	scs_int i, k, o, v, p, s, c, len, numS = 0, numC = 0, ok = 0;
+	scs_int *pos, *perm, *nbrStart, *nbrs = SCS_NULL, *nn, *parent, *snode, *top, *order, *sParent, *res, *rep, *cid;
+	scs_float flops = 0.0;
+	pos = scs_malloc(n * sizeof(scs_int));
+	perm = scs_malloc(n * sizeof(scs_int));
+	nbrStart = scs_malloc((n + 1) * sizeof(scs_int));
+	nn = scs_malloc(n * sizeof(scs_int));
+	parent = scs_malloc(n * sizeof(scs_int));
+	snode = scs_malloc(n * sizeof(scs_int));
+	top = scs_malloc(n * sizeof(scs_int));
+	order = scs_malloc(n * sizeof(scs_int));
+	sParent = scs_malloc(n * sizeof(scs_int));
+	res = scs_calloc(n, sizeof(scs_int));
+	rep = scs_malloc(n * sizeof(scs_int));
+	cid = scs_malloc(n * sizeof(scs_int));
+	memset(blk, 0, sizeof(ChordalBlock));
+	if (!pos || !perm || !nbrStart || !nn || !parent || !snode || !top || !order || !sParent || !res || !rep || !cid
+			|| !eliminate(rowUsed, row, n, pos, perm, nbrStart, &nbrs)) {
+		goto out;
+	}
+	/* elimination tree, parent = the neighbour eliminated first */
+	for (k = 0; k < n; ++k) {
+		v = perm[k];
+		nn[v] = nbrStart[k + 1] - nbrStart[k];
+		parent[v] = -1;
+		for (i = nbrStart[k]; i < nbrStart[k + 1]; ++i) {
+			if (parent[v] < 0 || pos[nbrs[i]] < pos[parent[v]]) {
+				parent[v] = nbrs[i];
+			}
+		}
+		snode[v] = -1;
+	}
+	/* supernodes, the parent joins v's if its neighbours are those of v except itself */
+	for (k = 0; k < n; ++k) {
+		v = perm[k];
+		if (snode[v] < 0) {
+			snode[v] = numS;
+			top[numS++] = v;
+		}
+		res[snode[v]]++;
+		p = parent[v];
+		if (p >= 0 && snode[p] < 0 && nn[v] == nn[p] + 1) {
+			snode[p] = snode[v];
+			top[snode[v]] = p;
+		}
+	}
+	/* postorder (by the elimination step of the top vertex), the clique of s is its vertices and the neighbours of
+	 * its top vertex, which are also in the clique of its parent */
+	for (k = 0, o = 0; k < n; ++k) {
+		v = perm[k];
+		if (top[snode[v]] == v) {
+			order[o++] = snode[v];
+		}
+	}
+	for (s = 0; s < numS; ++s) {
+		sParent[s] = parent[top[s]] >= 0 ? snode[parent[top[s]]] : -1;
+		rep[s] = s;
+	}
+	for (o = 0; o < numS; ++o) {
+		s = order[o];
+		p = sParent[s];
+		if (p >= 0 && cube(res[s] + nn[top[s]]) + cube(res[p] + nn[top[p]]) >= cube(res[p] + nn[top[p]] + res[s])) {
+			rep[s] = p;
+			res[p] += res[s];
+		}
+	}
+	for (o = 0; o < numS; ++o) {
+		s = order[o];
+		if (rep[s] == s) {
+			cid[s] = numC++;
+			flops += cube(res[s] + nn[top[s]]);
+			blk->maxClique = MAX(blk->maxClique, res[s] + nn[top[s]]);
+		}
+	}
+	if (numC < 2 || flops > CHORDAL_MAX_FLOP_RATIO * cube(n)) {
+		goto out;
+	}
+	blk->n = n;
+	blk->row = row;
+	blk->numCliques = numC;
+	blk->start = scs_malloc((numC + 1) * sizeof(scs_int));
+	blk->owner = scs_malloc(n * sizeof(scs_int));
+	if (!blk->start || !blk->owner) {
+		goto out;
+	}
+	blk->start[0] = 0;
+	for (o = 0; o < numS; ++o) {
+		s = order[o];
+		if (rep[s] == s) {
+			blk->start[cid[s] + 1] = blk->start[cid[s]] + res[s] + nn[top[s]];
+		}
+	}
+	if (!(blk->verts = scs_malloc(blk->start[numC] * sizeof(scs_int)))) {
+		goto out;
+	}
+	/* the vertices of each clique, its own first (res counts them again) then the neighbours of its top vertex */
+	for (s = 0; s < numS; ++s) {
+		if (rep[s] == s) {
+			res[s] = 0;
+		}
+	}
+	for (v = 0; v < n; ++v) {
+		s = findClique(rep, snode[v]);
+		c = cid[s];
+		blk->owner[v] = c;
+		blk->verts[blk->start[c] + res[s]++] = v;
+	}
+	for (s = 0; s < numS; ++s) {
+		if (rep[s] == s) {
+			c = cid[s];
+			k = pos[top[s]];
+			memcpy(&(blk->verts[blk->start[c] + res[s]]), &(nbrs[nbrStart[k]]), nn[top[s]] * sizeof(scs_int));
+			len = blk->start[c + 1] - blk->start[c];
+			qsort(&(blk->verts[blk->start[c]]), len, sizeof(scs_int), compareInts);
+		}
+	}
+	ok = 1;
+out:
+	if (!ok) {
+		freeBlock(blk);
+	}
+	if (pos)
+		scs_free(pos);
+	if (perm)
+		scs_free(perm);
+	if (nbrStart)
+		scs_free(nbrStart);
+	if (nbrs)
+		scs_free(nbrs);
+	if (nn)
+		scs_free(nn);
+	if (parent)
+		scs_free(parent);
+	if (snode)
+		scs_free(snode);
+	if (top)
+		scs_free(top);
+	if (order)
+		scs_free(order);
+	if (sParent)
+		scs_free(sParent);
+	if (res)
+		scs_free(res);
+	if (rep)
+		scs_free(rep);
+	if (cid)
+		scs_free(cid);
+	return ok;
+}
+
+/* the index of entry (i, j), i >= j, of an n x n block in the (column-wise, lower triangular) SD cone variables */
+static scs_int svecIndex(scs_int i, scs_int j, scs_int n) {
+	return j * n - (j * (j - 1)) / 2 + i - j;
+}
+
+/* lays out the rows of the decomposed problem: rowMap, origRow, the cone sizes and the number of overlaps, returns
+ * the number of rows */
+static scs_int layOutRows(ChordalWork * ch, const Cone * k, scs_int * s) {
+	scs_int i, a, b, c, r, row, len, nc, dr = 0, blkIdx = 0, ssize = 0;
+	const scs_int * verts;
+	ChordalBlock * blk;
+	for (i = 0; i < ch->m; ++i) {
+		ch->rowMap[i] = -1;
+	}
+	row = k->f + k->l;
+	for (i = 0; i < k->qsize; ++i) {
+		row += k->q[i];
+	}
+	for (; dr < row; ++dr) {
+		ch->rowMap[dr] = dr;
+		ch->origRow[dr] = dr;
+	}
+	for (i = 0; i < k->ssize; ++i) {
+		len = (k->s[i] * (k->s[i] + 1)) / 2;
+		blk = blkIdx < ch->numBlocks ? &(ch->blocks[blkIdx]) : SCS_NULL;
+		if (!blk || blk->row != row) {
+			s[ssize++] = k->s[i];
+			for (r = row; r < row + len; ++r, ++dr) {
+				ch->rowMap[r] = dr;
+				ch->origRow[dr] = r;
+			}
+		} else {
+			for (c = 0; c < blk->numCliques; ++c) {
+				verts = &(blk->verts[blk->start[c]]);
+				nc = blk->start[c + 1] - blk->start[c];
+				s[ssize++] = nc;
+				for (b = 0; b < nc; ++b) {
+					for (a = b; a < nc; ++a, ++dr) {
+						r = row + svecIndex(verts[a], verts[b], blk->n);
+						ch->origRow[dr] = r;
+						if (ch->rowMap[r] < 0) {
+							ch->rowMap[r] = dr;
+						} else {
+							ch->numOverlaps++;
+						}
+					}
+				}
+			}
+			for (r = row; r < row + len; ++r) {
+				blk->numDropped += ch->rowMap[r] < 0;
+			}
+			blkIdx++;
+		}
+		row += len;
+	}
+	for (; row < ch->m; ++row, ++dr) {
+		ch->rowMap[row] = dr;
+		ch->origRow[dr] = row;
+	}
+	return dr;
+}
+
+/* the decomposed A: the columns of A with their rows moved by rowMap, then a column (+1 on the owner's row, -1 on the
+ * other's) per overlap. built row by row so the row indices come out increasing in each column */
+static scs_int buildA(ChordalWork * ch, const AMatrix * A) {
+	scs_int i, j, q, r, t, nnz = A->p[A->n] + 2 * ch->numOverlaps, m = ch->d->m, n = ch->d->n;
+	scs_int *rowStart = scs_calloc(m + 1, sizeof(scs_int)), *col = scs_malloc(nnz * sizeof(scs_int));
+	scs_int *src = scs_malloc(nnz * sizeof(scs_int)), *next = scs_malloc(n * sizeof(scs_int));
+	scs_float * val = scs_malloc(nnz * sizeof(scs_float));
+	AMatrix * D = ch->d->A = scs_calloc(1, sizeof(AMatrix));
+	scs_int ok = 0;
+	if (!rowStart || !col || !src || !next || !val || !D) {
+		goto out;
+	}
+	D->m = m;
+	D->n = n;
+	D->p = scs_malloc((n + 1) * sizeof(scs_int));
+	D->i = scs_malloc(nnz * sizeof(scs_int));
+	D->x = scs_malloc(nnz * sizeof(scs_float));
+	ch->aMap = scs_malloc(MAX(A->p[A->n], 1) * sizeof(scs_int));
+	ch->Ax = scs_malloc(nnz * sizeof(scs_float));
+	if (!D->p || !D->i || !D->x || !ch->aMap || !ch->Ax) {
+		goto out;
+	}
+	/* counts per row, then the entries grouped by row in column order */
+	for (q = 0; q < A->p[A->n]; ++q) {
+		rowStart[ch->rowMap[A->i[q]] + 1]++;
+	}
+	for (r = 0; r < m; ++r) {
+		if (ch->rowMap[ch->origRow[r]] != r) {
+			rowStart[ch->rowMap[ch->origRow[r]] + 1]++;
+			rowStart[r + 1]++;
+		}
+	}
+	for (r = 0; r < m; ++r) {
+		rowStart[r + 1] += rowStart[r];
+	}
+	for (j = 0; j < A->n; ++j) {
+		for (q = A->p[j]; q < A->p[j + 1]; ++q) {
+			r = rowStart[ch->rowMap[A->i[q]]]++;
+			col[r] = j;
+			val[r] = A->x[q];
+			src[r] = q;
+		}
+	}
+	for (r = 0, t = A->n; r < m; ++r) {
+		if (ch->rowMap[ch->origRow[r]] != r) {
+			i = rowStart[ch->rowMap[ch->origRow[r]]]++;
+			col[i] = t;
+			val[i] = 1.0;
+			src[i] = -1;
+			i = rowStart[r]++;
+			col[i] = t++;
+			val[i] = -1.0;
+			src[i] = -1;
+		}
+	}
+	/* rowStart[r] is now the start of row r + 1 */
+	for (r = m; r > 0; --r) {
+		rowStart[r] = rowStart[r - 1];
+	}
+	rowStart[0] = 0;
+	memcpy(D->p, A->p, (A->n + 1) * sizeof(scs_int));
+	for (j = A->n; j < n; ++j) {
+		D->p[j + 1] = D->p[j] + 2;
+	}
+	memcpy(next, D->p, n * sizeof(scs_int));
+	for (r = 0; r < m; ++r) {
+		for (i = rowStart[r]; i < rowStart[r + 1]; ++i) {
+			q = next[col[i]]++;
+			D->i[q] = r;
+			D->x[q] = val[i];
+			if (src[i] >= 0) {
+				ch->aMap[src[i]] = q;
+			}
+		}
+	}
+	memcpy(ch->Ax, D->x, nnz * sizeof(scs_float));
+	ok = 1;
+out:
+	if (rowStart)
+		scs_free(rowStart);
+	if (col)
+		scs_free(col);
+	if (src)
+		scs_free(src);
+	if (next)
+		scs_free(next);
+	if (val)
+		scs_free(val);
+	return ok;
+}
+#endif
+
+ChordalWork * initChordal(const Data * d, const Cone * k) {
+#ifdef LAPACK_LIB_FOUND
+	scs_int i, q, row, len, nc, numBlocks = 0, m = d->m, ok = 0;
+	scs_int * rowUsed;
+	ChordalWork * ch;
+	ChordalBlock blk;
+	if (!k->ssize || !k->s) {
+		return SCS_NULL;
+	}
+	for (i = 0; i < k->ssize; ++i) {
+		numBlocks += k->s[i] >= CHORDAL_MIN_SIZE;
+	}
+	if (!numBlocks) {
+		return SCS_NULL;
+	}
+	ch = scs_calloc(1, sizeof(ChordalWork));
+	rowUsed = scs_calloc(m, sizeof(scs_int));
+	if (!ch || !rowUsed || !(ch->blocks = scs_calloc(numBlocks, sizeof(ChordalBlock)))) {
+		goto out;
+	}
+	ch->m = m;
+	ch->n = d->n;
+	for (q = 0; q < d->A->p[d->A->n]; ++q) {
+		rowUsed[d->A->i[q]] = 1;
+	}
+	for (i = 0; i < m; ++i) {
+		rowUsed[i] |= d->b[i] != 0.0;
+	}
+	row = k->f + k->l;
+	for (i = 0; i < k->qsize; ++i) {
+		row += k->q[i];
+	}
+	for (i = 0; i < k->ssize; ++i) {
+		len = (k->s[i] * (k->s[i] + 1)) / 2;
+		if (k->s[i] >= CHORDAL_MIN_SIZE && decomposeBlock(&blk, rowUsed, row, k->s[i])) {
+			ch->blocks[ch->numBlocks++] = blk;
+			ch->numCliques += blk.numCliques;
+			ch->maxClique = MAX(ch->maxClique, blk.maxClique);
+			ch->maxSize = MAX(ch->maxSize, blk.n);
+		}
+		row += len;
+	}
+	if (!ch->numBlocks) {
+		goto out;
+	}
+	/* the decomposed problem */
+	ch->d = scs_calloc(1, sizeof(Data));
+	ch->k = scs_malloc(sizeof(Cone));
+	ch->rowMap = scs_malloc(m * sizeof(scs_int));
+	if (!ch->d || !ch->k || !ch->rowMap) {
+		goto out;
+	}
+	*(ch->k) = *k;
+	ch->k->s = scs_malloc((k->ssize + ch->numCliques - ch->numBlocks) * sizeof(scs_int));
+	len = m;
+	for (i = 0; i < ch->numBlocks; ++i) {
+		for (q = 0; q < ch->blocks[i].numCliques; ++q) {
+			nc = ch->blocks[i].start[q + 1] - ch->blocks[i].start[q];
+			len += (nc * (nc + 1)) / 2;
+		}
+		len -= (ch->blocks[i].n * (ch->blocks[i].n + 1)) / 2;
+	}
+	ch->origRow = scs_malloc(len * sizeof(scs_int));
+	if (!ch->k->s || !ch->origRow) {
+		goto out;
+	}
+	ch->k->ssize = k->ssize + ch->numCliques - ch->numBlocks;
+	ch->d->m = layOutRows(ch, k, ch->k->s);
+	ch->d->n = d->n + ch->numOverlaps;
+	ch->d->stgs = d->stgs;
+	/* every nonempty row is in the chordal extension */
+	for (i = 0; i < m; ++i) {
+		if (rowUsed[i] && ch->rowMap[i] < 0) {
+			scs_printf("ERROR: chordal decomposition lost row %li\n", (long) i);
+			goto out;
+		}
+	}
+	ch->d->b = scs_malloc(ch->d->m * sizeof(scs_float));
+	ch->d->c = scs_malloc(ch->d->n * sizeof(scs_float));
+	ch->sol = scs_calloc(1, sizeof(Sol));
+	if (!ch->d->b || !ch->d->c || !ch->sol || !buildA(ch, d->A)) {
+		goto out;
+	}
+	ch->sol->x = scs_malloc(ch->d->n * sizeof(scs_float));
+	ch->sol->y = scs_malloc(ch->d->m * sizeof(scs_float));
+	ch->sol->s = scs_malloc(ch->d->m * sizeof(scs_float));
+	ok = ch->sol->x && ch->sol->y && ch->sol->s;
+out:
+	if (rowUsed)
+		scs_free(rowUsed);
+	if (!ok) {
+		finishChordal(ch);
+		return SCS_NULL;
+	}
+	return ch;
+#else
+	return SCS_NULL;
+#endif
+}
+
+Data * getChordalData(ChordalWork * ch) {
+	return ch->d;
+}
+
+Cone * getChordalCone(ChordalWork * ch) {
+	return ch->k;
+}
+
+Sol * getChordalSol(ChordalWork * ch) {
+	return ch->sol;
+}
+
+scs_int chordalForward(ChordalWork * ch, const scs_float * b, const scs_float * c, scs_float * bOut, scs_float * cOut,
+		const Sol * sol, Sol * dsol) {
+	scs_int i, r, n = ch->n, m = ch->d->m;
+	for (i = 0; i < ch->m; ++i) {
+		if (ch->rowMap[i] < 0 && b[i] != 0.0) {
+			scs_printf("ERROR: b[%li] is outside the sparsity pattern of the SD blocks found by scs_init, "
+					"set chordal_decomposition = 0\n", (long) i);
+			return -1;
+		}
+	}
+	for (r = 0; r < m; ++r) {
+		i = ch->origRow[r];
+		bOut[r] = ch->rowMap[i] == r ? b[i] : 0.0;
+	}
+	memcpy(cOut, c, n * sizeof(scs_float));
+	memset(&(cOut[n]), 0, ch->numOverlaps * sizeof(scs_float));
+	if (sol) {
+		/*
+		 * t and the slacks of the cliques other than the owner are those of the last decomposed solution (0 without
+		 * one), the owner's slack the rest of the entry's, so that the warm start from a solution mapped back by
+		 * chordalBackward is the decomposed solution it came from. every clique's dual variable is the entry's
+		 */
+		memcpy(dsol->x, sol->x, n * sizeof(scs_float));
+		if (!ch->haveSol) {
+			memset(&(dsol->x[n]), 0, ch->numOverlaps * sizeof(scs_float));
+		} else if (dsol != ch->sol) {
+			memcpy(&(dsol->x[n]), &(ch->sol->x[n]), ch->numOverlaps * sizeof(scs_float));
+		}
+		for (r = 0; r < m; ++r) {
+			i = ch->origRow[r];
+			if (ch->rowMap[i] == r) {
+				dsol->s[r] = sol->s[i];
+			} else {
+				dsol->s[r] = ch->haveSol ? ch->sol->s[r] : 0.0;
+			}
+			dsol->y[r] = sol->y[i];
+		}
+		for (r = 0; r < m; ++r) {
+			i = ch->origRow[r];
+			if (ch->rowMap[i] != r) {
+				dsol->s[ch->rowMap[i]] -= dsol->s[r];
+			}
+		}
+	}
+	if (dsol == ch->sol) {
+		ch->haveSol = 0;
+	}
+	return 0;
+}
+
+#ifdef LAPACK_LIB_FOUND
+/*
+ * fills the entries of the dual variables y of one decomposed block outside its chordal extension with the maximum
+ * determinant PSD completion, clique by clique from the root of the clique tree down: with R the vertices the clique
+ * adds, S the rest of the clique (its separator, done with its parent) and O the other vertices done so far,
+ * Y_RO = Y_RS Y_SS^+ Y_SO.
+ * the clique blocks of an approximate solution are only PSD up to the solver tolerance (the cliques agree on the
+ * overlaps only approximately), and with a nearly singular Y_SS the completion amplifies that error. so it is the
+ * completion of Y + delta I, whose clique blocks are positive definite, and the completed Y has eigenvalues >= -delta
+ */
+static void completeBlock(const ChordalBlock * blk, scs_float * y, const scs_int * rowMap) {
+	scs_int i, j, a, c, l, idx, nc, nr, ns, no, nd = 0, n = blk->n, mc = blk->maxClique;
+	blasint nsb, nrb, nob, mb = 0, lwork = 26 * mc, liwork = 10 * mc, info;
+	scs_float sqrt2 = SQRTF(2.0), pOne = 1.0, zero = 0.0, eigTol = 1e-12, tol, vl, vu, lo = 0.0, hi = 0.0;
+	scs_float *Y = scs_malloc(n * n * sizeof(scs_float)), *Yss = scs_malloc(mc * mc * sizeof(scs_float));
+	scs_float *Q = scs_malloc(mc * mc * sizeof(scs_float)), *Yrs = scs_malloc(mc * mc * sizeof(scs_float));
+	scs_float *e = scs_malloc(mc * sizeof(scs_float)), *work = scs_malloc(lwork * sizeof(scs_float));
+	scs_float *B = scs_malloc(mc * n * sizeof(scs_float)), *T = scs_malloc(mc * n * sizeof(scs_float));
+	scs_int *R = scs_malloc(mc * sizeof(scs_int)), *S = scs_malloc(mc * sizeof(scs_int));
+	scs_int *O = scs_malloc(n * sizeof(scs_int)), *done = scs_malloc(n * sizeof(scs_int));
+	scs_int *inS = scs_calloc(n, sizeof(scs_int));
+	blasint *iwork = scs_malloc(liwork * sizeof(blasint)), *isuppz = scs_malloc(2 * mc * sizeof(blasint));
+	const scs_int * verts;
+	if (!Y || !Yss || !Q || !Yrs || !e || !work || !B || !T || !R || !S || !O || !done || !inS || !iwork || !isuppz) {
+		scs_printf("ERROR: chordal completion memory allocation failure\n");
+		goto out;
+	}
+	for (j = 0, idx = 0; j < n; ++j) {
+		for (i = j; i < n; ++i, ++idx) {
+			Y[i + j * n] = Y[j + i * n] = (i == j ? 1.0 : 1.0 / sqrt2) * y[idx];
+			if (y[idx] != y[idx]) {
+				/* no dual variables (unbounded, failure) */
+				for (idx = 0; idx < (n * (n + 1)) / 2; ++idx) {
+					y[idx] = rowMap[idx] < 0 ? NAN : y[idx];
+				}
+				goto out;
+			}
+		}
+	}
+	for (c = 0; c < blk->numCliques; ++c) {
+		verts = &(blk->verts[blk->start[c]]);
+		nc = blk->start[c + 1] - blk->start[c];
+		for (j = 0; j < nc; ++j) {
+			for (i = j; i < nc; ++i) {
+				Yss[i + j * nc] = Y[verts[i] + verts[j] * n];
+			}
+		}
+		nsb = (blasint) nc;
+		BLAS(syevr)("NoVectors", "All", "Lower", &nsb, Yss, &nsb, &vl, &vu, SCS_NULL, SCS_NULL, &eigTol, &mb, e,
+				SCS_NULL, &nsb, isuppz, work, &lwork, iwork, &liwork, &info);
+		lo = MIN(lo, e[0]);
+		hi = MAX(hi, MAX(ABS(e[0]), ABS(e[nc - 1])));
+	}
+	tol = CHORDAL_SHIFT * (-lo) + CHORDAL_PINV_TOL * hi;
+	for (i = 0; i < n; ++i) {
+		Y[i * (n + 1)] += tol;
+	}
+	for (c = blk->numCliques - 1; c >= 0; --c) {
+		verts = &(blk->verts[blk->start[c]]);
+		nc = blk->start[c + 1] - blk->start[c];
+		for (a = 0, nr = 0, ns = 0; a < nc; ++a) {
+			if (blk->owner[verts[a]] == c) {
+				R[nr++] = verts[a];
+			} else {
+				S[ns++] = verts[a];
+				inS[verts[a]] = 1;
+			}
+		}
+		for (a = 0, no = 0; a < nd; ++a) {
+			if (!inS[done[a]]) {
+				O[no++] = done[a];
+			}
+		}
+		if (nr > 0 && ns > 0 && no > 0) {
+			for (j = 0; j < ns; ++j) {
+				for (i = 0; i < ns; ++i) {
+					Yss[i + j * ns] = Y[S[i] + S[j] * n];
+				}
+				for (i = 0; i < nr; ++i) {
+					Yrs[i + j * nr] = Y[R[i] + S[j] * n];
+				}
+			}
+			for (j = 0; j < no; ++j) {
+				for (i = 0; i < ns; ++i) {
+					B[i + j * ns] = Y[S[i] + O[j] * n];
+				}
+			}
+			nsb = (blasint) ns;
+			nrb = (blasint) nr;
+			nob = (blasint) no;
+			BLAS(syevr)("Vectors", "All", "Lower", &nsb, Yss, &nsb, &vl, &vu, SCS_NULL, SCS_NULL, &eigTol, &mb, e, Q,
+					&nsb, isuppz, work, &lwork, iwork, &liwork, &info);
+			tol = CHORDAL_PINV_TOL * MAX(ABS(e[0]), ABS(e[ns - 1]));
+			/* B = Q diag(e)^+ Q' B, then T = Y_RS B */
+			BLAS(gemm)("Transpose", "NoTranspose", &nsb, &nob, &nsb, &pOne, Q, &nsb, B, &nsb, &zero, T, &nsb);
+			for (l = 0; l < ns; ++l) {
+				vl = e[l] > tol ? 1.0 / e[l] : 0.0;
+				for (j = 0; j < no; ++j) {
+					T[l + j * ns] *= vl;
+				}
+			}
+			BLAS(gemm)("NoTranspose", "NoTranspose", &nsb, &nob, &nsb, &pOne, Q, &nsb, T, &nsb, &zero, B, &nsb);
+			BLAS(gemm)("NoTranspose", "NoTranspose", &nrb, &nob, &nsb, &pOne, Yrs, &nrb, B, &nsb, &zero, T, &nrb);
+			for (j = 0; j < no; ++j) {
+				for (i = 0; i < nr; ++i) {
+					Y[R[i] + O[j] * n] = Y[O[j] + R[i] * n] = T[i + j * nr];
+				}
+			}
+		}
+		for (a = 0; a < ns; ++a) {
+			inS[S[a]] = 0;
+		}
+		for (a = 0; a < nr; ++a) {
+			done[nd++] = R[a];
+		}
+	}
+	for (j = 0, idx = 0; j < n; ++j) {
+		for (i = j; i < n; ++i, ++idx) {
+			if (rowMap[idx] < 0) {
+				y[idx] = sqrt2 * Y[i + j * n];
+			}
+		}
+	}
+out:
+	if (Y)
+		scs_free(Y);
+	if (Yss)
+		scs_free(Yss);
+	if (Q)
+		scs_free(Q);
+	if (Yrs)
+		scs_free(Yrs);
+	if (e)
+		scs_free(e);
+	if (work)
+		scs_free(work);
+	if (B)
+		scs_free(B);
+	if (T)
+		scs_free(T);
+	if (R)
+		scs_free(R);
+	if (S)
+		scs_free(S);
+	if (O)
+		scs_free(O);
+	if (done)
+		scs_free(done);
+	if (inS)
+		scs_free(inS);
+	if (iwork)
+		scs_free(iwork);
+	if (isuppz)
+		scs_free(isuppz);
+}
+#endif
+
+void chordalBackward(ChordalWork * ch, const Sol * dsol, Sol * sol) {
+	scs_int i, r;
+	if (!sol->x)
+		sol->x = scs_malloc(ch->n * sizeof(scs_float));
+	if (!sol->y)
+		sol->y = scs_malloc(ch->m * sizeof(scs_float));
+	if (!sol->s)
+		sol->s = scs_malloc(ch->m * sizeof(scs_float));
+	memcpy(sol->x, dsol->x, ch->n * sizeof(scs_float));
+	ch->haveSol = dsol == ch->sol;
+	/* the slacks of the cliques sum to the original one, their dual variables agree with the owner's */
+	memset(sol->s, 0, ch->m * sizeof(scs_float));
+	for (r = 0; r < ch->d->m; ++r) {
+		sol->s[ch->origRow[r]] += dsol->s[r];
+	}
+	for (i = 0; i < ch->m; ++i) {
+		sol->y[i] = ch->rowMap[i] >= 0 ? dsol->y[ch->rowMap[i]] : 0.0;
+	}
+#ifdef LAPACK_LIB_FOUND
+	for (i = 0; i < ch->numBlocks; ++i) {
+		if (ch->blocks[i].numDropped > 0) {
+			completeBlock(&(ch->blocks[i]), &(sol->y[ch->blocks[i].row]), &(ch->rowMap[ch->blocks[i].row]));
+		}
+	}
+#endif
+}
+
+const scs_float * chordalUpdateA(ChordalWork * ch, const scs_float * Ax_new) {
+	scs_int q, nnz = ch->d->A->p[ch->n];
+	/* the overlap columns keep their values */
+	for (q = 0; q < nnz; ++q) {
+		ch->Ax[ch->aMap[q]] = Ax_new[q];
+	}
+	return ch->Ax;
+}
+
+char * getChordalSummary(ChordalWork * ch) {
+	char * str = scs_malloc(sizeof(char) * 256);
+	sprintf(str, "Chordal decomposition: %li SD block%s (largest %lix%li) into %li cliques (largest %lix%li), "
+			"%li overlap variables\n", (long) ch->numBlocks, ch->numBlocks > 1 ? "s" : "", (long) ch->maxSize,
+			(long) ch->maxSize, (long) ch->numCliques, (long) ch->maxClique, (long) ch->maxClique,
+			(long) ch->numOverlaps);
+	return str;
+}
+
+void finishChordal(ChordalWork * ch) {
+	scs_int i;
+	if (!ch) {
+		return;
+	}
+	if (ch->d) {
+		if (ch->d->A) {
+			freeAMatrix(ch->d->A);
+		}
+		if (ch->d->b)
+			scs_free(ch->d->b);
+		if (ch->d->c)
+			scs_free(ch->d->c);
+		scs_free(ch->d);
+	}
+	if (ch->k) {
+		if (ch->k->s)
+			scs_free(ch->k->s);
+		scs_free(ch->k);
+	}
+	if (ch->sol) {
+		freeSol(ch->sol);
+	}
+	if (ch->blocks) {
+		for (i = 0; i < ch->numBlocks; ++i) {
+			freeBlock(&(ch->blocks[i]));
+		}
+		scs_free(ch->blocks);
+	}
+	if (ch->rowMap)
+		scs_free(ch->rowMap);
+	if (ch->origRow)
+		scs_free(ch->origRow);
+	if (ch->aMap)
+		scs_free(ch->aMap);
+	if (ch->Ax)
+		scs_free(ch->Ax);
+	scs_free(ch);
+}
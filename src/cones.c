@@ -6,6 +6,50 @@
 #define CONE_THRESH (1e-6)
 #define EXP_CONE_MAX_ITERS (100)
 #define POW_CONE_MAX_ITERS (20)
+#define GEN_POW_CONE_MAX_ITERS (50)
+#define EXP_CONE_RHO_TOL (1e-8) /* absolute tolerance on the dual variable of the exponential cone projection */
+#define EXP_CONE_TOL_START (1e-2) /* its relative tolerance in the first iteration, decays as 1 / iter^CONE_RATE */
+#define BOX_CONE_MAX_ITERS (100)
+#define BOX_CONE_INF (1e20) /* box cone bounds at least this large in magnitude are infinite */
+
+/* rough flop counts used to balance the cone projection jobs over the threads */
+#define SOC_COST (4.0) /* per entry */
+#define SD_COST (10.0) /* times s^3, dominated by the eigendecomposition */
+#define CS_COST (4 * SD_COST) /* times n^3, a complex multiply-add is four real ones */
+#define POW_COST (200.0) /* per triple, a few Newton steps */
+#define GEN_POW_COST (70.0) /* per entry of a generalized power cone, a few Newton steps */
+#define CONE_JOBS_PER_THREAD (8) /* more jobs than threads so dynamic scheduling can even out the load */
+#define CONE_JOB_MIN_COST (1e4) /* don't make jobs so small that scheduling them costs more than projecting */
+#define SOC_LANES (8) /* SOC blocks of the same dimension projected side by side */
+#define SOC_LANES_MAX_DIM (16) /* larger SOC blocks are projected one at a time */
+#define SOC_SORT_WINDOW (64 * SOC_LANES) /* blocks are sorted by dimension within windows, to keep locality */
+#define SD_SMALL_MAX_DIM (8) /* SD blocks up to this size are projected by Jacobi eigendecompositions, without LAPACK */
+#define SD_LANES (8) /* small SD blocks of the same size projected side by side */
+#define SD_SORT_WINDOW (64 * SD_LANES) /* blocks are sorted by size within windows, to keep locality */
+#define SD_JACOBI_MAX_SWEEPS (15)
+#ifndef FLOAT
+#define SD_JACOBI_TOL (1e-13) /* on the off-diagonal entries, relative to the Frobenius norm of the block */
+#else
+#define SD_JACOBI_TOL (1e-6)
+#endif
+#define SD_SUMMARY_MAX_BLOCKS (10) /* SD blocks listed with their pretest hit rates in getConeSummary */
+
+/* warm-started partial eigendecompositions of the SD blocks (sdp_warm_eig) */
+#define SD_WARM_EIG_MIN_SIZE (150) /* smaller blocks always use the full decomposition, it is about as fast */
+#define SD_WARM_EIG_OVERSAMPLE (8) /* Ritz vectors kept beyond those with positive Ritz values */
+#define SD_WARM_EIG_DEPTH (3) /* Rayleigh-Ritz on span(V, X V, ..., X^(depth - 1) V) */
+#define SD_WARM_EIG_MAX_STEPS (4) /* Rayleigh-Ritz steps per projection */
+#define SD_WARM_EIG_LANCZOS (10) /* Lanczos steps checking that no positive eigenvalue was missed */
+#define SD_WARM_EIG_MAX_BACKOFF (16) /* most full decompositions in a row after failed warm starts */
+#ifndef FLOAT
+#define SD_WARM_EIG_TOL (1e-8) /* on the residuals, relative to the Frobenius norm of the block */
+#else
+#define SD_WARM_EIG_TOL (1e-4)
+#endif
+
+#ifdef OPENMP
+#include <omp.h>
+#endif
 
 #ifdef LAPACK_LIB_FOUND
 void BLAS(syevr)(char* jobz, char* range, char* uplo, blasint* n, scs_float* a, blasint* lda, scs_float* vl,
@@ -15,15 +59,50 @@ void BLAS(syr)(const char *uplo, const blasint *n, const scs_float *alpha, const
 		scs_float *a, const blasint *lda);
 void BLAS(scal)(const blasint *n, const scs_float *sa, scs_float *sx, const blasint *incx);
 scs_float BLAS(nrm2)(const blasint *n, scs_float *x, const blasint *incx);
+void BLAS(potrf)(const char *uplo, const blasint *n, scs_float *a, const blasint *lda, blasint *info);
+void BLAS(symm)(const char *side, const char *uplo, const blasint *m, const blasint *n, const scs_float *alpha,
+		const scs_float *a, const blasint *lda, const scs_float *b, const blasint *ldb, const scs_float *beta,
+		scs_float *c, const blasint *ldc);
+void BLAS(symv)(const char *uplo, const blasint *n, const scs_float *alpha, const scs_float *a, const blasint *lda,
+		const scs_float *x, const blasint *incx, const scs_float *beta, scs_float *y, const blasint *incy);
+void BLAS(gemm)(const char *transa, const char *transb, const blasint *m, const blasint *n, const blasint *k,
+		const scs_float *alpha, const scs_float *a, const blasint *lda, const scs_float *b, const blasint *ldb,
+		const scs_float *beta, scs_float *c, const blasint *ldc);
+void BLAS(syrk)(const char *uplo, const char *trans, const blasint *n, const blasint *k, const scs_float *alpha,
+		const scs_float *a, const blasint *lda, const scs_float *beta, scs_float *c, const blasint *ldc);
+void BLAS(gemv)(const char *trans, const blasint *m, const blasint *n, const scs_float *alpha, const scs_float *a,
+		const blasint *lda, const scs_float *x, const blasint *incx, const scs_float *beta, scs_float *y,
+		const blasint *incy);
+/* complex arrays as interleaved real and imaginary parts */
+void BLASC(heevr)(const char *jobz, const char *range, const char *uplo, blasint *n, scs_float *a, blasint *lda,
+		scs_float *vl, scs_float *vu, blasint *il, blasint *iu, scs_float *abstol, blasint *m, scs_float *w, scs_float *z,
+		blasint *ldz, blasint *isuppz, scs_float *work, blasint *lwork, scs_float *rwork, blasint *lrwork,
+		blasint *iwork, blasint *liwork, blasint *info);
+void BLASC(her)(const char *uplo, const blasint *n, const scs_float *alpha, const scs_float *x, const blasint *incx,
+		scs_float *a, const blasint *lda);
 #endif
 
-static timer coneTimer;
-static scs_float totalConeTime;
-
 static scs_int getSdConeSize(scs_int s) {
 	return (s * (s + 1)) / 2;
 }
 
+/* n real diagonal entries and n (n - 1) / 2 complex ones below it */
+static scs_int getCsConeSize(scs_int n) {
+	return n * n;
+}
+
+#ifdef LAPACK_LIB_FOUND
+/* most Ritz vectors kept for a warm-started SD block of size n, beyond that the full decomposition is cheaper */
+static scs_int getSdWarmEigMaxRank(scs_int n) {
+	return n / 8;
+}
+#endif
+
+/* a^a (1-a)^(1-a), scales the dual power cone, fixed for each cone */
+static scs_float powDualScale(scs_float a) {
+	return POWF(a, a) * POWF(1 - a, 1 - a);
+}
+
 /*
  * boundaries will contain array of indices of rows of A corresponding to
  * cone boundaries, boundaries[0] is starting index for cones of size strictly larger than 1
@@ -31,7 +110,7 @@ static scs_int getSdConeSize(scs_int s) {
  */
 scs_int getConeBoundaries(const Cone * k, scs_int ** boundaries) {
 	scs_int i, count = 0;
-	scs_int len = 1 + k->qsize + k->ssize + k->ed + k->ep + k->psize;
+	scs_int len = 1 + k->qsize + k->ssize + k->cssize + k->ed + k->ep + k->psize + k->gpsize + MAX(k->bsize, 0);
 	scs_int * b = scs_malloc(sizeof(scs_int) * len);
 	b[count] = k->f + k->l;
 	count += 1;
@@ -43,6 +122,10 @@ scs_int getConeBoundaries(const Cone * k, scs_int ** boundaries) {
 		b[count + i] = getSdConeSize(k->s[i]);
 	}
 	count += k->ssize;
+	for (i = 0; i < k->cssize; ++i) {
+		b[count + i] = getCsConeSize(k->cs[i]);
+	}
+	count += k->cssize;
 	for (i = 0; i < k->ep + k->ed; ++i) {
 		b[count + i] = 3;
 	}
@@ -51,6 +134,15 @@ scs_int getConeBoundaries(const Cone * k, scs_int ** boundaries) {
         b[count + i] = 3;
     }
 	count += k->psize;
+	for (i = 0; i < k->gpsize; ++i) {
+		b[count + i] = k->gpm[i] + k->gpn[i];
+	}
+	count += k->gpsize;
+	/* the box cone rows are scaled one by one, the bounds with them (setConeScaling) */
+	for (i = 0; i < k->bsize; ++i) {
+		b[count + i] = 1;
+	}
+	count += k->bsize;
 	*boundaries = b;
 	return len;
 }
@@ -71,17 +163,30 @@ scs_int getFullConeDims(const Cone * k) {
 			c += getSdConeSize(k->s[i]);
 		}
 	}
+	if (k->cssize && k->cs) {
+		for (i = 0; i < k->cssize; ++i) {
+			c += getCsConeSize(k->cs[i]);
+		}
+	}
 	if (k->ed)
 		c += 3 * k->ed;
     if (k->ep)
         c += 3 * k->ep;
     if (k->p)
         c += 3 * k->psize;
+    if (k->gpsize && k->gpm && k->gpn) {
+        for (i = 0; i < k->gpsize; ++i) {
+            c += k->gpm[i] + k->gpn[i];
+        }
+    }
+    if (k->bsize > 0)
+        c += k->bsize;
     return c;
 }
 
 scs_int validateCones(const Data * d, const Cone * k) {
-	scs_int i;
+	scs_int i, j, end;
+	scs_float sum;
 	if (getFullConeDims(k) != d->m) {
 		scs_printf("cone dimensions %li not equal to num rows in A = m = %li\n", (long) getFullConeDims(k), (long) d->m);
 		return -1;
@@ -118,6 +223,18 @@ scs_int validateCones(const Data * d, const Cone * k) {
             }
         }
     }
+    if (k->cssize && k->cs) {
+        if (k->cssize < 0) {
+            scs_printf("complex sd cone error\n");
+            return -1;
+        }
+        for (i = 0; i < k->cssize; ++i) {
+            if (k->cs[i] < 0) {
+                scs_printf("complex sd cone error\n");
+                return -1;
+            }
+        }
+    }
     if (k->ed && k->ed < 0) {
         scs_printf("ep cone error\n");
         return -1;
@@ -138,32 +255,196 @@ scs_int validateCones(const Data * d, const Cone * k) {
             }
         }
     }
+    if (k->gpsize) {
+        if (k->gpsize < 0 || !k->gpm || !k->gpn || !k->gpa) {
+            scs_printf("generalized power cone error\n");
+            return -1;
+        }
+        for (i = 0, j = 0; i < k->gpsize; ++i) {
+            if (k->gpm[i] < 1 || k->gpn[i] < 0) {
+                scs_printf("generalized power cone error, cone %li has %li x and %li z entries\n", (long) i,
+                        (long) k->gpm[i], (long) k->gpn[i]);
+                return -1;
+            }
+            for (sum = 0.0, end = j + k->gpm[i]; j < end; ++j) {
+                if (!(k->gpa[j] > 0)) {
+                    scs_printf("generalized power cone error, exponents must be positive\n");
+                    return -1;
+                }
+                sum += k->gpa[j];
+            }
+            if (ABS(sum - 1) > 1e-9) {
+                scs_printf("generalized power cone error, exponents of cone %li sum to %4f, not 1\n", (long) i,
+                        (double) sum);
+                return -1;
+            }
+        }
+    }
+    if (k->bsize) {
+        if (k->bsize < 0 || (k->bsize > 1 && (!k->bl || !k->bu))) {
+            scs_printf("box cone error\n");
+            return -1;
+        }
+        for (i = 0; i < k->bsize - 1; ++i) {
+            if (k->bl[i] > k->bu[i] || k->bl[i] != k->bl[i] || k->bu[i] != k->bu[i]) {
+                scs_printf("box cone error, lower bound %4f > upper bound %4f at %li\n", (double) k->bl[i],
+                        (double) k->bu[i], (long) i);
+                return -1;
+            }
+        }
+    }
    return 0;
 }
 
-char * getConeSummary(const Info * info) {
-	char * str = scs_malloc(sizeof(char) * 64);
-	sprintf(str, "\tCones: avg projection time: %1.2es\n", totalConeTime / (info->iter + 1) / 1e3);
-	totalConeTime = 0.0;
+char * getConeSummary(const Info * info, ConeWork * c) {
+	char * str = scs_malloc(sizeof(char) * (64 + 128 * (SD_SUMMARY_MAX_BLOCKS + 2)));
+#ifdef LAPACK_LIB_FOUND
+	size_t len;
+	scs_int i, shown = 0, projections = 0, psdHits = 0, nsdHits = 0;
+	SdBlockWork * b;
+	len = sprintf(str, "\tCones: avg projection time: %1.2es\n", info->coneTime / (info->iter + 1) / 1e3);
+#else
+	sprintf(str, "\tCones: avg projection time: %1.2es\n", info->coneTime / (info->iter + 1) / 1e3);
+#endif
+#ifdef LAPACK_LIB_FOUND
+	for (i = 0; c && c->sdBlocks && i < c->numSdBlocks; ++i) {
+		projections += c->sdBlocks[i].lastProjections;
+		psdHits += c->sdBlocks[i].lastPsdHits;
+		nsdHits += c->sdBlocks[i].lastNsdHits;
+	}
+	if (projections == 0) {
+		return str;
+	}
+	len += sprintf(&(str[len]), "\tSD blocks: %li of %li projections found PSD (%li) or NSD (%li), no eigendecomposition\n",
+			(long) (psdHits + nsdHits), (long) projections, (long) psdHits, (long) nsdHits);
+	for (i = 0; i < c->numSdBlocks; ++i) {
+		b = &(c->sdBlocks[i]);
+		if (b->lastProjections == 0) {
+			continue;
+		}
+		if (shown == SD_SUMMARY_MAX_BLOCKS) {
+			len += sprintf(&(str[len]), "\t  ... and more blocks\n");
+			break;
+		}
+		len += sprintf(&(str[len]), "\t  block %li: %5.1f%% PSD, %5.1f%% NSD, %5.1f%% warm started\n", (long) i,
+				100.0 * b->lastPsdHits / b->lastProjections, 100.0 * b->lastNsdHits / b->lastProjections,
+				100.0 * b->lastWarmEigs / b->lastProjections);
+		shown++;
+	}
+#endif
 	return str;
 }
 
+void getConeInfo(ConeWork * c, Info * info) {
+#ifdef LAPACK_LIB_FOUND
+	scs_int i;
+	SdBlockWork * b;
+#endif
+	info->sdProjections = info->sdPsdHits = info->sdNsdHits = info->sdWarmEigs = 0;
+#ifdef LAPACK_LIB_FOUND
+	for (i = 0; c->sdBlocks && i < c->numSdBlocks; ++i) {
+		b = &(c->sdBlocks[i]);
+		info->sdProjections += b->projections;
+		info->sdPsdHits += b->psdHits;
+		info->sdNsdHits += b->nsdHits;
+		info->sdWarmEigs += b->warmEigs;
+		b->lastProjections = b->projections;
+		b->lastPsdHits = b->psdHits;
+		b->lastNsdHits = b->nsdHits;
+		b->lastWarmEigs = b->warmEigs;
+		b->projections = b->psdHits = b->nsdHits = b->warmEigs = 0;
+	}
+#endif
+	info->coneTime = c->totalConeTime;
+	info->lpConeTime = c->lpTime;
+	info->socConeTime = c->socTime;
+	info->sdConeTime = c->sdTime;
+	info->expConeTime = c->expTime;
+	info->powConeTime = c->powTime;
+	info->boxConeTime = c->boxTime;
+	c->totalConeTime = c->lpTime = c->socTime = c->sdTime = c->expTime = c->powTime = c->boxTime = 0.0;
+}
+
 void finishCone(ConeWork * c) {
     DEBUG_FUNC
 #ifdef LAPACK_LIB_FOUND
-	if (c->Xs)
-		scs_free(c->Xs);
-	if (c->Z)
-		scs_free(c->Z);
-	if (c->e)
-		scs_free(c->e);
-	if (c->work)
-		scs_free(c->work);
-	if (c->iwork)
-		scs_free(c->iwork);
-#endif
-    if (c)
-        scs_free(c);
+	scs_int t;
+#endif
+	if (!c) {
+		RETURN;
+	}
+#ifdef LAPACK_LIB_FOUND
+	if (c->sd) {
+		for (t = 0; t < c->numThreads; ++t) {
+			if (c->sd[t].Xs)
+				scs_free(c->sd[t].Xs);
+			if (c->sd[t].Z)
+				scs_free(c->sd[t].Z);
+			if (c->sd[t].e)
+				scs_free(c->sd[t].e);
+			if (c->sd[t].work)
+				scs_free(c->sd[t].work);
+			if (c->sd[t].iwork)
+				scs_free(c->sd[t].iwork);
+			if (c->sd[t].XV)
+				scs_free(c->sd[t].XV);
+			if (c->sd[t].H)
+				scs_free(c->sd[t].H);
+			if (c->sd[t].Hz)
+				scs_free(c->sd[t].Hz);
+			if (c->sd[t].He)
+				scs_free(c->sd[t].He);
+			if (c->sd[t].ritz)
+				scs_free(c->sd[t].ritz);
+			if (c->sd[t].coef)
+				scs_free(c->sd[t].coef);
+			if (c->sd[t].lanczos)
+				scs_free(c->sd[t].lanczos);
+			if (c->sd[t].isuppz)
+				scs_free(c->sd[t].isuppz);
+		}
+		scs_free(c->sd);
+	}
+	if (c->sdBlocks) {
+		for (t = 0; t < c->numSdBlocks; ++t) {
+			if (c->sdBlocks[t].V)
+				scs_free(c->sdBlocks[t].V);
+		}
+		scs_free(c->sdBlocks);
+	}
+	if (c->csWork) {
+		for (t = 0; t < c->numThreads; ++t) {
+			if (c->csWork[t].Xs)
+				scs_free(c->csWork[t].Xs);
+			if (c->csWork[t].Z)
+				scs_free(c->csWork[t].Z);
+			if (c->csWork[t].e)
+				scs_free(c->csWork[t].e);
+			if (c->csWork[t].work)
+				scs_free(c->csWork[t].work);
+			if (c->csWork[t].rwork)
+				scs_free(c->csWork[t].rwork);
+			if (c->csWork[t].iwork)
+				scs_free(c->csWork[t].iwork);
+		}
+		scs_free(c->csWork);
+	}
+#endif
+	if (c->jobs)
+		scs_free(c->jobs);
+	if (c->socBlocks)
+		scs_free(c->socBlocks);
+	if (c->sdOrder)
+		scs_free(c->sdOrder);
+	if (c->powScale)
+		scs_free(c->powScale);
+	if (c->gpaStart)
+		scs_free(c->gpaStart);
+	if (c->boxBl)
+		scs_free(c->boxBl);
+	if (c->boxBu)
+		scs_free(c->boxBu);
+	scs_free(c);
     RETURN;
 }
 
@@ -195,19 +476,35 @@ char * getConeHeader(const Cone * k) {
 		}
 		sprintf(tmp + strlen(tmp), "\tsd vars: %li, sd blks: %li\n", (long) sdVars, (long) sdBlks);
 	}
+	if (k->cssize && k->cs) {
+		for (i = 0, sdVars = 0; i < k->cssize; i++) {
+			sdVars += getCsConeSize(k->cs[i]);
+		}
+		sprintf(tmp + strlen(tmp), "\tcomplex sd vars: %li, complex sd blks: %li\n", (long) sdVars, (long) k->cssize);
+	}
 	if (k->ep || k->ed) {
 		sprintf(tmp + strlen(tmp), "\texp vars: %li, dual exp vars: %li\n", (long) 3 * k->ep, (long) 3 * k->ed);
 	}
 	if (k->psize && k->p) {
 		sprintf(tmp + strlen(tmp), "\tprimal + dual power vars: %li\n", (long) 3 * k->psize);
 	}
+	if (k->gpsize && k->gpm && k->gpn) {
+		for (i = 0, socVars = 0; i < k->gpsize; i++) {
+			socVars += k->gpm[i] + k->gpn[i];
+		}
+		sprintf(tmp + strlen(tmp), "\tgeneralized power vars: %li, blks: %li\n", (long) socVars, (long) k->gpsize);
+	}
+	if (k->bsize > 0) {
+		sprintf(tmp + strlen(tmp), "\tbox cone vars: %li\n", (long) k->bsize);
+	}
     return tmp;
 }
 
+/* whether all the SD blocks are small enough to be projected without LAPACK */
 scs_int isSimpleSemiDefiniteCone(scs_int * s, scs_int ssize) {
 	scs_int i;
 	for (i = 0; i < ssize; i++) {
-		if (s[i] > 2) {
+		if (s[i] > SD_SMALL_MAX_DIM) {
 			return 0; /* false */
 		}
 	}
@@ -250,21 +547,29 @@ scs_float expCalcGrad(scs_float * v, scs_float * x, scs_float rho) {
 	return x[0] + x[1] * log(x[1] / x[2]);
 }
 
-void expGetRhoUb(scs_float * v, scs_float * x, scs_float * ub, scs_float * lb) {
-	*lb = 0;
-	*ub = 0.125;
-	while (expCalcGrad(v, x, *ub) > 0) {
-		*lb = *ub;
-		(*ub) *= 2;
+/* derivative of expCalcGrad wrt rho, x is the point expCalcGrad computed for rho */
+static scs_float expCalcGradDeriv(const scs_float * v, const scs_float * x, scs_float rho) {
+	scs_float t = x[2] - v[2], dt, dx1;
+	if (x[1] <= 1e-12 || t <= 0) {
+		return -1.0;
 	}
+	/* implicit derivative of the root t of expNewtonOneD */
+	dt = (2 * x[1] / rho / rho - v[1] / rho / rho + 1 / rho) / ((2 * t + v[2]) / rho / rho + 1 / t);
+	dx1 = ((2 * t + v[2]) * dt - x[1]) / rho;
+	return -1.0 + dx1 * log(x[1] / x[2]) + x[1] * (dt / t - 1 / rho);
 }
 
-/* project onto the exponential cone, v has dimension *exactly* 3 */
-static scs_int projExpCone(scs_float * v, scs_int iter) {
+/*
+ * project onto the exponential cone, v has dimension *exactly* 3. finds the root of the (decreasing) expCalcGrad in
+ * the dual variable rho with Newton steps, falling back to bisection (or doubling while there is no upper bound) when
+ * a step leaves the bracket. rho is a guess to start from, e.g. from the previous projection of this cone (<= 0 if
+ * there is none). iter >= 0 loosens the (relative) tolerance on rho in early iterations.
+ */
+static scs_int projExpCone(scs_float * v, scs_float rho, scs_int iter) {
 	scs_int i;
-	scs_float ub, lb, rho, g, x[3];
+	scs_float ub = -1, lb = 0, r0, g, dg, next, x[3];
 	scs_float r = v[0], s = v[1], t = v[2];
-	scs_float tol = CONE_TOL; /* iter < 0 ? CONE_TOL : MAX(CONE_TOL, 1 / POWF((iter + 1), CONE_RATE)); */
+	scs_float tol = iter < 0 ? CONE_TOL : MAX(CONE_TOL, EXP_CONE_TOL_START / POWF((iter + 1), CONE_RATE));
 
 	/* v in cl(Kexp) */
 	if ((s * exp(r / s) - t <= CONE_THRESH && s > 0) || (r <= 0 && s == 0 && t >= 0)) {
@@ -284,19 +589,28 @@ static scs_int projExpCone(scs_float * v, scs_int iter) {
 		return 0;
 	}
 
-	/* iterative procedure to find projection, bisects on dual variable: */
-	expGetRhoUb(v, x, &ub, &lb); /* get starting upper and lower bounds */
+	r0 = rho > 0 ? rho : 0.125;
 	for (i = 0; i < EXP_CONE_MAX_ITERS; ++i) {
-		rho = (ub + lb) / 2; /* halfway between upper and lower bounds */
-		g = expCalcGrad(v, x, rho); /* calculates gradient wrt dual var */
+		g = expCalcGrad(v, x, r0); /* calculates gradient wrt dual var */
 		if (g > 0) {
-			lb = rho;
+			lb = r0;
 		} else {
-			ub = rho;
+			ub = r0;
+		}
+		/* relative tolerances, since rho is tiny when v is close to the cone, but no tighter than EXP_CONE_RHO_TOL:
+		   expNewtonOneD loses accuracy for tiny rho */
+		if (g == 0 || (ub > 0 && ub - lb < MAX(tol * ub, EXP_CONE_RHO_TOL))) {
+			break;
 		}
-		if (ub - lb < tol) {
+		dg = expCalcGradDeriv(v, x, r0);
+		next = r0 - g / dg;
+		if (dg >= 0 || !(next > lb) || (ub > 0 && !(next < ub))) {
+			next = ub > 0 ? (ub + lb) / 2 : 2 * r0;
+		}
+		if (ABS(next - r0) < MAX(tol * r0, EXP_CONE_RHO_TOL)) {
 			break;
 		}
+		r0 = next;
 	}
 	/*
 #if EXTRAVERBOSE > 0
@@ -309,64 +623,432 @@ static scs_int projExpCone(scs_float * v, scs_int iter) {
 	return 0;
 }
 
+/* one workspace per thread, since the SD blocks are projected in parallel */
 scs_int setUpSdConeWorkSpace(ConeWork * c, const Cone * k) {
 #ifdef LAPACK_LIB_FOUND
-    scs_int i;
+    scs_int i, t, nWarm = 0, kWarm;
     blasint nMax = 0;
     scs_float eigTol = 1e-8;
     blasint negOne = -1;
     blasint m = 0;
     blasint info;
+    blasint liwork;
     scs_float wkopt;
+    SdConeWork * sd;
 #if EXTRAVERBOSE > 0
 #define _STR_EXPAND(tok) #tok
 #define _STR(tok) _STR_EXPAND(tok)
     scs_printf("BLAS(func) = '%s'\n", _STR(BLAS(func)));
 #endif
-    /* eigenvector decomp workspace */
+    /* eigenvector decomp workspace, for the blocks too large for the Jacobi kernel */
     for (i = 0; i < k->ssize; ++i) {
-        if (k->s[i] > nMax) {
+        if (k->s[i] > SD_SMALL_MAX_DIM && k->s[i] > nMax) {
             nMax = (blasint) k->s[i];
         }
+        if (k->s[i] >= SD_WARM_EIG_MIN_SIZE && k->s[i] > nWarm) {
+            nWarm = k->s[i];
+        }
     }
-    c->Xs = scs_calloc(nMax * nMax, sizeof(scs_float));
-    c->Z = scs_calloc(nMax * nMax, sizeof(scs_float));
-    c->e = scs_calloc(nMax, sizeof(scs_float));
-
-    BLAS(syevr)("Vectors", "All", "Lower", &nMax, c->Xs, &nMax, SCS_NULL, SCS_NULL, SCS_NULL, SCS_NULL,
-            &eigTol, &m, c->e, c->Z, &nMax, SCS_NULL, &wkopt, &negOne, &(c->liwork), &negOne, &info);
-
-    if (info != 0) {
-        scs_printf("FATAL: syevr failure, info = %li\n", (long) info);
+    c->sd = scs_calloc(c->numThreads, sizeof(SdConeWork));
+    if (!c->sd) {
         return -1;
     }
-    c->lwork = (blasint) (wkopt + 0.01); /* 0.01 for int casting safety */
-    c->work = scs_malloc(c->lwork * sizeof(scs_float));
-    c->iwork = scs_malloc(c->liwork * sizeof(blasint));
-
-    if (!c->Xs || !c->Z || !c->e || !c->work || !c->iwork) {
+    /* the warm starts themselves are allocated on first use, only if sdp_warm_eig is set */
+    c->numSdBlocks = k->ssize;
+    c->sdBlocks = scs_calloc(k->ssize, sizeof(SdBlockWork));
+    if (!c->sdBlocks) {
         return -1;
     }
+    kWarm = SD_WARM_EIG_DEPTH * getSdWarmEigMaxRank(nWarm);
+    for (t = 0; t < c->numThreads; ++t) {
+        sd = &(c->sd[t]);
+        sd->Xs = scs_calloc(nMax * nMax, sizeof(scs_float));
+        sd->Z = scs_calloc(nMax * nMax, sizeof(scs_float));
+        sd->e = scs_calloc(nMax, sizeof(scs_float));
+        if (!sd->Xs || !sd->Z || !sd->e) {
+            return -1;
+        }
+        if (t == 0) {
+            BLAS(syevr)("Vectors", "All", "Lower", &nMax, sd->Xs, &nMax, SCS_NULL, SCS_NULL, SCS_NULL, SCS_NULL,
+                    &eigTol, &m, sd->e, sd->Z, &nMax, SCS_NULL, &wkopt, &negOne, &liwork, &negOne, &info);
+
+            if (info != 0) {
+                scs_printf("FATAL: syevr failure, info = %li\n", (long) info);
+                return -1;
+            }
+        }
+        sd->lwork = (blasint) (wkopt + 0.01); /* 0.01 for int casting safety */
+        sd->liwork = liwork;
+        sd->work = scs_malloc(sd->lwork * sizeof(scs_float));
+        sd->iwork = scs_malloc(sd->liwork * sizeof(blasint));
+        if (!sd->work || !sd->iwork) {
+            return -1;
+        }
+        if (nWarm > 0) {
+            /* the subspace and X times it use Z */
+            sd->XV = scs_malloc(nWarm * getSdWarmEigMaxRank(nWarm) * sizeof(scs_float));
+            sd->H = scs_malloc(kWarm * kWarm * sizeof(scs_float));
+            sd->Hz = scs_malloc(kWarm * kWarm * sizeof(scs_float));
+            sd->He = scs_malloc(kWarm * sizeof(scs_float));
+            sd->ritz = scs_malloc(kWarm * sizeof(scs_float));
+            sd->coef = scs_malloc((kWarm + SD_WARM_EIG_LANCZOS + 1) * sizeof(scs_float));
+            sd->lanczos = scs_malloc(nWarm * (SD_WARM_EIG_LANCZOS + 1) * sizeof(scs_float));
+            sd->isuppz = scs_malloc(2 * kWarm * sizeof(blasint));
+            if (!sd->XV || !sd->H || !sd->Hz || !sd->He || !sd->ritz || !sd->coef || !sd->lanczos || !sd->isuppz) {
+                return -1;
+            }
+        }
+    }
     return 0;
 #else
-    scs_printf("FATAL: Cannot solve SDPs with > 2x2 matrices without linked blas+lapack libraries\n");
+    scs_printf("FATAL: Cannot solve SDPs with > %lix%li matrices without linked blas+lapack libraries\n",
+            (long) SD_SMALL_MAX_DIM, (long) SD_SMALL_MAX_DIM);
     scs_printf("Edit scs.mk to point to blas+lapack libray locations\n");
     return SCS_NULL;
 #endif
 }
 
+/*
+ * one workspace per thread for the Hermitian PSD blocks larger than 1 x 1, the others are projected without LAPACK.
+ * returns -1 on failure
+ */
+static scs_int setUpCsConeWorkSpace(ConeWork * c, const Cone * k) {
+	scs_int i;
+#ifdef LAPACK_LIB_FOUND
+	scs_int t;
+	blasint nb, negOne = -1, m = 0, info, liwork;
+	scs_float eigTol = CONE_TOL, wkopt[2], rwkopt;
+	CsConeWork * w;
+#endif
+	scs_int nMax = 0;
+	for (i = 0; i < k->cssize; ++i) {
+		nMax = MAX(nMax, k->cs[i]);
+	}
+	if (nMax <= 1) {
+		return 0;
+	}
+#ifdef LAPACK_LIB_FOUND
+	nb = (blasint) nMax;
+	c->csWork = scs_calloc(c->numThreads, sizeof(CsConeWork));
+	if (!c->csWork) {
+		return -1;
+	}
+	for (t = 0; t < c->numThreads; ++t) {
+		w = &(c->csWork[t]);
+		w->Xs = scs_calloc(2 * nMax * nMax, sizeof(scs_float));
+		w->Z = scs_calloc(2 * nMax * nMax, sizeof(scs_float));
+		w->e = scs_calloc(nMax, sizeof(scs_float));
+		if (!w->Xs || !w->Z || !w->e) {
+			return -1;
+		}
+		if (t == 0) {
+			BLASC(heevr)("Vectors", "All", "Lower", &nb, w->Xs, &nb, SCS_NULL, SCS_NULL, SCS_NULL, SCS_NULL,
+					&eigTol, &m, w->e, w->Z, &nb, SCS_NULL, wkopt, &negOne, &rwkopt, &negOne, &liwork, &negOne,
+					&info);
+			if (info != 0) {
+				scs_printf("FATAL: heevr failure, info = %li\n", (long) info);
+				return -1;
+			}
+		}
+		w->lwork = (blasint) (wkopt[0] + 0.01); /* 0.01 for int casting safety */
+		w->lrwork = (blasint) (rwkopt + 0.01);
+		w->liwork = liwork;
+		w->work = scs_malloc(2 * w->lwork * sizeof(scs_float));
+		w->rwork = scs_malloc(w->lrwork * sizeof(scs_float));
+		w->iwork = scs_malloc(w->liwork * sizeof(blasint));
+		if (!w->work || !w->rwork || !w->iwork) {
+			return -1;
+		}
+	}
+	return 0;
+#else
+	scs_printf("FATAL: Cannot solve Hermitian PSD cones larger than 1x1 without linked blas+lapack libraries\n");
+	scs_printf("Edit scs.mk to point to blas+lapack libray locations\n");
+	return -1;
+#endif
+}
+
+static scs_float getConeBlockCost(const Cone * k, scs_int type, scs_int i) {
+	switch (type) {
+	case CONE_JOB_SOC:
+		return SOC_COST * k->q[i];
+	case CONE_JOB_SD:
+		return SD_COST * k->s[i] * k->s[i] * k->s[i];
+	case CONE_JOB_CS:
+		return CS_COST * k->cs[i] * k->cs[i] * k->cs[i];
+	case CONE_JOB_GPOW:
+		return GEN_POW_COST * (k->gpm[i] + k->gpn[i]);
+	default:
+		return POW_COST;
+	}
+}
+
+static scs_int getConeBlockRows(const Cone * k, scs_int type, scs_int i) {
+	switch (type) {
+	case CONE_JOB_SOC:
+		return k->q[i];
+	case CONE_JOB_SD:
+		return getSdConeSize(k->s[i]);
+	case CONE_JOB_CS:
+		return getCsConeSize(k->cs[i]);
+	case CONE_JOB_GPOW:
+		return k->gpm[i] + k->gpn[i];
+	default:
+		return 3;
+	}
+}
+
+/* largest cost first, ties in row order so the job order does not depend on the qsort implementation */
+static int compareConeJobs(const void * a, const void * b) {
+	const ConeJob * ja = (const ConeJob *) a;
+	const ConeJob * jb = (const ConeJob *) b;
+	if (ja->cost != jb->cost) {
+		return ja->cost > jb->cost ? -1 : 1;
+	}
+	return ja->start < jb->start ? -1 : (ja->start > jb->start);
+}
+
+/*
+ * groups the SOC, SD, Hermitian PSD and (generalized) power cone blocks into jobs of at least totalCost / (CONE_JOBS_PER_THREAD * numThreads)
+ * estimated flops each (a bigger block is a job on its own), and sorts them largest first, so that handing them
+ * out to the threads in order keeps the threads evenly loaded
+ */
+static scs_int setUpConeJobs(ConeWork * c, const Cone * k) {
+	scs_int type, i, row = k->f + k->l, size[5], maxJobs = 0;
+	scs_float totalCost = 0.0, target;
+	ConeJob * job = SCS_NULL;
+
+	size[CONE_JOB_SOC] = (k->qsize && k->q) ? k->qsize : 0;
+	size[CONE_JOB_SD] = (k->ssize && k->s) ? k->ssize : 0;
+	size[CONE_JOB_CS] = (k->cssize && k->cs) ? k->cssize : 0;
+	size[CONE_JOB_POW] = (k->psize && k->p) ? k->psize : 0;
+	size[CONE_JOB_GPOW] = (k->gpsize && k->gpm && k->gpn) ? k->gpsize : 0;
+	for (type = CONE_JOB_SOC; type <= CONE_JOB_GPOW; ++type) {
+		for (i = 0; i < size[type]; ++i) {
+			totalCost += getConeBlockCost(k, type, i);
+		}
+		maxJobs += size[type];
+	}
+	c->numJobs = 0;
+	c->expStart = row;
+	if (maxJobs == 0) {
+		return 0;
+	}
+	c->jobs = scs_malloc(maxJobs * sizeof(ConeJob));
+	if (!c->jobs) {
+		return -1;
+	}
+	target = MAX(totalCost / (CONE_JOBS_PER_THREAD * c->numThreads), CONE_JOB_MIN_COST);
+	for (type = CONE_JOB_SOC; type <= CONE_JOB_GPOW; ++type) {
+		if (type == CONE_JOB_POW) {
+			/* the exponential cones sit between the Hermitian PSD and power cones */
+			c->expStart = row;
+			row += 3 * (k->ep + k->ed);
+		}
+		for (i = 0; i < size[type]; ++i) {
+			if (!job || job->type != type || job->cost >= target) {
+				job = &(c->jobs[c->numJobs++]);
+				job->type = type;
+				job->first = i;
+				job->start = row;
+				job->cost = 0.0;
+			}
+			job->last = i + 1;
+			job->cost += getConeBlockCost(k, type, i);
+			row += getConeBlockRows(k, type, i);
+		}
+	}
+	if (c->numThreads > 1) {
+		qsort(c->jobs, c->numJobs, sizeof(ConeJob), compareConeJobs);
+	}
+	return 0;
+}
+
+static int compareSocBlocks(const void * a, const void * b) {
+	const SocBlock * ba = (const SocBlock *) a;
+	const SocBlock * bb = (const SocBlock *) b;
+	if (ba->q != bb->q) {
+		return ba->q < bb->q ? -1 : 1;
+	}
+	return ba->row < bb->row ? -1 : (ba->row > bb->row);
+}
+
+/* sorts each SOC_SORT_WINDOW blocks of each job by dimension, the job's blocks first, ..., last - 1 are then
+   socBlocks[first], ..., socBlocks[last - 1] and cones of equal dimension can be projected in lanes */
+static scs_int setUpSocBlocks(ConeWork * c, const Cone * k) {
+	scs_int i, j, len, row = k->f + k->l;
+	const ConeJob * job;
+	if (!(k->qsize && k->q)) {
+		return 0;
+	}
+	c->socBlocks = scs_malloc(k->qsize * sizeof(SocBlock));
+	if (!c->socBlocks) {
+		return -1;
+	}
+	for (i = 0; i < k->qsize; ++i) {
+		c->socBlocks[i].q = k->q[i];
+		c->socBlocks[i].row = row;
+		row += k->q[i];
+	}
+	for (i = 0; i < c->numJobs; ++i) {
+		job = &(c->jobs[i]);
+		if (job->type != CONE_JOB_SOC) {
+			continue;
+		}
+		for (j = job->first; j < job->last; j += SOC_SORT_WINDOW) {
+			/* MIN evaluates its arguments twice */
+			len = job->last - j;
+			len = MIN(len, SOC_SORT_WINDOW);
+			qsort(&(c->socBlocks[j]), len, sizeof(SocBlock), compareSocBlocks);
+		}
+	}
+	return 0;
+}
+
+static int compareSdBlockRefs(const void * a, const void * b) {
+	const SdBlockRef * ba = (const SdBlockRef *) a;
+	const SdBlockRef * bb = (const SdBlockRef *) b;
+	if (ba->n != bb->n) {
+		return ba->n < bb->n ? -1 : 1;
+	}
+	return ba->row < bb->row ? -1 : (ba->row > bb->row);
+}
+
+/* sorts each SD_SORT_WINDOW blocks of each job by size, the job's blocks first, ..., last - 1 are then
+   sdOrder[first], ..., sdOrder[last - 1] and small blocks of equal size can be projected in lanes */
+static scs_int setUpSdOrder(ConeWork * c, const Cone * k) {
+	scs_int i, j, len, row;
+	const ConeJob * job;
+	if (!(k->ssize && k->s)) {
+		return 0;
+	}
+	c->sdOrder = scs_malloc(k->ssize * sizeof(SdBlockRef));
+	if (!c->sdOrder) {
+		return -1;
+	}
+	row = k->f + k->l;
+	for (i = 0; i < k->qsize; ++i) {
+		row += k->q[i];
+	}
+	for (i = 0; i < k->ssize; ++i) {
+		c->sdOrder[i].n = k->s[i];
+		c->sdOrder[i].row = row;
+		c->sdOrder[i].index = i;
+		row += getSdConeSize(k->s[i]);
+	}
+	for (i = 0; i < c->numJobs; ++i) {
+		job = &(c->jobs[i]);
+		if (job->type != CONE_JOB_SD) {
+			continue;
+		}
+		for (j = job->first; j < job->last; j += SD_SORT_WINDOW) {
+			/* MIN evaluates its arguments twice */
+			len = job->last - j;
+			len = MIN(len, SD_SORT_WINDOW);
+			qsort(&(c->sdOrder[j]), len, sizeof(SdBlockRef), compareSdBlockRefs);
+		}
+	}
+	return 0;
+}
+
+/* the power cone constants don't change during the solve */
+static scs_int setUpPowScales(ConeWork * c, const Cone * k) {
+	scs_int i;
+	if (!(k->psize && k->p)) {
+		return 0;
+	}
+	c->powScale = scs_malloc(k->psize * sizeof(scs_float));
+	if (!c->powScale) {
+		return -1;
+	}
+	for (i = 0; i < k->psize; ++i) {
+		c->powScale[i] = powDualScale(ABS(k->p[i]));
+	}
+	return 0;
+}
+
+static scs_int setUpGenPowStarts(ConeWork * c, const Cone * k) {
+	scs_int i;
+	if (!(k->gpsize && k->gpm && k->gpn)) {
+		return 0;
+	}
+	c->gpaStart = scs_malloc(k->gpsize * sizeof(scs_int));
+	if (!c->gpaStart) {
+		return -1;
+	}
+	for (i = 0; i < k->gpsize; ++i) {
+		c->gpaStart[i] = i > 0 ? c->gpaStart[i - 1] + k->gpm[i - 1] : 0;
+	}
+	return 0;
+}
+
+scs_int setConeScaling(ConeWork * c, scs_float * D) {
+	scs_int i, n = c->boxLen - 1;
+	scs_float r;
+	if (c->boxBl)
+		scs_free(c->boxBl);
+	if (c->boxBu)
+		scs_free(c->boxBu);
+	c->boxBl = c->boxBu = SCS_NULL;
+	if (!D || n <= 0) {
+		return 0;
+	}
+	c->boxBl = scs_malloc(n * sizeof(scs_float));
+	c->boxBu = scs_malloc(n * sizeof(scs_float));
+	if (!c->boxBl || !c->boxBu) {
+		return -1;
+	}
+	for (i = 0, r = 0.0; i < n; ++i) {
+		r += ((c->bl[i] > -BOX_CONE_INF ? c->bl[i] * c->bl[i] : 0.0) + (c->bu[i] < BOX_CONE_INF ? c->bu[i] * c->bu[i] : 0.0))
+				/ (D[c->boxRow + 1 + i] * D[c->boxRow + 1 + i]);
+	}
+	/* t is scaled so the finite bounds in the scaled rows have unit norm, the split between t and s that converges well */
+	D[c->boxRow] = r > 0.0 ? 1.0 / SQRTF(r) : 1.0;
+	for (i = 0; i < n; ++i) {
+		r = D[c->boxRow] / D[c->boxRow + 1 + i];
+		c->boxBl[i] = c->bl[i] > -BOX_CONE_INF ? c->bl[i] * r : c->bl[i];
+		c->boxBu[i] = c->bu[i] < BOX_CONE_INF ? c->bu[i] * r : c->bu[i];
+	}
+	return 0;
+}
+
 ConeWork * initCone(const Cone * k) {
     ConeWork * coneWork = scs_calloc(1, sizeof(ConeWork));
 #if EXTRAVERBOSE > 0
     scs_printf("initCone\n");
 #endif
-    totalConeTime = 0.0;
+    if (!coneWork) {
+        return SCS_NULL;
+    }
+    coneWork->totalConeTime = 0.0;
+    coneWork->lpTime = coneWork->socTime = coneWork->sdTime = coneWork->expTime = coneWork->powTime = 0.0;
+    coneWork->boxTime = 0.0;
+    if (k->bsize > 0) {
+        coneWork->boxRow = getFullConeDims(k) - k->bsize;
+        coneWork->boxLen = k->bsize;
+        coneWork->bl = k->bl;
+        coneWork->bu = k->bu;
+    }
+#ifdef OPENMP
+    coneWork->numThreads = omp_get_max_threads();
+#else
+    coneWork->numThreads = 1;
+#endif
+    if (setUpConeJobs(coneWork, k) < 0 || setUpSocBlocks(coneWork, k) < 0 || setUpSdOrder(coneWork, k) < 0
+            || setUpPowScales(coneWork, k) < 0 || setUpGenPowStarts(coneWork, k) < 0) {
+        finishCone(coneWork);
+        return SCS_NULL;
+    }
     if (k->ssize && k->s) {
         if (!isSimpleSemiDefiniteCone(k->s, k->ssize) && setUpSdConeWorkSpace(coneWork, k) < 0) {
-            scs_free(coneWork);
+            finishCone(coneWork);
             return SCS_NULL;
         }
     }
+    if (k->cssize && k->cs && setUpCsConeWorkSpace(coneWork, k) < 0) {
+        finishCone(coneWork);
+        return SCS_NULL;
+    }
 #if EXTRAVERBOSE > 0
     scs_printf("initCone complete\n");
 #ifdef MATLAB_MEX_FILE
@@ -419,31 +1101,411 @@ scs_int project2By2Sdc(scs_float * X) {
 	return 0;
 }
 
-/* size of X is getSdConeSize(n) */
-static scs_int projSemiDefiniteCone(scs_float * X, const scs_int n, ConeWork * c, const scs_int iter) {
-	/* project onto the positive semi-definite cone */
+/*
+ * projects the SD blocks blocks[0], ..., blocks[lanes - 1] of size 3 <= n <= SD_SMALL_MAX_DIM, lanes <= SD_LANES,
+ * onto the PSD cone by cyclic Jacobi eigendecompositions. the SD_LANES lanes (padded with zero blocks) go through
+ * the same rotations without branches, so the compiler can vectorize across them, and the sweeps stop once every
+ * lane has converged. no LAPACK calls, for tiny blocks their overhead dwarfs the arithmetic
+ */
+static void projSdSmallLanes(scs_float * x, const SdBlockRef * blocks, scs_int lanes, scs_int n) {
+	scs_float A[SD_SMALL_MAX_DIM * SD_SMALL_MAX_DIM * SD_LANES], V[SD_SMALL_MAX_DIM * SD_SMALL_MAX_DIM * SD_LANES];
+	scs_float cs[SD_LANES], sn[SD_LANES], t[SD_LANES], newApp[SD_LANES], newAqq[SD_LANES];
+	scs_float off[SD_LANES], diag[SD_LANES], sum[SD_LANES];
+	scs_float sqrt2 = SQRTF(2.0), tol = SD_JACOBI_TOL * SD_JACOBI_TOL;
+	scs_int i, j, p, q, l, sweep, converged;
+	/* A = the symmetric matrix of the SD cone variables (off-diagonal ones divided by sqrt(2)), V = I */
+	for (j = 0; j < n; ++j) {
+		for (i = j; i < n; ++i) {
+			scs_float * aij = &(A[(i + j * n) * SD_LANES]), *aji = &(A[(j + i * n) * SD_LANES]);
+			scs_int idx = j * n - (j * (j - 1)) / 2 + i - j;
+			for (l = 0; l < SD_LANES; ++l) {
+				scs_float v = l < lanes ? x[blocks[l].row + idx] : 0.0;
+				aij[l] = aji[l] = i == j ? v : v / sqrt2;
+				V[(i + j * n) * SD_LANES + l] = V[(j + i * n) * SD_LANES + l] = i == j ? 1.0 : 0.0;
+			}
+		}
+	}
+	for (sweep = 0; sweep < SD_JACOBI_MAX_SWEEPS; ++sweep) {
+		for (l = 0; l < SD_LANES; ++l) {
+			off[l] = diag[l] = 0.0;
+		}
+		for (j = 0; j < n; ++j) {
+			for (i = j; i < n; ++i) {
+				scs_float * aij = &(A[(i + j * n) * SD_LANES]);
+				for (l = 0; l < SD_LANES; ++l) {
+					off[l] += i == j ? 0.0 : aij[l] * aij[l];
+					diag[l] += i == j ? aij[l] * aij[l] : 0.0;
+				}
+			}
+		}
+		converged = 1;
+		for (l = 0; l < SD_LANES; ++l) {
+			converged &= off[l] <= tol * (diag[l] + 2 * off[l]);
+		}
+		if (converged) {
+			break;
+		}
+		for (p = 0; p < n - 1; ++p) {
+			for (q = p + 1; q < n; ++q) {
+				scs_float * app = &(A[(p + p * n) * SD_LANES]), *aqq = &(A[(q + q * n) * SD_LANES]);
+				scs_float * apq = &(A[(p + q * n) * SD_LANES]), *aqp = &(A[(q + p * n) * SD_LANES]);
+				/* the rotation zeroing apq, t = tan of its angle, the smaller root so it is at most pi / 4 */
+				for (l = 0; l < SD_LANES; ++l) {
+					scs_float d = aqq[l] - app[l], e = 2.0 * apq[l];
+					scs_float den = ABS(d) + SQRTF(d * d + e * e);
+					t[l] = den > 0 ? (d >= 0 ? e : -e) / den : 0.0;
+					cs[l] = 1.0 / SQRTF(1.0 + t[l] * t[l]);
+					sn[l] = t[l] * cs[l];
+					/* the new diagonal entries, overwritten by the rotation below */
+					newApp[l] = app[l] - t[l] * apq[l];
+					newAqq[l] = aqq[l] + t[l] * apq[l];
+				}
+				/* A = J' A J and V = V J, by columns p and q and then rows p and q */
+				for (i = 0; i < n; ++i) {
+					scs_float * aip = &(A[(i + p * n) * SD_LANES]), *aiq = &(A[(i + q * n) * SD_LANES]);
+					scs_float * vip = &(V[(i + p * n) * SD_LANES]), *viq = &(V[(i + q * n) * SD_LANES]);
+					for (l = 0; l < SD_LANES; ++l) {
+						scs_float a = aip[l], b = aiq[l], v = vip[l], w = viq[l];
+						aip[l] = cs[l] * a - sn[l] * b;
+						aiq[l] = sn[l] * a + cs[l] * b;
+						vip[l] = cs[l] * v - sn[l] * w;
+						viq[l] = sn[l] * v + cs[l] * w;
+					}
+				}
+				for (i = 0; i < n; ++i) {
+					scs_float * api = &(A[(p + i * n) * SD_LANES]), *aqi = &(A[(q + i * n) * SD_LANES]);
+					for (l = 0; l < SD_LANES; ++l) {
+						scs_float a = api[l], b = aqi[l];
+						api[l] = cs[l] * a - sn[l] * b;
+						aqi[l] = sn[l] * a + cs[l] * b;
+					}
+				}
+				for (l = 0; l < SD_LANES; ++l) {
+					app[l] = newApp[l];
+					aqq[l] = newAqq[l];
+					apq[l] = aqp[l] = 0.0;
+				}
+			}
+		}
+	}
+	/* the projection V max(diag(A), 0) V', back to SD cone variables */
+	for (i = 0; i < n; ++i) {
+		scs_float * aii = &(A[(i + i * n) * SD_LANES]);
+		for (l = 0; l < SD_LANES; ++l) {
+			aii[l] = MAX(aii[l], 0.0);
+		}
+	}
+	for (j = 0; j < n; ++j) {
+		for (i = j; i < n; ++i) {
+			scs_int idx = j * n - (j * (j - 1)) / 2 + i - j;
+			for (l = 0; l < SD_LANES; ++l) {
+				sum[l] = 0.0;
+			}
+			for (p = 0; p < n; ++p) {
+				const scs_float * vip = &(V[(i + p * n) * SD_LANES]), *vjp = &(V[(j + p * n) * SD_LANES]);
+				const scs_float * app = &(A[(p + p * n) * SD_LANES]);
+				for (l = 0; l < SD_LANES; ++l) {
+					sum[l] += vip[l] * app[l] * vjp[l];
+				}
+			}
+			for (l = 0; l < lanes; ++l) {
+				x[blocks[l].row + idx] = i == j ? sum[l] : sqrt2 * sum[l];
+			}
+		}
+	}
+}
+
 #ifdef LAPACK_LIB_FOUND
+/* Xs = the lower triangle of the n x n matrix of SD cone variables X, times sqrt(2) */
+static void expandSdBlock(scs_float * Xs, const scs_float * X, scs_int n) {
 	scs_int i;
-	blasint one = 1;
-	blasint m = 0;
 	blasint nb = (blasint) n;
 	blasint nbPlusOne = (blasint) (n + 1);
-	blasint coneSz = (blasint) (getSdConeSize(n));
-
 	scs_float sqrt2 = SQRTF(2.0);
-	scs_float sqrt2Inv = 1.0 / sqrt2;
-	scs_float * Xs = c->Xs;
-	scs_float * Z = c->Z;
-	scs_float * e = c->e;
-	scs_float * work = c->work;
-	blasint * iwork = c->iwork;
-	blasint lwork = c->lwork;
-	blasint liwork = c->liwork;
+	/* expand lower triangular matrix to full matrix */
+	for (i = 0; i < n; ++i) {
+		memcpy(&(Xs[i * (n + 1)]), &(X[i * n - ((i - 1) * i) / 2]), (n - i) * sizeof(scs_float));
+	}
+	/*
+	   rescale so projection works, and matrix norm preserved
+	   see http://www.seas.ucla.edu/~vandenbe/publications/mlbook.pdf pg 3
+	 */
+	/* scale diags by sqrt(2) */
+	BLAS(scal)(&nb, &sqrt2, Xs, &nbPlusOne); /* not nSquared */
+}
 
-	scs_float eigTol = CONE_TOL; /* iter < 0 ? CONE_TOL : MAX(CONE_TOL, 1 / POWF(iter + 1, CONE_RATE)); */
-	scs_float zero = 0.0;
+/* X = the lower triangle of the (sqrt(2) scaled) projection Xs, undoing the scaling of the diagonal */
+static scs_int extractSdProjection(scs_float * X, scs_float * Xs, scs_int n) {
+	scs_int i;
+	blasint nb = (blasint) n;
+	blasint nbPlusOne = (blasint) (n + 1);
+	scs_float sqrt2Inv = 1.0 / SQRTF(2.0);
+	/* scale diags by 1/sqrt(2) */
+	BLAS(scal)(&nb, &sqrt2Inv, Xs, &nbPlusOne); /* not nSquared */
+	/* extract just lower triangular matrix */
+	for (i = 0; i < n; ++i) {
+		memcpy(&(X[i * n - ((i - 1) * i) / 2]), &(Xs[i * (n + 1)]), (n - i) * sizeof(scs_float));
+	}
+#if EXTRAVERBOSE > 0
+	printArray(Xs, n * n, "Xs");
+	printArray(X, getSdConeSize(n), "X");
+#endif
+	return 0;
+}
+
+/*
+ * whether sign * X, for the SD cone variables X of an n x n block, is positive definite: if its Cholesky
+ * factorization in the n x n workspace Z succeeds. much cheaper than the eigendecomposition, and when it fails on an
+ * indefinite block it usually does so early on
+ */
+static scs_int sdIsDefinite(scs_float * Z, const scs_float * X, scs_int n, scs_int sign) {
+	scs_int j;
+	blasint nb = (blasint) n, info;
+	expandSdBlock(Z, X, n);
+	if (sign < 0) {
+		for (j = 0; j < n; ++j) {
+			scaleArray(&(Z[j * (n + 1)]), -1.0, n - j);
+		}
+	}
+	BLAS(potrf)("Lower", &nb, Z, &nb, &info);
+	return info == 0;
+}
+
+/* pseudo-random entries in [-0.5, 0.5) that depend only on seed and col, so the projections don't depend on the
+   thread or the order of the calls */
+static void sdWarmEigStartVector(scs_float * v, scs_int n, scs_int seed, scs_int col) {
+	scs_int i;
+	unsigned long r = 2463534242UL + 7919UL * (unsigned long) seed + 104729UL * (unsigned long) col;
+	for (i = 0; i < n; ++i) {
+		r = (r * 1103515245UL + 12345UL) & 0x7fffffffUL;
+		v[i] = (scs_float) (r >> 8) / (scs_float) (1UL << 23) - 0.5;
+	}
+}
+
+/* q -= Q Q' q for the k orthonormal columns of the n x k Q, twice so it holds up to rounding, coef needs k entries */
+static void sdProjectOut(scs_float * q, const scs_float * Q, scs_int n, scs_int k, scs_float * coef) {
+	blasint nb = (blasint) n, kb = (blasint) k, one = 1;
+	scs_float pOne = 1.0, mOne = -1.0, zero = 0.0;
+	scs_int pass;
+	if (k == 0) {
+		return;
+	}
+	for (pass = 0; pass < 2; ++pass) {
+		BLAS(gemv)("Transpose", &nb, &kb, &pOne, Q, &nb, q, &one, &zero, coef, &one);
+		BLAS(gemv)("NoTranspose", &nb, &kb, &mOne, Q, &nb, coef, &one, &pOne, q, &one);
+	}
+}
+
+/*
+ * orthonormalizes columns k, ..., k + kNew - 1 of the n-row Q against columns 0, ..., k - 1 (orthonormal already),
+ * as a block, then each other. nearly dependent columns are dropped and the others moved up, returns how many were
+ * kept. C needs k * kNew entries and coef 2 * kNew
+ */
+static scs_int sdOrthonormalize(scs_float * Q, scs_int n, scs_int k, scs_int kNew, scs_float * C, scs_float * coef) {
+	blasint nb = (blasint) n, kb = (blasint) k, kNewb = (blasint) kNew;
+	scs_float pOne = 1.0, mOne = -1.0, zero = 0.0, nrm, *nrm0 = &(coef[kNew]);
+	scs_float * B = &(Q[k * n]);
+	scs_int j, pass, kept = 0;
+	for (j = 0; j < kNew; ++j) {
+		nrm0[j] = calcNorm(&(B[j * n]), n);
+	}
+	for (pass = 0; pass < 2 && k > 0; ++pass) {
+		BLAS(gemm)("Transpose", "NoTranspose", &kb, &kNewb, &nb, &pOne, Q, &nb, B, &nb, &zero, C, &kb);
+		BLAS(gemm)("NoTranspose", "NoTranspose", &nb, &kNewb, &kb, &mOne, Q, &nb, C, &kb, &pOne, B, &nb);
+	}
+	for (j = 0; j < kNew; ++j) {
+		scs_float * q = &(B[kept * n]);
+		if (j != kept) {
+			memcpy(q, &(B[j * n]), n * sizeof(scs_float));
+		}
+		sdProjectOut(q, B, n, kept, coef);
+		nrm = calcNorm(q, n);
+		if (nrm > 1e-2 * SD_WARM_EIG_TOL * nrm0[j]) {
+			scaleArray(q, 1.0 / nrm, n);
+			kept++;
+		}
+	}
+	return kept;
+}
+
+/*
+ * the largest eigenvalue of sign * Xs (lower triangle) restricted to the orthogonal complement of the k orthonormal
+ * columns of V, estimated by SD_WARM_EIG_LANCZOS Lanczos steps with full reorthogonalization. the estimate is a lower
+ * bound, but it can only miss eigenvalues that are small next to the spread of the spectrum
+ */
+static scs_float sdComplementMaxEig(const scs_float * Xs, scs_float sign, scs_int n, scs_float nrm,
+		const scs_float * V, scs_int k, SdConeWork * sd, scs_int seed) {
+	blasint nb = (blasint) n, one = 1, ld = SD_WARM_EIG_LANCZOS, steps = 0, found, info;
+	scs_float zero = 0.0, eigTol = CONE_TOL, beta;
+	scs_float * L = sd->lanczos, *T = sd->H;
+	scs_int j;
+	memset(T, 0, SD_WARM_EIG_LANCZOS * SD_WARM_EIG_LANCZOS * sizeof(scs_float));
+	sdWarmEigStartVector(L, n, seed, SD_WARM_EIG_OVERSAMPLE);
+	sdProjectOut(L, V, n, k, sd->coef);
+	beta = calcNorm(L, n);
+	if (beta == 0) {
+		return 0.0;
+	}
+	scaleArray(L, 1.0 / beta, n);
+	for (j = 0; j < SD_WARM_EIG_LANCZOS; ++j) {
+		scs_float * q = &(L[j * n]), *w = &(L[(j + 1) * n]);
+		BLAS(symv)("Lower", &nb, &sign, Xs, &nb, q, &one, &zero, w, &one);
+		T[j * (ld + 1)] = innerProd(q, w, n);
+		/* against the previous Lanczos vectors this subtracts the three term recurrence, and the rest of the
+		   rounding errors */
+		sdProjectOut(w, V, n, k, sd->coef);
+		sdProjectOut(w, L, n, j + 1, sd->coef);
+		steps = j + 1;
+		beta = calcNorm(w, n);
+		if (beta <= 1e-2 * SD_WARM_EIG_TOL * nrm) {
+			break;
+		}
+		if (j + 1 < SD_WARM_EIG_LANCZOS) {
+			T[j * (ld + 1) + 1] = beta;
+		}
+		scaleArray(w, 1.0 / beta, n);
+	}
+	BLAS(syevr)("NoVectors", "All", "Lower", &steps, T, &ld, SCS_NULL, SCS_NULL, SCS_NULL, SCS_NULL, &eigTol,
+			&found, sd->He, SCS_NULL, &one, sd->isuppz, sd->work, &(sd->lwork), sd->iwork, &(sd->liwork), &info);
+	if (info != 0) {
+		return INFINITY;
+	}
+	return sd->He[steps - 1];
+}
+
+/*
+ * projects the SD block Xs (lower triangle, Frobenius norm nrm) onto the PSD cone, warm started from the approximate
+ * eigenvectors cache->V of Y = cache->sign * Xs at its last projection: Rayleigh-Ritz steps on the block Krylov space
+ * span(V, Y V, ...) until the Ritz pairs with positive Ritz values have residuals below SD_WARM_EIG_TOL * nrm, then a
+ * Lanczos check that the complement of the Ritz vectors has no positive eigenvalue of Y either. the projection is
+ * then the positive part of Y, or Xs plus it for sign -1 (when the negative eigenspace of Xs is the small one).
+ * O(n^2 k) for k Ritz vectors instead of the O(n^3) of the full decomposition. on success Xs holds the projection and
+ * cache the new Ritz vectors. returns -1, with Xs untouched but cache->V overwritten, if the positive eigenspace of Y
+ * may have outgrown the Ritz vectors or a check failed
+ */
+static scs_int projSdWarm(scs_float * Xs, scs_int n, scs_float nrm, SdBlockWork * cache, SdConeWork * sd,
+		scs_int seed) {
+	blasint nb = (blasint) n, kb, mb, found, info;
+	scs_int kMax = getSdWarmEigMaxRank(n), k = cache->k, kBlock, first, m, r = 0, i, j, d, step, converged = 0;
+	scs_float pOne = 1.0, zero = 0.0, eigTol = CONE_TOL, tol = SD_WARM_EIG_TOL * nrm, res;
+	scs_float sign = cache->sign, beta = sign > 0 ? 0.0 : 1.0;
+	scs_float * Q = sd->Z, *W = &(sd->Z[SD_WARM_EIG_DEPTH * kMax * n]), *V = cache->V, *XV = sd->XV;
+
+	/* Q holds an orthonormal basis of the subspace, W is Y times it, both fit in Z */
+	memcpy(Q, V, k * n * sizeof(scs_float));
+	kb = (blasint) k;
+	BLAS(symm)("Left", "Lower", &nb, &kb, &sign, Xs, &nb, Q, &nb, &zero, W, &nb);
+	for (step = 0; step < SD_WARM_EIG_MAX_STEPS && !converged; ++step) {
+		/* extend the subspace to the block Krylov space of the Ritz vectors */
+		first = 0;
+		m = kBlock = k;
+		for (d = 1; d < SD_WARM_EIG_DEPTH && kBlock > 0; ++d) {
+			memcpy(&(Q[m * n]), &(W[first * n]), kBlock * n * sizeof(scs_float));
+			first = m;
+			kBlock = sdOrthonormalize(Q, n, m, kBlock, sd->H, sd->coef);
+			kb = (blasint) kBlock;
+			BLAS(symm)("Left", "Lower", &nb, &kb, &sign, Xs, &nb, &(Q[m * n]), &nb, &zero, &(W[m * n]), &nb);
+			m += kBlock;
+		}
+		mb = (blasint) m;
+		BLAS(gemm)("Transpose", "NoTranspose", &mb, &mb, &nb, &pOne, Q, &nb, W, &nb, &zero, sd->H, &mb);
+		BLAS(syevr)("Vectors", "All", "Lower", &mb, sd->H, &mb, SCS_NULL, SCS_NULL, SCS_NULL, SCS_NULL, &eigTol,
+				&found, sd->He, sd->Hz, &mb, sd->isuppz, sd->work, &(sd->lwork), sd->iwork, &(sd->liwork), &info);
+		if (info != 0) {
+			return -1;
+		}
+		/* keep the Ritz pairs with positive Ritz values and a few more, the Ritz values are in ascending order */
+		r = 0;
+		while (r < m && sd->He[m - 1 - r] > 0) {
+			r++;
+		}
+		k = MIN(r + SD_WARM_EIG_OVERSAMPLE, m);
+		k = MIN(k, kMax);
+		if (r >= k) {
+			return -1;
+		}
+		kb = (blasint) k;
+		BLAS(gemm)("NoTranspose", "NoTranspose", &nb, &kb, &mb, &pOne, Q, &nb, &(sd->Hz[(m - k) * m]), &mb, &zero,
+				V, &nb);
+		BLAS(gemm)("NoTranspose", "NoTranspose", &nb, &kb, &mb, &pOne, W, &nb, &(sd->Hz[(m - k) * m]), &mb, &zero,
+				XV, &nb);
+		memcpy(sd->ritz, &(sd->He[m - k]), k * sizeof(scs_float));
+		converged = 1;
+		for (j = k - r; j < k; ++j) {
+			res = 0.0;
+			for (i = 0; i < n; ++i) {
+				scs_float d = XV[j * n + i] - sd->ritz[j] * V[j * n + i];
+				res += d * d;
+			}
+			if (res > tol * tol) {
+				converged = 0;
+			}
+		}
+		memcpy(Q, V, k * n * sizeof(scs_float));
+		memcpy(W, XV, k * n * sizeof(scs_float));
+	}
+	if (!converged || sdComplementMaxEig(Xs, sign, n, nrm, V, k, sd, seed) > tol) {
+		return -1;
+	}
+	cache->k = k;
+	/* adds the sum of ritz v v' over the positive Ritz pairs, as (V sqrt(ritz)) (V sqrt(ritz))' */
+	for (j = k - r; j < k; ++j) {
+		memcpy(&(XV[(j - k + r) * n]), &(V[j * n]), n * sizeof(scs_float));
+		scaleArray(&(XV[(j - k + r) * n]), SQRTF(sd->ritz[j]), n);
+	}
+	kb = (blasint) r;
+	BLAS(syrk)("Lower", "NoTranspose", &nb, &kb, &pOne, XV, &nb, &beta, Xs, &nb);
+	return 0;
+}
+
+/*
+ * keeps the m eigenvectors Z of a full decomposition with positive eigenvalues of sign * X, plus
+ * SD_WARM_EIG_OVERSAMPLE start vectors, as the warm start of the next projection of the block, unless there are too
+ * many. if they are most of the eigenvectors the next full decomposition computes the other side
+ */
+static void sdWarmEigSeed(SdBlockWork * cache, const scs_float * Z, scs_int n, scs_int m, scs_int sign,
+		SdConeWork * sd, scs_int seed) {
+	scs_int j, kMax = getSdWarmEigMaxRank(n);
+	cache->k = 0;
+	cache->sign = (2 * m > n) ? -sign : sign;
+	if (m + SD_WARM_EIG_OVERSAMPLE > kMax) {
+		return;
+	}
+	if (!cache->V) {
+		cache->V = scs_malloc(n * kMax * sizeof(scs_float));
+		if (!cache->V) {
+			return;
+		}
+	}
+	memcpy(cache->V, Z, m * n * sizeof(scs_float));
+	for (j = 0; j < SD_WARM_EIG_OVERSAMPLE; ++j) {
+		sdWarmEigStartVector(&(cache->V[(m + j) * n]), n, seed, j);
+	}
+	cache->k = m + sdOrthonormalize(cache->V, n, m, SD_WARM_EIG_OVERSAMPLE, sd->H, sd->coef);
+}
+#endif
+
+/* size of X is getSdConeSize(n), X is SD block number block, thread picks the eigenvector decomposition workspace */
+static scs_int projSemiDefiniteCone(scs_float * X, const scs_int n, ConeWork * c, scs_int block, scs_int thread,
+		const scs_int iter) {
+	/* project onto the positive semi-definite cone */
+	SdBlockRef ref;
+#ifdef LAPACK_LIB_FOUND
+	scs_int i;
+	blasint one = 1;
+	blasint m = 0;
+	blasint nb = (blasint) n;
+	blasint coneSz = (blasint) (getSdConeSize(n));
+
+	scs_float sqrt2 = SQRTF(2.0);
+	scs_float * Xs, *Z, *e, *work;
+	blasint * iwork, lwork, liwork;
+
+	scs_float eigTol = CONE_TOL; /* iter < 0 ? CONE_TOL : MAX(CONE_TOL, 1 / POWF(iter + 1, CONE_RATE)); */
 	blasint info;
-	scs_float vupper;
+	scs_float nrm, vlower, vupper;
+	SdBlockWork * b, *cache;
+	scs_int sign, def, t;
 #endif
 	if (n == 0) {
 		return 0;
@@ -457,27 +1519,76 @@ static scs_int projSemiDefiniteCone(scs_float * X, const scs_int n, ConeWork * c
 	if (n == 2) {
         return project2By2Sdc(X);
     }
-#ifdef LAPACK_LIB_FOUND
-    /* expand lower triangular matrix to full matrix */
-    for (i = 0; i < n; ++i) {
-        memcpy(&(Xs[i * (n + 1)]), &(X[i * n - ((i - 1) * i) / 2]), (n - i) * sizeof(scs_float));
+    if (n <= SD_SMALL_MAX_DIM) {
+        ref.n = n;
+        ref.row = 0;
+        ref.index = block;
+        projSdSmallLanes(X, &ref, 1, n);
+        return 0;
     }
+#ifdef LAPACK_LIB_FOUND
+    b = &(c->sdBlocks[block]);
+    /* warm starts only for iterates, iter < 0 asks for an exact projection */
+    cache = (c->sdWarmEig && iter >= 0 && n >= SD_WARM_EIG_MIN_SIZE) ? b : SCS_NULL;
+    Xs = c->sd[thread].Xs;
+    Z = c->sd[thread].Z;
+    e = c->sd[thread].e;
+    work = c->sd[thread].work;
+    iwork = c->sd[thread].iwork;
+    lwork = c->sd[thread].lwork;
+    liwork = c->sd[thread].liwork;
+    b->projections++;
+
     /*
-       rescale so projection works, and matrix norm preserved
-       see http://www.seas.ucla.edu/~vandenbe/publications/mlbook.pdf pg 3
+     * a PSD block is its own projection and an NSD one projects to zero, the one found last time is tried first.
+     * both pretests run on every projection, so whether X is returned as is depends on X only (not on earlier solves
+     * on the workspace, the same for scs_solve_batch as for scs_solve), at the cost of a Cholesky factorization that
+     * usually fails early on an indefinite block
      */
-    /* scale diags by sqrt(2) */
-    BLAS(scal)(&nb, &sqrt2, Xs, &nbPlusOne); /* not nSquared */
+    for (t = 0, def = b->definite < 0 ? -1 : 1; t < 2; ++t, def = -def) {
+        if (sdIsDefinite(Z, X, n, def)) {
+            b->definite = def;
+            if (def > 0) {
+                b->psdHits++;
+            } else {
+                b->nsdHits++;
+                memset(X, 0, coneSz * sizeof(scs_float));
+            }
+            return 0;
+        }
+    }
+    b->definite = 0;
+    sign = (cache && cache->sign < 0) ? -1 : 1;
+    expandSdBlock(Xs, X, n);
 
     /* max-eig upper bounded by frobenius norm */
-	vupper = 1.1 * sqrt2 * BLAS(nrm2)(&coneSz, X, &one); /* mult by factor to make sure is upper bound */
+	nrm = sqrt2 * BLAS(nrm2)(&coneSz, X, &one);
+	vupper = 1.1 * nrm; /* mult by factor to make sure is upper bound */
 	vupper = MAX(vupper, 0.01);
+	if (cache && cache->k > 0 && cache->skip == 0) {
+		if (projSdWarm(Xs, n, nrm, cache, &(c->sd[thread]), block) == 0) {
+			cache->backoff = 0;
+			cache->warmEigs++;
+			return extractSdProjection(X, Xs, n);
+		}
+		/* back off exponentially while the warm starts keep failing */
+		cache->backoff = MIN(2 * cache->backoff + 1, SD_WARM_EIG_MAX_BACKOFF);
+		cache->skip = cache->backoff;
+	} else if (cache && cache->skip > 0) {
+		cache->skip--;
+	}
 #if EXTRAVERBOSE > 0
 	printArray(Xs, n * n, "Xs");
 	printArray(X, getSdConeSize(n), "X");
 #endif
-	/* Solve eigenproblem, reuse workspaces */
-	BLAS(syevr)("Vectors", "VInterval", "Lower", &nb, Xs, &nb, &zero, &vupper,
+	/* Solve eigenproblem, reuse workspaces. warm-started blocks can ask for the negative eigenvalues instead */
+	if (sign > 0) {
+		vlower = 0.0;
+	} else {
+		vlower = -vupper;
+		vupper = 0.0;
+	}
+	BLAS(syevr)("Vectors", "VInterval", "Lower", &nb, Xs, &nb, &vlower, &vupper,
 			SCS_NULL, SCS_NULL, &eigTol, &m, e, Z, &nb, SCS_NULL, work, &lwork, iwork, &liwork, &info);
 #if EXTRAVERBOSE > 0
 	if (info != 0) {
@@ -493,31 +1604,98 @@ static scs_int projSemiDefiniteCone(scs_float * X, const scs_int n, ConeWork * c
 	printArray(Z, m * n, "Z");
 #endif
 	if (info < 0) return -1;
+	if (cache) {
+		sdWarmEigSeed(cache, Z, n, m, sign, &(c->sd[thread]), block);
+	}
 
-	memset(Xs, 0, n * n * sizeof(scs_float));
+	if (sign > 0) {
+		memset(Xs, 0, n * n * sizeof(scs_float));
+	} else {
+		/* X minus its negative part, syevr overwrote Xs */
+		expandSdBlock(Xs, X, n);
+	}
 	for (i = 0; i < m; ++i) {
-		scs_float a = e[i];
+		scs_float a = sign * e[i];
 		BLAS(syr)("Lower", &nb, &a, &(Z[i * n]), &one, Xs, &nb);
 	}
-	/* scale diags by 1/sqrt(2) */
-	BLAS(scal)(&nb, &sqrt2Inv, Xs, &nbPlusOne); /* not nSquared */
-	/* extract just lower triangular matrix */
-	for (i = 0; i < n; ++i) {
-		memcpy(&(X[i * n - ((i - 1) * i) / 2]), &(Xs[i * (n + 1)]), (n - i) * sizeof(scs_float));
+	return extractSdProjection(X, Xs, n);
+#else
+	scs_printf("FAILURE: solving SDP with > %lix%li matrices, but no blas/lapack libraries were linked!\n",
+			(long) SD_SMALL_MAX_DIM, (long) SD_SMALL_MAX_DIM);
+	scs_printf("SCS will return nonsense!\n");
+	scaleArray(X, NAN, n);
+	return -1;
+#endif
+}
+
+#ifdef LAPACK_LIB_FOUND
+/* Xs = the lower triangle of the n x n Hermitian matrix of the cone variables X, times sqrt(2) */
+static void expandCsBlock(scs_float * Xs, const scs_float * X, scs_int n) {
+	scs_int j, idx = 0;
+	scs_float sqrt2 = SQRTF(2.0);
+	for (j = 0; j < n; ++j) {
+		Xs[2 * (j * n + j)] = sqrt2 * X[idx++];
+		Xs[2 * (j * n + j) + 1] = 0.0;
+		memcpy(&(Xs[2 * (j * n + j + 1)]), &(X[idx]), 2 * (n - j - 1) * sizeof(scs_float));
+		idx += 2 * (n - j - 1);
 	}
+}
 
-#if EXTRAVERBOSE > 0
-	printArray(Xs, n * n, "Xs");
-	printArray(X, getSdConeSize(n), "X");
+/* X = the lower triangle of the (sqrt(2) scaled) projection Xs, undoing the scaling of the diagonal */
+static void extractCsProjection(scs_float * X, const scs_float * Xs, scs_int n) {
+	scs_int j, idx = 0;
+	scs_float sqrt2Inv = 1.0 / SQRTF(2.0);
+	for (j = 0; j < n; ++j) {
+		X[idx++] = sqrt2Inv * Xs[2 * (j * n + j)];
+		memcpy(&(X[idx]), &(Xs[2 * (j * n + j + 1)]), 2 * (n - j - 1) * sizeof(scs_float));
+		idx += 2 * (n - j - 1);
+	}
+}
 #endif
 
+/*
+ * projects onto the n x n Hermitian PSD cone, X has getCsConeSize(n) entries: the lower triangle column by column,
+ * each diagonal entry followed by the real and imaginary parts of the entries below it, those times sqrt(2) so the
+ * inner product is that of the matrices. thread picks the eigenvector decomposition workspace
+ */
+static scs_int projHermitianCone(scs_float * X, const scs_int n, ConeWork * c, scs_int thread) {
+#ifdef LAPACK_LIB_FOUND
+	scs_int i;
+	blasint one = 1, m = 0, nb = (blasint) n, coneSz = (blasint) getCsConeSize(n), info;
+	scs_float eigTol = CONE_TOL, vlower = 0.0, vupper;
+	CsConeWork * w;
+#endif
+	if (n == 0) {
+		return 0;
+	}
+	if (n == 1) {
+		if (X[0] < 0.0) {
+			X[0] = 0.0;
+		}
+		return 0;
+	}
+#ifdef LAPACK_LIB_FOUND
+	w = &(c->csWork[thread]);
+	expandCsBlock(w->Xs, X, n);
+	/* max-eig upper bounded by frobenius norm */
+	vupper = 1.1 * SQRTF(2.0) * BLAS(nrm2)(&coneSz, X, &one);
+	vupper = MAX(vupper, 0.01);
+	BLASC(heevr)("Vectors", "VInterval", "Lower", &nb, w->Xs, &nb, &vlower, &vupper, SCS_NULL, SCS_NULL, &eigTol, &m,
+			w->e, w->Z, &nb, SCS_NULL, w->work, &(w->lwork), w->rwork, &(w->lrwork), w->iwork, &(w->liwork), &info);
+	if (info < 0) return -1;
+	/* the positive part, heevr overwrote Xs */
+	memset(w->Xs, 0, 2 * n * n * sizeof(scs_float));
+	for (i = 0; i < m; ++i) {
+		BLASC(her)("Lower", &nb, &(w->e[i]), &(w->Z[2 * i * n]), &one, w->Xs, &nb);
+	}
+	extractCsProjection(X, w->Xs, n);
+	return 0;
 #else
-	scs_printf("FAILURE: solving SDP with > 2x2 matrices, but no blas/lapack libraries were linked!\n");
+	scs_printf("FAILURE: solving a Hermitian PSD cone larger than 1x1, but no blas/lapack libraries were linked!\n");
 	scs_printf("SCS will return nonsense!\n");
-	scaleArray(X, NAN, n);
+	scaleArray(X, NAN, getCsConeSize(n));
 	return -1;
 #endif
-	return 0;
 }
 
 scs_float powCalcX(scs_float r, scs_float xh, scs_float rh, scs_float a) {
@@ -529,39 +1707,42 @@ scs_float powCalcdxdr(scs_float x,scs_float xh,scs_float rh,scs_float r, scs_flo
     return a * (rh - 2*r) / (2 * x - xh);
 }
 
-scs_float powCalcF(scs_float x,scs_float y,scs_float r,scs_float a) {
-    return POWF(x, a) * POWF(y, (1 - a)) - r;
-}
-
-scs_float powCalcFp(scs_float x,scs_float y,scs_float dxdr,scs_float dydr,scs_float a) {
-    return POWF(x, a) * POWF(y, (1 - a)) * (a * dxdr / x + (1-a) * dydr / y) - 1;
+/* x^a y^(1-a) for x, y >= 0, with one exp and two logs rather than two pows */
+static scs_float powGeoMean(scs_float x, scs_float y, scs_float a) {
+    if (x <= 0 || y <= 0) {
+        return POWF(x, a) * POWF(y, (1 - a));
+    }
+    return exp(a * log(x) + (1 - a) * log(y));
 }
 
-void projPowerCone(scs_float * v, scs_float a) {
+/* project onto K_a, aa is powDualScale(a) */
+void projPowerCone(scs_float * v, scs_float a, scs_float aa) {
     scs_float xh = v[0], yh = v[1], rh = ABS(v[2]);
     scs_float x, y, r;
     scs_int i;
     /* v in K_a */
-    if (xh >=0 && yh >= 0 && CONE_THRESH + POWF(xh, a) * POWF(yh, (1-a)) >= rh) return;
+    if (xh >=0 && yh >= 0 && CONE_THRESH + powGeoMean(xh, yh, a) >= rh) return;
 
     /* -v in K_a^* */
-    if (xh <= 0 && yh <= 0 && CONE_THRESH + POWF(-xh, a) * POWF(-yh, 1-a) >= rh * POWF(a, a) * POWF(1-a, 1-a)) {
+    if (xh <= 0 && yh <= 0 && CONE_THRESH + powGeoMean(-xh, -yh, a) >= rh * aa) {
         v[0] = v[1] = v[2] = 0;
         return;
     }
 
     r = rh / 2;
     for (i = 0; i < POW_CONE_MAX_ITERS; ++i) {
-        scs_float f, fp, dxdr, dydr;
+        scs_float f, fp, dxdr, dydr, pw;
         x = powCalcX(r, xh, rh, a);
         y = powCalcX(r, yh, rh, 1 - a);
 
-        f = powCalcF(x, y, r, a);
+        /* f and its derivative share x^a y^(1-a) */
+        pw = powGeoMean(x, y, a);
+        f = pw - r;
         if (ABS(f) < CONE_TOL) break;
 
         dxdr = powCalcdxdr(x, xh, rh, r, a);
         dydr = powCalcdxdr(y, yh, rh, r, (1 - a));
-        fp = powCalcFp(x, y, dxdr, dydr, a);
+        fp = pw * (a * dxdr / x + (1 - a) * dydr / y) - 1;
 
         r = MAX(r - f / fp, 0);
         r = MIN(r, rh);
@@ -571,12 +1752,365 @@ void projPowerCone(scs_float * v, scs_float a) {
     v[2] = (v[2] < 0) ? -(r) : (r);
 }
 
+/* prod_i (sign x_i / (div ? a_i : 1))^a_i, -1 if some sign x_i < 0 */
+static scs_float genPowGeoMean(const scs_float * x, const scs_float * a, scs_int m, scs_float sign, scs_int div) {
+	scs_int i, zero = 0;
+	scs_float lsum = 0.0;
+	for (i = 0; i < m; ++i) {
+		if (sign * x[i] <= 0) {
+			if (sign * x[i] < 0) {
+				return -1.0;
+			}
+			zero = 1;
+		} else {
+			lsum += a[i] * log(div ? sign * x[i] / a[i] : sign * x[i]);
+		}
+	}
+	return zero ? 0.0 : exp(lsum);
+}
+
+/*
+ * projects onto the dual of the generalized power cone {(x, z) | prod_i x_i^a_i >= ||z||, x >= 0}, m entries of x
+ * and n of z, whose dual is {(u, w) | prod_i (u_i / a_i)^a_i >= ||w||, u >= 0}, via Moreau. unless v = -(x, z) or -v
+ * is in a cone its projection onto the cone keeps the direction of z, with ||z|| the root r of the decreasing
+ * prod_i x_i(r)^a_i - r for x_i(r) as in powCalcX (one Newton step is O(m) whatever n is). found by Newton steps that
+ * fall back to bisection when they leave the bracket
+ */
+static void projDualGenPowerCone(scs_float * x, const scs_float * a, scs_int m, scs_int n) {
+	scs_int i, iter;
+	scs_float lo = 0.0, hi, r, next, f, slope, pw, lsum, xi, rh = calcNorm(&(x[m]), n);
+	/* x in the dual cone: -x projects to 0 */
+	pw = genPowGeoMean(x, a, m, 1.0, 1);
+	if (pw >= 0 && pw + CONE_THRESH >= rh) {
+		return;
+	}
+	/* -x in the cone, it is its own projection */
+	pw = genPowGeoMean(x, a, m, -1.0, 0);
+	if (pw >= 0 && pw + CONE_THRESH >= rh) {
+		memset(x, 0, (m + n) * sizeof(scs_float));
+		return;
+	}
+	hi = rh;
+	r = rh / 2;
+	for (iter = 0; iter < GEN_POW_CONE_MAX_ITERS && rh > 0; ++iter) {
+		lsum = slope = 0.0;
+		for (i = 0; i < m; ++i) {
+			xi = powCalcX(r, -x[i], rh, a[i]);
+			lsum += a[i] * log(xi);
+			slope += a[i] * powCalcdxdr(xi, -x[i], rh, r, a[i]) / xi;
+		}
+		pw = exp(lsum);
+		f = pw - r;
+		if (ABS(f) < CONE_TOL) {
+			break;
+		}
+		if (f > 0) {
+			lo = r;
+		} else {
+			hi = r;
+		}
+		next = r - f / (pw * slope - 1);
+		if (!(next > lo && next < hi)) {
+			next = (lo + hi) / 2;
+		}
+		if (hi - lo < CONE_TOL) {
+			break;
+		}
+		r = next;
+	}
+	/* x plus the projection of -x */
+	for (i = 0; i < m; ++i) {
+		x[i] += rh > 0 ? powCalcX(r, -x[i], rh, a[i]) : MAX(-x[i], 0);
+	}
+	if (rh > 0) {
+		scaleArray(&(x[m]), 1 - r / rh, n);
+	}
+}
+
+/*
+ * half the derivative in t of the squared distance from v = (t0, s0) to the box cone at height t: (t - t0) plus, for
+ * each entry of s0 outside [t bl, t bu], the bound times its distance to it. the slope (1 plus the squared bounds that
+ * are active) is returned in slope. v = -x, for the projection onto the dual cone
+ */
+static scs_float boxDualGrad(const scs_float * x, const scs_float * bl, const scs_float * bu, scs_int n, scs_float t,
+		scs_float * slope) {
+	scs_int i;
+	scs_float s0, dl, du, g = t + x[0], sl = 1.0;
+	for (i = 0; i < n; ++i) {
+		s0 = -x[i + 1];
+		dl = t * bl[i] - s0;
+		du = s0 - t * bu[i];
+		dl = (bl[i] > -BOX_CONE_INF && dl > 0) ? dl : 0.0;
+		du = (bu[i] < BOX_CONE_INF && du > 0) ? du : 0.0;
+		g += bl[i] * dl - bu[i] * du;
+		sl += (dl > 0 ? bl[i] * bl[i] : 0.0) + (du > 0 ? bu[i] * bu[i] : 0.0);
+	}
+	*slope = sl;
+	return g;
+}
+
+/*
+ * projects x onto the dual of the box cone {(t, s) | t bl <= s <= t bu} of dimension n + 1, via Moreau
+ * \Pi_K^*(x) = x + \Pi_K(-x). for a fixed t the projection of -x clips s to [t bl, t bu], so t is the root in t >= 0 of
+ * the increasing, piecewise linear boxDualGrad (or 0 if it is positive there), found by Newton steps that fall back to
+ * bisection (or doubling while there is no upper bound) when they leave the bracket. t is a guess to start from, e.g.
+ * the one of the previous iterate, from which the Newton step usually lands on the root (none if t <= 0)
+ */
+static void projDualBoxCone(scs_float * x, const scs_float * bl, const scs_float * bu, scs_int n, scs_float t) {
+	scs_int i;
+	scs_float lb = 0.0, ub = -1.0, g, slope, next, s0, lo, hi;
+	t = t > 0 ? t : MAX(-x[0], 1.0);
+	for (i = 0; i < BOX_CONE_MAX_ITERS; ++i) {
+		g = boxDualGrad(x, bl, bu, n, t, &slope);
+		if (t == 0 && g >= 0) {
+			break;
+		}
+		if (g > 0) {
+			ub = t;
+		} else {
+			lb = t;
+		}
+		next = t - g / slope;
+		if (g == 0 || ABS(next - t) <= CONE_TOL * MAX(t, 1.0)) {
+			break;
+		}
+		if (next <= 0 && lb == 0) {
+			/* no t tried has g <= 0 yet and the step goes below 0: try t = 0, the projection's if g >= 0 there */
+			next = 0.0;
+		} else if (!(next > lb) || (ub >= 0 && !(next < ub))) {
+			next = ub >= 0 ? (lb + ub) / 2 : 2 * t;
+		}
+		t = next;
+	}
+	x[0] += t;
+	for (i = 0; i < n; ++i) {
+		s0 = -x[i + 1];
+		lo = bl[i] > -BOX_CONE_INF ? t * bl[i] : s0;
+		hi = bu[i] < BOX_CONE_INF ? t * bu[i] : s0;
+		x[i + 1] += MIN(MAX(s0, lo), hi);
+	}
+}
+
+/* project onto the second-order cone of dimension q */
+static void projSocCone(scs_float * x, scs_int q) {
+	scs_float v1, s, alpha;
+	if (q == 0) {
+		return;
+	}
+	if (q == 1) {
+		if (x[0] < 0.0)
+			x[0] = 0.0;
+		return;
+	}
+	v1 = x[0];
+	s = calcNorm(&(x[1]), q - 1);
+	alpha = (s + v1) / 2.0;
+
+	if (s <= v1) { /* do nothing */
+	} else if (s <= -v1) {
+		memset(&(x[0]), 0, q * sizeof(scs_float));
+	} else {
+		x[0] = alpha;
+		scaleArray(&(x[1]), alpha / s, q - 1);
+	}
+}
+
+/* project onto the dual of power cone p, p <= 0 specifies the dual cone itself, aa is powDualScale(|p|) */
+static void projDualPowerCone(scs_float * x, scs_float p, scs_float aa) {
+	scs_float v[3];
+	if (p <= 0) {
+		/* dual power cone */
+		projPowerCone(x, -p, aa);
+	} else {
+		/* primal power cone, using Moreau */
+		v[0] = -x[0];
+		v[1] = -x[1];
+		v[2] = -x[2];
+
+		projPowerCone(v, p, aa);
+
+		x[0] += v[0];
+		x[1] += v[1];
+		x[2] += v[2];
+	}
+}
+
+/*
+ * projects the SOC_LANES cones of dimension q >= 2 starting at rows start[0], ..., start[SOC_LANES - 1] of x, the
+ * same arithmetic as projSocCone but without branches or calls, so the compiler can interleave (and vectorize) the
+ * lanes
+ */
+static void projSocLanes(scs_float * x, const SocBlock * blocks, scs_int q) {
+	scs_int l, j;
+	scs_float nmsq[SOC_LANES], head[SOC_LANES], scale[SOC_LANES];
+	scs_int zero[SOC_LANES];
+	for (l = 0; l < SOC_LANES; ++l) {
+		nmsq[l] = 0.0;
+	}
+	for (j = 1; j < q; ++j) {
+		for (l = 0; l < SOC_LANES; ++l) {
+			scs_float v = x[blocks[l].row + j];
+			nmsq[l] += v * v;
+		}
+	}
+	for (l = 0; l < SOC_LANES; ++l) {
+		scs_float v1 = x[blocks[l].row];
+		scs_float s = SQRTF(nmsq[l]);
+		scs_float alpha = (s + v1) / 2.0;
+		scs_int inside = s <= v1;
+		zero[l] = !inside && s <= -v1;
+		/* s > 0 whenever neither case applies */
+		head[l] = inside ? v1 : alpha;
+		scale[l] = inside ? 1.0 : alpha / (s > 0 ? s : 1.0);
+	}
+	for (l = 0; l < SOC_LANES; ++l) {
+		scs_float * v = &(x[blocks[l].row]);
+		v[0] = zero[l] ? 0.0 : head[l];
+		for (j = 1; j < q; ++j) {
+			v[j] = zero[l] ? 0.0 : v[j] * scale[l];
+		}
+	}
+}
+
+/* projects the SOC blocks of a job, runs of SOC_LANES blocks of equal dimension at a time */
+static void projSocJob(scs_float * x, const ConeWork * c, const ConeJob * job) {
+	scs_int i = job->first, q;
+	const SocBlock * blocks = c->socBlocks;
+	while (i < job->last) {
+		q = blocks[i].q;
+		if (q >= 2 && q <= SOC_LANES_MAX_DIM && i + SOC_LANES <= job->last && blocks[i + SOC_LANES - 1].q == q) {
+			projSocLanes(x, &(blocks[i]), q);
+			i += SOC_LANES;
+		} else {
+			projSocCone(&(x[blocks[i].row]), q);
+			i++;
+		}
+	}
+}
+
+/* projects the SD blocks of a job, runs of up to SD_LANES small blocks of equal size at a time, -1 on failure */
+static scs_int projSdJob(scs_float * x, ConeWork * c, const ConeJob * job, scs_int thread, scs_int iter) {
+	scs_int i = job->first, j, n;
+	const SdBlockRef * blocks = c->sdOrder;
+	while (i < job->last) {
+		n = blocks[i].n;
+		if (n > 2 && n <= SD_SMALL_MAX_DIM) {
+			j = i + 1;
+			while (j < job->last && j < i + SD_LANES && blocks[j].n == n) {
+				j++;
+			}
+			projSdSmallLanes(x, &(blocks[i]), j - i, n);
+			i = j;
+		} else {
+			if (projSemiDefiniteCone(&(x[blocks[i].row]), n, c, blocks[i].index, thread, iter) < 0) {
+				return -1;
+			}
+			i++;
+		}
+	}
+	return 0;
+}
+
+static scs_int getThreadNum(void) {
+#ifdef OPENMP
+	return omp_get_thread_num();
+#else
+	return 0;
+#endif
+}
+
+/* projects blocks first, ..., last - 1 of the cone type, starting at row start of x,
+   returns the row after the last block or -1 on failure */
+static scs_int projConeBlocks(scs_float * x, const Cone * k, scs_int type, scs_int first, scs_int last,
+		scs_int start, ConeWork * c, scs_int thread, scs_int iter) {
+	/* without c only called for all the blocks, first = 0 */
+	scs_int i, count = start, aStart = (c && c->gpaStart) ? c->gpaStart[first] : 0;
+	for (i = first; i < last; ++i) {
+		switch (type) {
+		case CONE_JOB_SOC:
+			projSocCone(&(x[count]), k->q[i]);
+			break;
+		case CONE_JOB_SD:
+#if EXTRAVERBOSE > 0
+			scs_printf("SD proj size %li\n", (long) k->s[i]);
+#endif
+			if (projSemiDefiniteCone(&(x[count]), k->s[i], c, i, thread, iter) < 0) return -1;
+			break;
+		case CONE_JOB_CS:
+			if (projHermitianCone(&(x[count]), k->cs[i], c, thread) < 0) return -1;
+			break;
+		case CONE_JOB_GPOW:
+			projDualGenPowerCone(&(x[count]), &(k->gpa[aStart]), k->gpm[i], k->gpn[i]);
+			aStart += k->gpm[i];
+			break;
+		default:
+			projDualPowerCone(&(x[count]), k->p[i], c ? c->powScale[i] : powDualScale(ABS(k->p[i])));
+		}
+		count += getConeBlockRows(k, type, i);
+	}
+	return count;
+}
+
+/* charges the time since the end of the previous cone family's projection to total */
+static void chargeConeTime(scs_float * total, timer * coneTimer, scs_float * elapsed) {
+	scs_float t = tocq(coneTimer);
+	*total += t - *elapsed;
+	*elapsed = t;
+}
+
+/* projects the SOC, SD, Hermitian PSD and (generalized) power cone jobs, spread over the threads largest first, the
+   blocks are disjoint so the result does not depend on the number of threads */
+static scs_int projConeJobs(scs_float * x, const Cone * k, ConeWork * c, scs_int iter, timer * coneTimer,
+		scs_float * elapsed) {
+	scs_int j, failures = 0;
+	scs_float socTime = 0.0, sdTime = 0.0, powTime = 0.0, wall, t;
+#ifdef OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(c->numThreads) private(t) \
+	reduction(+:failures,socTime,sdTime,powTime)
+#endif
+	for (j = 0; j < c->numJobs; ++j) {
+		const ConeJob * job = &(c->jobs[j]);
+		timer jobTimer;
+		tic(&jobTimer);
+		if (job->type == CONE_JOB_SOC) {
+			projSocJob(x, c, job);
+		} else if (job->type == CONE_JOB_SD) {
+			if (projSdJob(x, c, job, getThreadNum(), iter) < 0) {
+				failures++;
+			}
+		} else if (projConeBlocks(x, k, job->type, job->first, job->last, job->start, c, getThreadNum(), iter) < 0) {
+			failures++;
+		}
+		t = tocq(&jobTimer);
+		if (job->type == CONE_JOB_SOC) {
+			socTime += t;
+		} else if (job->type == CONE_JOB_SD || job->type == CONE_JOB_CS) {
+			sdTime += t;
+		} else {
+			powTime += t;
+		}
+	}
+	/* the threads overlap, so the wall time of the stage is split in proportion to each family's thread time */
+	wall = tocq(coneTimer) - *elapsed;
+	*elapsed += wall;
+	t = socTime + sdTime + powTime;
+	if (t > 0) {
+		c->socTime += wall * socTime / t;
+		c->sdTime += wall * sdTime / t;
+		c->powTime += wall * powTime / t;
+	}
+	return failures > 0 ? -1 : 0;
+}
+
 /* outward facing cone projection routine, iter is outer algorithm iteration, if iter < 0 then iter is ignored
     warm_start contains guess of projection (can be set to SCS_NULL) */
 scs_int projDualCone(scs_float * x, const Cone * k, ConeWork * c, const scs_float * warm_start, scs_int iter)  {
     DEBUG_FUNC
     scs_int i;
 	scs_int count = (k->f ? k->f : 0);
+	scs_float elapsed = 0.0;
+	ConeWork * tmp;
+	timer coneTimer;
 #if EXTRAVERBOSE > 0
 	timer projTimer;
 	tic(&projTimer);
@@ -591,60 +2125,48 @@ scs_int projDualCone(scs_float * x, const Cone * k, ConeWork * c, const scs_floa
 			/* x[i] = (x[i] < 0.0) ? 0.0 : x[i]; */
 		}
 		count += k->l;
+		if (c) {
+			chargeConeTime(&(c->lpTime), &coneTimer, &elapsed);
+		}
 #if EXTRAVERBOSE > 0
 		scs_printf("pos orthant proj time: %1.2es\n", tocq(&projTimer) / 1e3);
 		tic(&projTimer);
 #endif
 	}
 
-	if (k->qsize && k->q) {
-		/* project onto SOC */
-		for (i = 0; i < k->qsize; ++i) {
-			if (k->q[i] == 0) {
-				continue;
-			}
-			if (k->q[i] == 1) {
-				if (x[count] < 0.0)
-					x[count] = 0.0;
-			} else {
-				scs_float v1 = x[count];
-				scs_float s = calcNorm(&(x[count + 1]), k->q[i] - 1);
-				scs_float alpha = (s + v1) / 2.0;
-
-				if (s <= v1) { /* do nothing */
-				} else if (s <= -v1) {
-					memset(&(x[count]), 0, k->q[i] * sizeof(scs_float));
-				} else {
-					x[count] = alpha;
-					scaleArray(&(x[count + 1]), alpha / s, k->q[i] - 1);
-				}
-			}
-			count += k->q[i];
+	if (c) {
+		/* project onto SOC, PSD, Hermitian PSD and (generalized) power cones, the latter after the exponential cones */
+		if (projConeJobs(x, k, c, iter, &coneTimer, &elapsed) < 0) {
+			return -1;
 		}
+		count = c->expStart;
 #if EXTRAVERBOSE > 0
-		scs_printf("SOC proj time: %1.2es\n", tocq(&projTimer) / 1e3);
+		scs_printf("SOC, SD and power cone proj time (%li jobs): %1.2es\n", (long) c->numJobs, tocq(&projTimer) / 1e3);
 		tic(&projTimer);
 #endif
+	} else {
+		if (k->qsize && k->q) {
+			count = projConeBlocks(x, k, CONE_JOB_SOC, 0, k->qsize, count, c, 0, iter);
+		}
+		if ((k->ssize && k->s) || (k->cssize && k->cs)) {
+			/* the SD and Hermitian PSD blocks need the eigendecomposition workspaces, set up for this call */
+			tmp = initCone(k);
+			if (!tmp) {
+				return -1;
+			}
+			if (k->ssize && k->s) {
+				count = projConeBlocks(x, k, CONE_JOB_SD, 0, k->ssize, count, tmp, 0, iter);
+			}
+			if (count >= 0 && k->cssize && k->cs) {
+				count = projConeBlocks(x, k, CONE_JOB_CS, 0, k->cssize, count, tmp, 0, iter);
+			}
+			finishCone(tmp);
+			if (count < 0) {
+				return -1;
+			}
+		}
 	}
 
-    if (k->ssize && k->s) {
-        /* project onto PSD cone */
-        for (i = 0; i < k->ssize; ++i) {
-#if EXTRAVERBOSE > 0
-            scs_printf("SD proj size %li\n", (long) k->s[i] );
-#endif
-            if (k->s[i] == 0) {
-                continue;
-            }
-            if (projSemiDefiniteCone(&(x[count]), k->s[i], c, iter) < 0) return -1;
-            count += getSdConeSize(k->s[i]);
-        }
-#if EXTRAVERBOSE > 0
-        scs_printf("SD proj time: %1.2es\n", tocq(&projTimer) / 1e3);
-        tic(&projTimer);
-#endif
-    }
-
 	if (k->ep) {
 		scs_float r, s, t;
 		scs_int idx;
@@ -664,13 +2186,17 @@ scs_int projDualCone(scs_float * x, const Cone * k, ConeWork * c, const scs_floa
 			s = x[idx + 1];
 			t = x[idx + 2];
 
-			projExpCone(&(x[idx]), iter);
+			/* the dual variable is minus the first entry of the polar part, which is what was returned */
+			projExpCone(&(x[idx]), warm_start ? -warm_start[idx] : 0, iter);
 
 			x[idx] -= r;
 			x[idx + 1] -= s;
 			x[idx + 2] -= t;
 		}
 		count += 3 * k->ep;
+		if (c) {
+			chargeConeTime(&(c->expTime), &coneTimer, &elapsed);
+		}
 #if EXTRAVERBOSE > 0
 		scs_printf("EP proj time: %1.2es\n", tocq(&projTimer) / 1e3);
 		tic(&projTimer);
@@ -679,14 +2205,20 @@ scs_int projDualCone(scs_float * x, const Cone * k, ConeWork * c, const scs_floa
 
 
 	if (k->ed) {
+		scs_int idx;
 		/* exponential cone: */
 #ifdef OPENMP
-#pragma omp parallel for
+#pragma omp parallel for private(idx)
 #endif
 		for (i = 0; i < k->ed; ++i) {
-			projExpCone(&(x[count + 3 * i]), iter);
+			idx = count + 3 * i;
+			/* the dual variable is the first entry of the polar part, v - the projection that was returned */
+			projExpCone(&(x[idx]), warm_start ? x[idx] - warm_start[idx] : 0, iter);
 		}
 		count += 3 * k->ed;
+		if (c) {
+			chargeConeTime(&(c->expTime), &coneTimer, &elapsed);
+		}
 #if EXTRAVERBOSE > 0
 		scs_printf("ED proj time: %1.2es\n", tocq(&projTimer) / 1e3);
 		tic(&projTimer);
@@ -694,39 +2226,43 @@ scs_int projDualCone(scs_float * x, const Cone * k, ConeWork * c, const scs_floa
 	}
 
 	if (k->psize && k->p) {
-		scs_float v[3];
-        scs_int idx;
-/* don't use openmp for power cone
-ifdef OPENMP
-pragma omp parallel for private(v, idx)
-endif
-*/
-        for (i = 0; i < k->psize; ++i) {
-            idx = count + 3 * i;
-            if (k->p[i] <= 0) {
-                /* dual power cone */
-                projPowerCone(&(x[idx]), -k->p[i]);
-            } else {
-                /* primal power cone, using Moreau */
-                v[0] = -x[idx];
-                v[1] = -x[idx + 1];
-                v[2] = -x[idx + 2];
+		if (c) {
+			/* projected with the jobs */
+			count += 3 * k->psize;
+		} else {
+			count = projConeBlocks(x, k, CONE_JOB_POW, 0, k->psize, count, c, 0, iter);
+		}
+	}
 
-                projPowerCone(v, k->p[i]);
+	if (k->gpsize && k->gpm && k->gpn) {
+		if (c) {
+			/* projected with the jobs */
+			for (i = 0; i < k->gpsize; ++i) {
+				count += k->gpm[i] + k->gpn[i];
+			}
+		} else {
+			count = projConeBlocks(x, k, CONE_JOB_GPOW, 0, k->gpsize, count, c, 0, iter);
+		}
+	}
 
-                x[idx] += v[0];
-                x[idx + 1] += v[1];
-                x[idx + 2] += v[2];
-            }
-        }
-        count += 3 * k->psize;
+	if (k->bsize > 0) {
+		if (c) {
+			/* the t of the previous iterate, estimated as the first entry of its projection minus that of this input */
+			projDualBoxCone(&(x[count]), c->boxBl ? c->boxBl : k->bl, c->boxBu ? c->boxBu : k->bu, k->bsize - 1,
+					warm_start ? warm_start[count] - x[count] : 0.0);
+			chargeConeTime(&(c->boxTime), &coneTimer, &elapsed);
+		} else {
+			projDualBoxCone(&(x[count]), k->bl, k->bu, k->bsize - 1, 0.0);
+		}
+		count += k->bsize;
 #if EXTRAVERBOSE > 0
-        scs_printf("Power cone proj time: %1.2es\n", tocq(&projTimer) / 1e3);
-        tic(&projTimer);
+		scs_printf("box cone proj time: %1.2es\n", tocq(&projTimer) / 1e3);
+		tic(&projTimer);
 #endif
-    }
+	}
     /* project onto OTHER cones */
-    totalConeTime += tocq(&coneTimer);
+    if (c) {
+        c->totalConeTime += tocq(&coneTimer);
+    }
     return 0;
 }
-
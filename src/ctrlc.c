@@ -5,6 +5,9 @@
  * Under Unix systems, we use sigaction.
  * For Mex files, we use utSetInterruptEnabled/utIsInterruptPending.
  *
+ * Signal handlers are process-wide, so with several concurrent solves the
+ * handler is installed by the first listener to start and restored by the last
+ * one to end; an interrupt stops every running solve.
  */
 
 #include "ctrlc.h"
@@ -28,7 +31,8 @@ int isInterrupted(void) {
 
 #elif defined _WIN32 || defined _WIN64
 
-static int int_detected;
+static volatile LONG int_detected;
+static volatile LONG listeners;
 BOOL WINAPI handle_ctrlc(DWORD dwCtrlType) {
 	if (dwCtrlType != CTRL_C_EVENT) return FALSE;
 	int_detected = 1;
@@ -36,12 +40,15 @@ BOOL WINAPI handle_ctrlc(DWORD dwCtrlType) {
 }
 
 void startInterruptListener(void) {
-	int_detected = 0;
+	if (InterlockedIncrement(&listeners) == 1) {
+		int_detected = 0;
+	}
 	SetConsoleCtrlHandler(handle_ctrlc, TRUE);
 }
 
 void endInterruptListener(void) {
 	SetConsoleCtrlHandler(handle_ctrlc, FALSE);
+	InterlockedDecrement(&listeners);
 }
 
 int isInterrupted(void) {
@@ -51,24 +58,35 @@ int isInterrupted(void) {
 #else /* Unix */
 
 #include <signal.h>
-static int int_detected;
-struct sigaction oact;
+#include <pthread.h>
+static volatile sig_atomic_t int_detected;
+static struct sigaction oact;
+static int listeners; /* number of active listeners, protected by listenersLock */
+static pthread_mutex_t listenersLock = PTHREAD_MUTEX_INITIALIZER;
 void handle_ctrlc(int dummy) {
 	int_detected = dummy?dummy:-1;
 }
 
 void startInterruptListener(void) {
 	struct sigaction act;
-	int_detected = 0;
-	act.sa_flags = 0;
-	sigemptyset(&act.sa_mask);
-	act.sa_handler = handle_ctrlc;
-	sigaction(SIGINT, &act, &oact);
+	pthread_mutex_lock(&listenersLock);
+	if (listeners++ == 0) {
+		int_detected = 0;
+		act.sa_flags = 0;
+		sigemptyset(&act.sa_mask);
+		act.sa_handler = handle_ctrlc;
+		sigaction(SIGINT, &act, &oact);
+	}
+	pthread_mutex_unlock(&listenersLock);
 }
 
 void endInterruptListener(void) {
 	struct sigaction act;
-	sigaction(SIGINT, &oact, &act);
+	pthread_mutex_lock(&listenersLock);
+	if (--listeners == 0) {
+		sigaction(SIGINT, &oact, &act);
+	}
+	pthread_mutex_unlock(&listenersLock);
 }
 
 int isInterrupted(void) {
@@ -13,15 +13,37 @@
 
 /* tolerance at which we declare problem indeterminate */
 #define INDETERMINATE_TOL 1e-9
+/* adaptive scale: minimum number of iterations between scale updates */
+#define ADAPT_SCALE_MIN_ITERS 100
+/* adaptive scale: only update if resPri / resDual is outside [1 / tol, tol] */
+#define ADAPT_SCALE_TOL 10
+/* adaptive scale: bounds on the scale */
+#define ADAPT_SCALE_MIN (1e-4)
+#define ADAPT_SCALE_MAX (1e4)
+/* mixed precision: leave the single precision phase once terminationDist is below this (or eps if larger) */
+#define MIXED_PRECISION_EPS (1e-7)
+/* mixed precision: or once terminationDist has not improved for this many convergence checks */
+#define MIXED_PRECISION_STALL_CHECKS 5
 
+#if EXTRAVERBOSE > 1
+/* only used by the DEBUG_FUNC / RETURN tracing macros, not thread-safe */
 timer globalTimer;
+#endif
 
 /* printing header */
 static const char* HEADER[] = { " Iter ", " pri res ", " dua res ", " rel gap ", " pri obj ", " dua obj ", " kap/tau ",
 		" time (s)", };
 static const scs_int HSPACE = 9;
 static const scs_int HEADER_LEN = 8;
-static scs_int _lineLen_;
+
+/* width of the printed table, sum of header lengths plus separators */
+static scs_int getLineLen(void) {
+	scs_int i, lineLen = -1;
+	for (i = 0; i < HEADER_LEN; ++i) {
+		lineLen += (scs_int) strlen(HEADER[i]) + 1;
+	}
+	return lineLen;
+}
 
 static scs_int scs_isnan(scs_float x) {
     DEBUG_FUNC
@@ -51,32 +73,35 @@ static void freeWork(Work * w) {
         scs_free(w->pr);
     if (w->dr)
         scs_free(w->dr);
+    if (w->u_best)
+        scs_free(w->u_best);
+    if (w->v_best)
+        scs_free(w->v_best);
     if (w->scal) {
         if (w->scal->D)
             scs_free(w->scal->D);
         if (w->scal->E)
             scs_free(w->scal->E);
+        if (w->scal->boundaries)
+            scs_free(w->scal->boundaries);
         scs_free(w->scal);
     }
+    freeAccel(w->accel);
     scs_free(w);
     RETURN;
 }
 
 static void printInitHeader(const Data * d, const Cone * k) {
     DEBUG_FUNC
-    scs_int i;
+    scs_int i, lineLen = getLineLen();
 	Settings * stgs = d->stgs;
 	char * coneStr = getConeHeader(k);
 	char * linSysMethod = getLinSysMethod(d->A, d->stgs);
-	_lineLen_ = -1;
-	for (i = 0; i < HEADER_LEN; ++i) {
-		_lineLen_ += (scs_int) strlen(HEADER[i]) + 1;
-	}
-	for (i = 0; i < _lineLen_; ++i) {
+	for (i = 0; i < lineLen; ++i) {
 		scs_printf("-");
 	}
 	scs_printf("\n\tSCS v%s - Splitting Conic Solver\n\t(c) Brendan O'Donoghue, Stanford University, 2012-2015\n", scs_version());
-	for (i = 0; i < _lineLen_; ++i) {
+	for (i = 0; i < lineLen; ++i) {
 		scs_printf("-");
 	}
 	scs_printf("\n");
@@ -91,6 +116,21 @@ static void printInitHeader(const Data * d, const Cone * k) {
 		scs_printf("eps = %.2e, alpha = %.2f, max_iters = %i, normalize = %i\n", stgs->eps, stgs->alpha,
 				(int) stgs->max_iters, (int) stgs->normalize);
 	}
+	if (stgs->normalize && stgs->adaptive_scale > 0) {
+		scs_printf("adaptive_scale = %i\n", (int) stgs->adaptive_scale);
+	}
+#ifndef FLOAT
+	if (stgs->mixed_precision) {
+		scs_printf("mixed_precision = %i\n", (int) stgs->mixed_precision);
+	}
+#endif
+	if (stgs->sdp_warm_eig) {
+		scs_printf("sdp_warm_eig = %i\n", (int) stgs->sdp_warm_eig);
+	}
+	if (stgs->acceleration_lookback > 0) {
+		scs_printf("acceleration_lookback = %i, acceleration_type = %i\n", (int) stgs->acceleration_lookback,
+				(int) stgs->acceleration_type);
+	}
 	scs_printf("Variables n = %i, constraints m = %i\n", (int) d->n, (int) d->m);
 	scs_printf("%s", coneStr);
 	scs_free(coneStr);
@@ -137,7 +177,10 @@ static scs_int failure(Work * w, scs_int m, scs_int n, Sol * sol, Info * info, s
 	scs_int status = stint;
 	populateOnFailure(m, n, sol, info, status, ststr);
 	scs_printf("Failure:%s\n", msg);
-	endInterruptListener();
+	if (w) {
+		/* failed inside scs_solve, end the listener it started */
+		endInterruptListener();
+	}
 	RETURN status;
 }
 
@@ -174,7 +217,7 @@ static scs_float calcPrimalResid(Work * w, const scs_float * x, const scs_float
 	accumByA(w->A, w->p, x, pr);
 	addScaledArray(pr, s, w->m, 1.0); /* pr = Ax + s */
 	for (i = 0; i < w->m; ++i) {
-		scale = w->stgs->normalize ? w->scal->D[i] / (w->sc_b * w->stgs->scale) : 1;
+		scale = w->stgs->normalize ? w->scal->D[i] / (w->sc_b * w->scale) : 1;
 		scale = scale * scale;
 		*nmAxs += (pr[i] * pr[i]) * scale;
 		pres += (pr[i] - w->b[i] * tau) * (pr[i] - w->b[i] * tau) * scale;
@@ -191,7 +234,7 @@ static scs_float calcDualResid(Work * w, const scs_float * y, const scs_float ta
 	memset(dr, 0, w->n * sizeof(scs_float));
 	accumByAtrans(w->A, w->p, y, dr); /* dr = A'y */
 	for (i = 0; i < w->n; ++i) {
-		scale = w->stgs->normalize ? w->scal->E[i] / (w->sc_c * w->stgs->scale) : 1;
+		scale = w->stgs->normalize ? w->scal->E[i] / (w->sc_c * w->scale) : 1;
 		scale = scale * scale;
 		*nmATy += (dr[i] * dr[i]) * scale;
 		dres += (dr[i] + w->c[i] * tau) * (dr[i] + w->c[i] * tau) * scale;
@@ -206,21 +249,23 @@ static void calcResiduals(Work * w, struct residuals * r, scs_int iter) {
 	scs_float * x = w->u, *y = &(w->u[w->n]), *s = &(w->v[w->n]);
 	scs_float nmpr_tau, nmdr_tau, nmAxs_tau, nmATy_tau, cTx, bTy;
 	scs_int n = w->n, m = w->m;
+	timer residTimer;
 
 	/* checks if the residuals are unchanged by checking iteration */
 	if (r->lastIter == iter) {
 		RETURN;
 	}
 	r->lastIter = iter;
+	tic(&residTimer);
 
 	r->tau = ABS(w->u[n + m]);
-	r->kap = ABS(w->v[n + m]) / (w->stgs->normalize ? (w->stgs->scale * w->sc_c * w->sc_b) : 1);
+	r->kap = ABS(w->v[n + m]) / (w->stgs->normalize ? (w->scale * w->sc_c * w->sc_b) : 1);
 
 	nmpr_tau = calcPrimalResid(w, x, s, r->tau, &nmAxs_tau);
 	nmdr_tau = calcDualResid(w, y, r->tau, &nmATy_tau);
 
-	r->bTy_by_tau = innerProd(y, w->b, m) / (w->stgs->normalize ? (w->stgs->scale * w->sc_c * w->sc_b) : 1);
-	r->cTx_by_tau = innerProd(x, w->c, n) / (w->stgs->normalize ? (w->stgs->scale * w->sc_c * w->sc_b) : 1);
+	r->bTy_by_tau = innerProd(y, w->b, m) / (w->stgs->normalize ? (w->scale * w->sc_c * w->sc_b) : 1);
+	r->cTx_by_tau = innerProd(x, w->c, n) / (w->stgs->normalize ? (w->scale * w->sc_c * w->sc_b) : 1);
 
 	r->resInfeas = r->bTy_by_tau < 0 ? w->nm_b * nmATy_tau / -r->bTy_by_tau : NAN;
 	r->resUnbdd = r->cTx_by_tau < 0 ? w->nm_c * nmAxs_tau / -r->cTx_by_tau : NAN;
@@ -231,6 +276,7 @@ static void calcResiduals(Work * w, struct residuals * r, scs_int iter) {
 	r->resPri = nmpr_tau / (1 + w->nm_b) / r->tau;
 	r->resDual = nmdr_tau / (1 + w->nm_c) / r->tau;
 	r->relGap = ABS(cTx + bTy) / (1 + ABS(cTx) + ABS(bTy));
+	w->residualTime += tocq(&residTimer);
     RETURN;
 }
 
@@ -244,24 +290,42 @@ static void coldStartVars(Work * w) {
     RETURN;
 }
 
-/* status < 0 indicates failure */
-static scs_int projectLinSys(Work * w, scs_int iter) {
-	/* ut = u + v */
+/* forms the right-hand side of the linear system solve in u_t from u_prev and v */
+static void formLinSysRhs(Work * w) {
+	/* ut = u + v, u from the previous iteration is in u_prev (buffers are rotated in scs_solve) */
     DEBUG_FUNC
-	scs_int n = w->n, m = w->m, l = n + m + 1, status;
-	memcpy(w->u_t, w->u, l * sizeof(scs_float));
-	addScaledArray(w->u_t, w->v, l, 1.0);
-
-	scaleArray(w->u_t, w->stgs->rho_x, n);
-
-	addScaledArray(w->u_t, w->h, l - 1, -w->u_t[l - 1]);
-	addScaledArray(w->u_t, w->h, l - 1, -innerProd(w->u_t, w->g, l - 1) / (w->gTh + 1));
-	scaleArray(&(w->u_t[n]), -1, m);
+	scs_int i, n = w->n, m = w->m, l = n + m + 1;
+	scs_float *u = w->u_prev, *v = w->v, *u_t = w->u_t, *h = w->h, *g = w->g;
+	scs_float rho_x = w->stgs->rho_x, tau, ip = 0;
 
-	status = solveLinSys(w->A, w->stgs, w->p, w->u_t, w->u, iter);
-
-	w->u_t[l - 1] += innerProd(w->u_t, w->h, l - 1);
+	/* first pass: u_t = [rho_x * (x + vx); y + vy] - h * tau, accumulating g'u_t */
+	tau = u_t[l - 1] = u[l - 1] + v[l - 1];
+	for (i = 0; i < n; ++i) {
+		u_t[i] = rho_x * (u[i] + v[i]) - h[i] * tau;
+		ip += u_t[i] * g[i];
+	}
+	for (i = n; i < l - 1; ++i) {
+		u_t[i] = u[i] + v[i] - h[i] * tau;
+		ip += u_t[i] * g[i];
+	}
+	/* second pass: u_t -= h * g'u_t / (gTh + 1), negating the y block */
+	ip /= (w->gTh + 1);
+	for (i = 0; i < n; ++i) {
+		u_t[i] -= h[i] * ip;
+	}
+	for (i = n; i < l - 1; ++i) {
+		u_t[i] = h[i] * ip - u_t[i];
+	}
+    RETURN;
+}
 
+/* status < 0 indicates failure */
+static scs_int projectLinSys(Work * w, scs_int iter) {
+    DEBUG_FUNC
+	scs_int status;
+	formLinSysRhs(w);
+	status = solveLinSys(w->A, w->stgs, w->p, w->u_t, w->u_prev, iter);
+	/* u_t[l - 1] += h'u_t is fused into projectCones */
 	RETURN status;
 }
 
@@ -282,12 +346,14 @@ void printSol(Work * w, Sol * sol, Info * info) {
     RETURN;
 }
 
+/* v += u - (alpha * u_t + (1 - alpha) * u_prev), projectCones left minus the relaxed iterate (less v) in v */
 static void updateDualVars(Work * w) {
     DEBUG_FUNC
 	scs_int i, n = w->n, l = n + w->m + 1;
+	scs_float *u = w->u, *v = w->v;
 	/* this does not relax 'x' variable */
 	for (i = n; i < l; ++i) {
-		w->v[i] += (w->u[i] - w->stgs->alpha * w->u_t[i] - (1.0 - w->stgs->alpha) * w->u_prev[i]);
+		v[i] += u[i];
 	}
     RETURN;
 }
@@ -296,17 +362,25 @@ static void updateDualVars(Work * w) {
 static scs_int projectCones(Work * w, const Cone * k, scs_int iter) {
     DEBUG_FUNC
 	scs_int i, n = w->n, l = n + w->m + 1, status;
+	scs_float *u = w->u, *v = w->v, *u_t = w->u_t, *u_prev = w->u_prev, *h = w->h;
+	scs_float alpha = w->stgs->alpha, ip = 0;
 	/* this does not relax 'x' variable */
 	for (i = 0; i < n; ++i) {
-		w->u[i] = w->u_t[i] - w->v[i];
+		u[i] = u_t[i] - v[i];
+		ip += u_t[i] * h[i];
 	}
-	for (i = n; i < l; ++i) {
-		w->u[i] = w->stgs->alpha * w->u_t[i] + (1 - w->stgs->alpha) * w->u_prev[i] - w->v[i];
+	for (i = n; i < l - 1; ++i) {
+		u[i] = alpha * u_t[i] + (1 - alpha) * u_prev[i] - v[i];
+		v[i] = -u[i];
+		ip += u_t[i] * h[i];
 	}
+	u_t[l - 1] += ip;
+	u[l - 1] = alpha * u_t[l - 1] + (1 - alpha) * u_prev[l - 1] - v[l - 1];
+	v[l - 1] = -u[l - 1];
 	/* u = [x;y;tau] */
-	status = projDualCone(&(w->u[n]), k, w->coneWork, &(w->u_prev[n]), iter);
-	if (w->u[l - 1] < 0.0)
-		w->u[l - 1] = 0.0;
+	status = projDualCone(&(u[n]), k, w->coneWork, &(u_prev[n]), iter);
+	if (u[l - 1] < 0.0)
+		u[l - 1] = 0.0;
 
 	RETURN status;
 }
@@ -489,10 +563,10 @@ static void printSummary(Work * w, scs_int i, struct residuals *r, timer * solve
 
 static void printHeader(Work * w, const Cone * k) {
     DEBUG_FUNC
-	scs_int i;
+	scs_int i, lineLen = getLineLen();
 	if (w->stgs->warm_start)
 		scs_printf("SCS using variable warm-starting\n");
-	for (i = 0; i < _lineLen_; ++i) {
+	for (i = 0; i < lineLen; ++i) {
 		scs_printf("-");
 	}
 	scs_printf("\n");
@@ -500,7 +574,7 @@ static void printHeader(Work * w, const Cone * k) {
 		scs_printf("%s|", HEADER[i]);
 	}
 	scs_printf("%s\n", HEADER[HEADER_LEN - 1]);
-	for (i = 0; i < _lineLen_; ++i) {
+	for (i = 0; i < lineLen; ++i) {
 		scs_printf("-");
 	}
 	scs_printf("\n");
@@ -510,12 +584,20 @@ static void printHeader(Work * w, const Cone * k) {
     RETURN;
 }
 
+/* the box cone of c without the scaling of the normalized iterates, for the distances of the (unnormalized) solution */
+static ConeWork unscaledConeWork(const ConeWork * c) {
+    ConeWork cu = *c;
+    cu.boxBl = cu.boxBu = SCS_NULL;
+    return cu;
+}
+
 scs_float getDualConeDist(const scs_float * y, const Cone * k, ConeWork * c,  scs_int m) {
     DEBUG_FUNC
     scs_float dist;
     scs_float * t = scs_malloc(sizeof(scs_float) * m);
+    ConeWork cu = unscaledConeWork(c);
     memcpy(t, y, m * sizeof(scs_float));
-    projDualCone(t, k, c, SCS_NULL, -1);
+    projDualCone(t, k, &cu, SCS_NULL, -1);
     dist = calcNormInfDiff(t, y, m);
 #if EXTRAVERBOSE > 0
     printArray(y, m, "y");
@@ -531,9 +613,10 @@ scs_float getPriConeDist(const scs_float * s, const Cone * k, ConeWork * c, scs_
     DEBUG_FUNC
     scs_float dist;
     scs_float * t = scs_malloc(sizeof(scs_float) * m);
+    ConeWork cu = unscaledConeWork(c);
     memcpy(t, s, m * sizeof(scs_float));
     scaleArray(t, -1.0, m);
-    projDualCone(t, k, c, SCS_NULL, -1);
+    projDualCone(t, k, &cu, SCS_NULL, -1);
     dist = calcNormInf(t, m); /* ||s - Pi_c(s)|| = ||Pi_c*(-s)|| */
 #if EXTRAVERBOSE > 0
     printArray(s, m, "s");
@@ -546,17 +629,25 @@ scs_float getPriConeDist(const scs_float * s, const Cone * k, ConeWork * c, scs_
 
 static void printFooter(const Data * d, const Cone * k, Sol * sol, Work * w, Info * info) {
     DEBUG_FUNC
-	scs_int i;
+	scs_int i, lineLen = getLineLen();
 	char * linSysStr = getLinSysSummary(w->p, info);
-	char * coneStr = getConeSummary(info);
-	for (i = 0; i < _lineLen_; ++i) {
+	char * coneStr = getConeSummary(info, w->coneWork);
+	for (i = 0; i < lineLen; ++i) {
 		scs_printf("-");
 	}
 	scs_printf("\nStatus: %s\n", info->status);
 	if (info->iter == w->stgs->max_iters) {
 		scs_printf("Hit max_iters, solution may be inaccurate\n");
 	}
+	if (info->statusVal == SCS_TIME_LIMIT) {
+		scs_printf("Hit time_limit, returning best iterate (from iteration %li), solution may be inaccurate\n",
+				(long) w->bestIter);
+	}
 	scs_printf("Timing: Solve time: %1.2es\n", info->solveTime / 1e3);
+	if (w->stgs->mixed_precision) {
+		scs_printf("Mixed precision: %li of %li iterations with single precision linear system data\n",
+				(long) info->singleIters, (long) info->iter);
+	}
 
 	if (linSysStr) {
 		scs_printf("%s", linSysStr);
@@ -568,7 +659,18 @@ static void printFooter(const Data * d, const Cone * k, Sol * sol, Work * w, Inf
 		scs_free(coneStr);
 	}
 
-	for (i = 0; i < _lineLen_; ++i) {
+	if (w->stgs->normalize && w->stgs->adaptive_scale > 0) {
+		scs_printf("\tAdaptive scale: refactorizations: %li, final scale: %1.2e\n", (long) info->refactorizations,
+				w->scale);
+	}
+
+	if (w->accel) {
+		char * accelStr = getAccelSummary(w->accel, info);
+		scs_printf("%s", accelStr);
+		scs_free(accelStr);
+	}
+
+	for (i = 0; i < lineLen; ++i) {
 		scs_printf("-");
 	}
 	scs_printf("\n");
@@ -590,13 +692,13 @@ static void printFooter(const Data * d, const Cone * k, Sol * sol, Work * w, Inf
 		scs_printf("|Ax + s - b|_2 / (1 + |b|_2) = %.4e\n", info->resPri);
 		scs_printf("|A'y + c|_2 / (1 + |c|_2) = %.4e\n", info->resDual);
 		scs_printf("|c'x + b'y| / (1 + |c'x| + |b'y|) = %.4e\n", info->relGap);
-		for (i = 0; i < _lineLen_; ++i) {
+		for (i = 0; i < lineLen; ++i) {
 			scs_printf("-");
 		}
 		scs_printf("\n");
 		scs_printf("c'x = %.4f, -b'y = %.4f\n", info->pobj, info->dobj);
 	}
-	for (i = 0; i < _lineLen_; ++i) {
+	for (i = 0; i < lineLen; ++i) {
 		scs_printf("=");
 	}
 	scs_printf("\n");
@@ -621,6 +723,64 @@ static scs_int hasConverged(Work * w, struct residuals * r, scs_int iter) {
 	RETURN 0;
 }
 
+/* distance of the iterate to the closest termination criterion, the one hasConverged compares with eps */
+static scs_float terminationDist(const struct residuals * r) {
+    DEBUG_FUNC
+	scs_float dist = INFINITY;
+	if (!scs_isnan(r->resPri) && !scs_isnan(r->resDual) && !scs_isnan(r->relGap)) {
+		dist = MAX(MAX(r->resPri, r->resDual), r->relGap);
+	}
+	if (r->resInfeas < dist) {
+		dist = r->resInfeas;
+	}
+	if (r->resUnbdd < dist) {
+		dist = r->resUnbdd;
+	}
+	RETURN dist;
+}
+
+/* keeps a copy of the iterate if it is the closest to termination so far, called after calcResiduals */
+static void updateBest(Work * w, struct residuals * r, scs_int iter) {
+    DEBUG_FUNC
+	scs_int l = w->n + w->m + 1;
+	scs_float dist = terminationDist(r);
+	if (dist < w->bestDist) {
+		memcpy(w->u_best, w->u, l * sizeof(scs_float));
+		memcpy(w->v_best, w->v, l * sizeof(scs_float));
+		w->bestDist = dist;
+		w->bestIter = iter;
+	}
+    RETURN;
+}
+
+/* time_limit was hit: restores the best iterate so the normal getSolution path returns it */
+static void restoreBest(Work * w, struct residuals * r) {
+    DEBUG_FUNC
+	scs_int l = w->n + w->m + 1;
+	if (w->bestIter >= 0) {
+		memcpy(w->u, w->u_best, l * sizeof(scs_float));
+		memcpy(w->v, w->v_best, l * sizeof(scs_float));
+		r->lastIter = -1; /* residuals must be recomputed */
+	}
+    RETURN;
+}
+
+/* flags the best guess from getSolution as returned on time_limit */
+static void timeLimitStatus(Info * info) {
+    DEBUG_FUNC
+	if (isSolvedStatus(info->statusVal)) {
+		strcpy(info->status, "Solved/Time limit");
+	} else if (isInfeasibleStatus(info->statusVal)) {
+		strcpy(info->status, "Infeasible/Time limit");
+	} else if (isUnboundedStatus(info->statusVal)) {
+		strcpy(info->status, "Unbounded/Time limit");
+	} else {
+		strcpy(info->status, "Indeterminate/Time limit");
+	}
+	info->statusVal = SCS_TIME_LIMIT;
+    RETURN;
+}
+
 static scs_int validate(const Data * d, const Cone * k) {
     DEBUG_FUNC
 	Settings * stgs = d->stgs;
@@ -660,9 +820,38 @@ static scs_int validate(const Data * d, const Cone * k) {
 		scs_printf("scale must be positive (1 works well).\n");
 		RETURN -1;
 	}
+	if (stgs->adaptive_scale < 0) {
+		scs_printf("adaptive_scale must be non-negative (0 disables scale updates).\n");
+		RETURN -1;
+	}
+	if (stgs->time_limit < 0) {
+		scs_printf("time_limit must be non-negative (0 disables the time limit).\n");
+		RETURN -1;
+	}
+	if (stgs->acceleration_lookback < 0) {
+		scs_printf("acceleration_lookback must be non-negative (0 disables acceleration).\n");
+		RETURN -1;
+	}
+	if (stgs->acceleration_lookback > 0 && stgs->acceleration_type != 1 && stgs->acceleration_type != 2) {
+		scs_printf("acceleration_type must be 1 or 2.\n");
+		RETURN -1;
+	}
 	RETURN 0;
 }
 
+/* h = [c; b], g = (I + M)^-1 h, must be recomputed whenever b, c or the factorization change */
+static void setupHG(Work * w) {
+    DEBUG_FUNC
+	scs_int n = w->n, m = w->m;
+	memcpy(w->h, w->c, n * sizeof(scs_float));
+	memcpy(&(w->h[n]), w->b, m * sizeof(scs_float));
+	memcpy(w->g, w->h, (n + m) * sizeof(scs_float));
+	solveLinSys(w->A, w->stgs, w->p, w->g, SCS_NULL, -1);
+	scaleArray(&(w->g[n]), -1, m);
+	w->gTh = innerProd(w->h, w->g, n + m);
+    RETURN;
+}
+
 static Work * initWork(const Data *d, const Cone * k) {
     DEBUG_FUNC
 	Work * w = scs_calloc(1, sizeof(Work));
@@ -678,6 +867,7 @@ static Work * initWork(const Data *d, const Cone * k) {
 	w->stgs = d->stgs;
 	w->m = d->m;
 	w->n = d->n;
+	w->scale = d->stgs->scale;
 	/* allocate workspace: */
 	w->u = scs_malloc(l * sizeof(scs_float));
 	w->v = scs_malloc(l * sizeof(scs_float));
@@ -701,7 +891,7 @@ static Work * initWork(const Data *d, const Cone * k) {
 			RETURN SCS_NULL;
 		}
 #endif
-		w->scal = scs_malloc(sizeof(Scaling));
+		w->scal = scs_calloc(1, sizeof(Scaling));
 		normalizeA(w->A, w->stgs, k, w->scal);
 #if EXTRAVERBOSE > 0
 		printArray(w->scal->D, d->m, "D");
@@ -712,7 +902,7 @@ static Work * initWork(const Data *d, const Cone * k) {
 	} else {
 		w->scal = SCS_NULL;
 	}
-	if (!(w->coneWork = initCone(k))) {
+	if (!(w->coneWork = initCone(k)) || (w->stgs->normalize && setConeScaling(w->coneWork, w->scal->D) < 0)) {
 		scs_printf("ERROR: initCone failure\n");
 		RETURN SCS_NULL;
 	}
@@ -721,6 +911,14 @@ static Work * initWork(const Data *d, const Cone * k) {
 		scs_printf("ERROR: initPriv failure\n");
 		RETURN SCS_NULL;
 	}
+	if (w->stgs->acceleration_lookback > 0) {
+		if (!(w->accel = initAccel(w))) {
+			scs_printf("ERROR: initAccel failure\n");
+			RETURN SCS_NULL;
+		}
+	} else {
+		w->accel = SCS_NULL;
+	}
 	RETURN w;
 }
 
@@ -757,36 +955,143 @@ static scs_int updateWork(const Data * d, Work * w, const Sol * sol) {
 	} else {
 		coldStartVars(w);
 	}
-	memcpy(w->h, w->c, n * sizeof(scs_float));
-	memcpy(&(w->h[n]), w->b, m * sizeof(scs_float));
-	memcpy(w->g, w->h, (n + m) * sizeof(scs_float));
-	solveLinSys(w->A, w->stgs, w->p, w->g, SCS_NULL, -1);
-	scaleArray(&(w->g[n]), -1, m);
-	w->gTh = innerProd(w->h, w->g, n + m);
+	if (w->accel) {
+		resetAccel(w->accel, w);
+	}
+	if (w->stgs->time_limit > 0 && !w->u_best) {
+		w->u_best = scs_malloc((n + m + 1) * sizeof(scs_float));
+		w->v_best = scs_malloc((n + m + 1) * sizeof(scs_float));
+		if (!w->u_best || !w->v_best) {
+			scs_printf("ERROR: best iterate memory allocation failure\n");
+			RETURN -1;
+		}
+	}
+	w->bestDist = INFINITY;
+	w->bestIter = -1;
+	w->lastScaleIter = 0;
+	w->singleBestDist = INFINITY;
+	w->singleStall = 0;
+	if (setLinSysPrecision(w->A, w->p, w->singlePrecision) < 0) {
+		scs_printf("ERROR: single precision linear system memory allocation failure\n");
+		RETURN -1;
+	}
+	setupHG(w);
 	RETURN 0;
 }
 
-scs_int scs_solve(Work * w, const Data * d, const Cone * k, Sol * sol, Info * info) {
+/* mixed precision, called after calcResiduals in the single precision phase: once the iterate is close to
+ * termination (or stops improving) switches the linear system to full precision and continues from the current
+ * iterate, h and g are recomputed with the full precision solve */
+static void updatePrecision(Work * w, struct residuals * r, scs_int iter, Info * info) {
     DEBUG_FUNC
-	scs_int i;
+	scs_float dist = terminationDist(r);
+	if (dist < w->singleBestDist) {
+		w->singleBestDist = dist;
+		w->singleStall = 0;
+	} else {
+		w->singleStall++;
+	}
+	if (dist > MAX(w->stgs->eps, MIXED_PRECISION_EPS) && w->singleStall < MIXED_PRECISION_STALL_CHECKS) {
+		RETURN;
+	}
+	/* switching back to full precision does not allocate, so cannot fail */
+	setLinSysPrecision(w->A, w->p, 0);
+	w->singlePrecision = 0;
+	info->singleIters = iter;
+	setupHG(w);
+	if (w->accel) {
+		resetAccel(w->accel, w);
+	}
+    RETURN;
+}
+
+/* residual balancing: rescales the embedding so that the primal and dual residuals decrease at similar rates.
+ * multiplying A, b, c by a factor scales Q, so v is scaled to stay consistent; u is unchanged.
+ * returns 1 if the scale was updated, status < 0 indicates failure */
+static scs_int adaptScale(Work * w, struct residuals * r, scs_int iter, Info * info) {
+    DEBUG_FUNC
+	scs_int n = w->n, m = w->m, l = n + m + 1;
+	scs_float ratio, scale, factor;
+	if (info->refactorizations >= w->stgs->adaptive_scale || iter - w->lastScaleIter < ADAPT_SCALE_MIN_ITERS) {
+		RETURN 0;
+	}
+	ratio = r->resPri / r->resDual;
+	if (!(ratio > 0 && ratio < INFINITY) || (ratio < ADAPT_SCALE_TOL && ratio > 1.0 / ADAPT_SCALE_TOL)) {
+		RETURN 0;
+	}
+	/* higher scale makes the primal residual go down faster */
+	scale = MIN(MAX(w->scale * SQRTF(ratio), ADAPT_SCALE_MIN), ADAPT_SCALE_MAX);
+	factor = scale / w->scale;
+	if (factor == 1.0) {
+		RETURN 0;
+	}
+	w->scale = scale;
+	rescaleA(w->A, factor);
+	scaleArray(w->b, factor, m);
+	scaleArray(w->c, factor, n);
+	scaleArray(w->v, factor, l);
+	if (w->v_best) {
+		/* keep the stored iterate consistent with the new scale */
+		scaleArray(w->v_best, factor, l);
+	}
+	if (updateLinSys(w->A, w->stgs, w->p) < 0) {
+		RETURN -1;
+	}
+	setupHG(w);
+	if (w->accel) {
+		resetAccel(w->accel, w);
+	}
+	w->lastScaleIter = iter;
+	info->refactorizations++;
+	RETURN 1;
+}
+
+/* fills the per-phase timings and counters of info, the running totals are reset so the next call covers what
+ * happened in between */
+static void getSolveStats(Work * w, Info * info) {
+    DEBUG_FUNC
+	getLinSysInfo(w->p, info);
+	getConeInfo(w->coneWork, info);
+	info->residualTime = w->residualTime;
+	w->residualTime = 0;
+    RETURN;
+}
+
+/* scs_solve on the problem w was set up for (the decomposed one if w->chordal) */
+static scs_int solveWork(Work * w, const Data * d, const Cone * k, Sol * sol, Info * info) {
+    DEBUG_FUNC
+	scs_int i, timeLimitHit = 0;
+	scs_float * tmp;
 	timer solveTimer;
 	struct residuals r;
-	if (!d || !k || !sol || !info || !w || !d->b || !d->c) {
-		scs_printf("ERROR: SCS_NULL input\n");
-		RETURN SCS_FAILED;
-	}
 	/* initialize ctrl-c support */
 	startInterruptListener();
 	tic(&solveTimer);
+	/* start the totals afresh, drops e.g. the cone projections of the last verbose footer */
+	getSolveStats(w, info);
 	info->statusVal = SCS_UNFINISHED; /* not yet converged */
+	info->refactorizations = 0;
+	info->singleIters = 0;
 	r.lastIter = -1;
-	updateWork(d, w, sol);
+#ifndef FLOAT
+	w->singlePrecision = w->stgs->mixed_precision;
+#endif
+	w->coneWork->sdWarmEig = w->stgs->sdp_warm_eig;
+	if (updateWork(d, w, sol) < 0) {
+		RETURN failure(w, w->m, w->n, sol, info, SCS_FAILED, "error in updateWork", "Failure");
+	}
 
 	if (w->stgs->verbose)
 		printHeader(w, k);
 	/* scs: */
 	for (i = 0; i < w->stgs->max_iters; ++i) {
-		memcpy(w->u_prev, w->u, (w->n + w->m + 1) * sizeof(scs_float));
+		if (w->accel && i > 0) {
+			accelerate(w);
+		}
+		/* rotate instead of copying, projectCones overwrites all of u */
+		tmp = w->u_prev;
+		w->u_prev = w->u;
+		w->u = tmp;
 
 		if (projectLinSys(w, i) < 0) {
 			RETURN failure(w, w->m, w->n, sol, info, SCS_FAILED, "error in projectLinSys", "Failure");
@@ -805,12 +1110,32 @@ scs_int scs_solve(Work * w, const Data * d, const Cone * k, Sol * sol, Info * in
 			if ((info->statusVal = hasConverged(w, &r, i)) != 0) {
 				break;
 			}
+			if (w->stgs->time_limit > 0) {
+				updateBest(w, &r, i);
+			}
+			if (w->singlePrecision) {
+				updatePrecision(w, &r, i, info);
+			}
+			if (w->stgs->normalize && w->stgs->adaptive_scale > 0 && adaptScale(w, &r, i, info) < 0) {
+				RETURN failure(w, w->m, w->n, sol, info, SCS_FAILED, "error in adaptScale", "Failure");
+			}
 		}
 
         if (w->stgs->verbose && i % PRINT_INTERVAL == 0) {
             calcResiduals(w, &r, i);
             printSummary(w, i, &r, &solveTimer);
         }
+
+		if (w->stgs->time_limit > 0 && tocq(&solveTimer) > w->stgs->time_limit) {
+			timeLimitHit = 1;
+			break;
+		}
+    }
+    if (w->singlePrecision) {
+        info->singleIters = i;
+    }
+    if (timeLimitHit) {
+        restoreBest(w, &r);
     }
     if (w->stgs->verbose) {
         calcResiduals(w, &r, i);
@@ -818,6 +1143,10 @@ scs_int scs_solve(Work * w, const Data * d, const Cone * k, Sol * sol, Info * in
     }
     /* populate solution vectors (unnormalized) and info */
     getSolution(w, sol, info, &r, i);
+    if (timeLimitHit) {
+        timeLimitStatus(info);
+    }
+    getSolveStats(w, info);
     info->solveTime = tocq(&solveTimer);
 
 	if (w->stgs->verbose)
@@ -826,19 +1155,440 @@ scs_int scs_solve(Work * w, const Data * d, const Cone * k, Sol * sol, Info * in
 	RETURN info->statusVal;
 }
 
+scs_int scs_solve(Work * w, const Data * d, const Cone * k, Sol * sol, Info * info) {
+    DEBUG_FUNC
+	scs_int status;
+	ChordalWork * ch;
+	Data * dc;
+	if (!d || !k || !sol || !info || !w || !d->b || !d->c) {
+		scs_printf("ERROR: SCS_NULL input\n");
+		RETURN SCS_FAILED;
+	}
+	if (!(ch = w->chordal)) {
+		RETURN solveWork(w, d, k, sol, info);
+	}
+	dc = getChordalData(ch);
+	if (chordalForward(ch, d->b, d->c, dc->b, dc->c, w->stgs->warm_start ? sol : SCS_NULL, getChordalSol(ch)) < 0) {
+		RETURN failure(SCS_NULL, d->m, d->n, sol, info, SCS_FAILED, "error in chordalForward", "Failure");
+	}
+	status = solveWork(w, dc, getChordalCone(ch), getChordalSol(ch), info);
+	if (status == SCS_FAILED || status == SCS_SIGINT) {
+		populateOnFailure(d->m, d->n, sol, SCS_NULL, status, SCS_NULL);
+	} else {
+		chordalBackward(ch, getChordalSol(ch), sol);
+	}
+	RETURN status;
+}
+
+static void freeBatchWork(Work * s) {
+    DEBUG_FUNC
+	if (!s) RETURN;
+	if (s->u)
+		scs_free(s->u);
+	if (s->v)
+		scs_free(s->v);
+	if (s->u_t)
+		scs_free(s->u_t);
+	if (s->u_prev)
+		scs_free(s->u_prev);
+	if (s->h)
+		scs_free(s->h);
+	if (s->g)
+		scs_free(s->g);
+	if (s->b)
+		scs_free(s->b);
+	if (s->c)
+		scs_free(s->c);
+	if (s->accel)
+		freeAccel(s->accel);
+	if (s->u_best)
+		scs_free(s->u_best);
+	if (s->v_best)
+		scs_free(s->v_best);
+	scs_free(s);
+    RETURN;
+}
+
+/* per-problem workspace for scs_solve_batch: a copy of w that shares A, the linear system and cone workspaces and
+ * the scaling with w, but owns the iterates and b, c */
+static Work * initBatchWork(const Work * w) {
+    DEBUG_FUNC
+	Work * s = scs_malloc(sizeof(Work));
+	scs_int l = w->n + w->m + 1;
+	if (!s) {
+		RETURN SCS_NULL;
+	}
+	*s = *w;
+	s->u_best = SCS_NULL;
+	s->v_best = SCS_NULL;
+	s->singlePrecision = 0;
+	s->u = scs_malloc(l * sizeof(scs_float));
+	s->v = scs_malloc(l * sizeof(scs_float));
+	s->u_t = scs_malloc(l * sizeof(scs_float));
+	s->u_prev = scs_malloc(l * sizeof(scs_float));
+	s->h = scs_malloc((l - 1) * sizeof(scs_float));
+	s->g = scs_malloc((l - 1) * sizeof(scs_float));
+	s->b = scs_malloc(w->m * sizeof(scs_float));
+	s->c = scs_malloc(w->n * sizeof(scs_float));
+	s->accel = w->accel ? initAccel(s) : SCS_NULL;
+	if (!s->u || !s->v || !s->u_t || !s->u_prev || !s->h || !s->g || !s->b || !s->c || (w->accel && !s->accel)) {
+		freeBatchWork(s);
+		RETURN SCS_NULL;
+	}
+	RETURN s;
+}
+
+static void printBatchFooter(Work * w, scs_int nProblems, const Info * info) {
+    DEBUG_FUNC
+	scs_int i, lineLen = getLineLen();
+	char * linSysStr, *coneStr;
+	Info tot = info[0];
+	/* the summaries average over this many linear system solves / cone projections */
+	tot.iter = -1;
+	tot.solveTime = 0;
+	for (i = 0; i < nProblems; ++i) {
+		tot.iter += info[i].iter;
+		tot.solveTime = MAX(tot.solveTime, info[i].solveTime);
+		scs_printf("problem %li: %s, iterations: %li, c'x = %.4f, -b'y = %.4f\n", (long) i, info[i].status,
+				(long) info[i].iter, info[i].pobj, info[i].dobj);
+	}
+	for (i = 0; i < lineLen; ++i) {
+		scs_printf("-");
+	}
+	scs_printf("\nTiming: Solve time: %1.2es\n", tot.solveTime / 1e3);
+	linSysStr = getLinSysSummary(w->p, &tot);
+	if (linSysStr) {
+		scs_printf("%s", linSysStr);
+		scs_free(linSysStr);
+	}
+	coneStr = getConeSummary(&tot, w->coneWork);
+	if (coneStr) {
+		scs_printf("%s", coneStr);
+		scs_free(coneStr);
+	}
+	for (i = 0; i < lineLen; ++i) {
+		scs_printf("=");
+	}
+	scs_printf("\n");
+    RETURN;
+}
+
+/* copies the per-phase timings and counters of src to dst */
+static void copySolveStats(Info * dst, const Info * src) {
+    DEBUG_FUNC
+	dst->linSysTime = src->linSysTime;
+	dst->coneTime = src->coneTime;
+	dst->lpConeTime = src->lpConeTime;
+	dst->socConeTime = src->socConeTime;
+	dst->sdConeTime = src->sdConeTime;
+	dst->expConeTime = src->expConeTime;
+	dst->powConeTime = src->powConeTime;
+	dst->boxConeTime = src->boxConeTime;
+	dst->sdProjections = src->sdProjections;
+	dst->sdPsdHits = src->sdPsdHits;
+	dst->sdNsdHits = src->sdNsdHits;
+	dst->sdWarmEigs = src->sdWarmEigs;
+	dst->residualTime = src->residualTime;
+	dst->spmvTime = src->spmvTime;
+	dst->cgIters = src->cgIters;
+	dst->orderingTime = src->orderingTime;
+	dst->factorTime = src->factorTime;
+	dst->nnzL = src->nnzL;
+	dst->factorCacheHit = src->factorCacheHit;
+    RETURN;
+}
+
+/* the scs_solve loop over the problems in ws together, problems drop out of the batch as they converge */
+static scs_int solveBatch(Work * w, const Cone * k, scs_int nProblems, Work ** ws, Sol * sol, Info * info,
+		struct residuals * r, scs_int * act, scs_float ** rhs, const scs_float ** warm, timer * solveTimer) {
+    DEBUG_FUNC
+	scs_int i, j, a, nAct = nProblems, status = 0, timeLimitHit = 0;
+	scs_float * tmp;
+	Work * s;
+	for (j = 0; j < nProblems; ++j) {
+		act[j] = j;
+	}
+	for (i = 0; i < w->stgs->max_iters && nAct > 0; ++i) {
+		for (a = 0; a < nAct; ++a) {
+			s = ws[act[a]];
+			if (s->accel && i > 0) {
+				accelerate(s);
+			}
+			/* rotate instead of copying, projectCones overwrites all of u */
+			tmp = s->u_prev;
+			s->u_prev = s->u;
+			s->u = tmp;
+			formLinSysRhs(s);
+			rhs[a] = s->u_t;
+			warm[a] = s->u_prev;
+		}
+		/* one multiple right-hand side solve for all the unconverged problems */
+		if (solveLinSysBatch(w->A, w->stgs, w->p, rhs, warm, nAct, i) < 0) {
+			scs_printf("Failure:error in solveLinSysBatch\n");
+			status = SCS_FAILED;
+			break;
+		}
+		for (a = 0; a < nAct && status == 0;) {
+			j = act[a];
+			s = ws[j];
+			if (projectCones(s, k, i) < 0) {
+				scs_printf("Failure:error in projectCones\n");
+				status = SCS_FAILED;
+				break;
+			}
+			updateDualVars(s);
+			if (i % CONVERGED_INTERVAL == 0) {
+				calcResiduals(s, &(r[j]), i);
+				if ((info[j].statusVal = hasConverged(s, &(r[j]), i)) != 0) {
+					getSolution(s, &(sol[j]), &(info[j]), &(r[j]), i);
+					info[j].solveTime = tocq(solveTimer);
+					act[a] = act[--nAct];
+					continue;
+				}
+				if (w->stgs->time_limit > 0) {
+					updateBest(s, &(r[j]), i);
+				}
+			}
+			++a;
+		}
+		if (status == 0 && isInterrupted()) {
+			scs_printf("Failure:Interrupted\n");
+			status = SCS_SIGINT;
+		}
+		if (status < 0) {
+			break;
+		}
+		if (w->stgs->time_limit > 0 && tocq(solveTimer) > w->stgs->time_limit) {
+			timeLimitHit = 1;
+			break;
+		}
+	}
+	for (a = 0; a < nAct; ++a) {
+		j = act[a];
+		if (status < 0) {
+			populateOnFailure(w->m, w->n, &(sol[j]), &(info[j]), status, status == SCS_SIGINT ? "Interrupted" : "Failure");
+		} else if (timeLimitHit) {
+			restoreBest(ws[j], &(r[j]));
+			getSolution(ws[j], &(sol[j]), &(info[j]), &(r[j]), i);
+			timeLimitStatus(&(info[j]));
+			info[j].solveTime = tocq(solveTimer);
+		} else {
+			/* hit max_iters, take best guess */
+			getSolution(ws[j], &(sol[j]), &(info[j]), &(r[j]), i);
+			info[j].solveTime = tocq(solveTimer);
+		}
+	}
+	RETURN status;
+}
+
+/* scs_solve_batch on the problem w was set up for (the decomposed one if w->chordal) */
+static scs_int solveBatchWork(Work * w, const Data * d, const Cone * k, scs_int nProblems, scs_float ** b,
+		scs_float ** c, Sol * sol, Info * info) {
+    DEBUG_FUNC
+	scs_int j, status = 0;
+	timer solveTimer;
+	Info stats;
+	Data dj;
+	Work ** ws;
+	scs_int * act;
+	scs_float ** rhs;
+	const scs_float ** warm;
+	struct residuals * r;
+	/* initialize ctrl-c support */
+	startInterruptListener();
+	tic(&solveTimer);
+	/* start the totals afresh, the batch workspaces copy w->residualTime */
+	getSolveStats(w, &stats);
+	/* the problems share the cone workspace, so the SD blocks have no single previous projection to warm start from */
+	w->coneWork->sdWarmEig = 0;
+	ws = scs_calloc(nProblems, sizeof(Work *));
+	act = scs_malloc(nProblems * sizeof(scs_int));
+	rhs = scs_malloc(nProblems * sizeof(scs_float *));
+	warm = scs_malloc(nProblems * sizeof(scs_float *));
+	r = scs_malloc(nProblems * sizeof(struct residuals));
+	status = (ws && act && rhs && warm && r) ? 0 : SCS_FAILED;
+	dj = *d;
+	for (j = 0; j < nProblems && status == 0; ++j) {
+		if (!(ws[j] = initBatchWork(w))) {
+			status = SCS_FAILED;
+			break;
+		}
+		info[j].statusVal = SCS_UNFINISHED; /* not yet converged */
+		info[j].refactorizations = 0;
+		r[j].lastIter = -1;
+		dj.b = b[j];
+		dj.c = c[j];
+		if (updateWork(&dj, ws[j], &(sol[j])) < 0) {
+			status = SCS_FAILED;
+		}
+	}
+	if (status < 0) {
+		scs_printf("ERROR: batch memory allocation failure\n");
+		for (j = 0; j < nProblems; ++j) {
+			populateOnFailure(w->m, w->n, &(sol[j]), &(info[j]), SCS_FAILED, "Failure");
+		}
+	} else {
+		if (w->stgs->verbose) {
+			scs_printf("SCS solving a batch of %li problems\n", (long) nProblems);
+		}
+		status = solveBatch(w, k, nProblems, ws, sol, info, r, act, rhs, warm, &solveTimer);
+		/* the linear system and cone workspaces are shared, so only totals for the whole batch are available */
+		getSolveStats(w, &stats);
+		for (j = 0; j < nProblems; ++j) {
+			stats.residualTime += ws[j]->residualTime;
+		}
+		for (j = 0; j < nProblems; ++j) {
+			copySolveStats(&(info[j]), &stats);
+		}
+		if (w->stgs->verbose && status == 0) {
+			printBatchFooter(w, nProblems, info);
+		}
+	}
+	if (ws) {
+		for (j = 0; j < nProblems; ++j) {
+			freeBatchWork(ws[j]);
+		}
+		scs_free(ws);
+	}
+	if (act)
+		scs_free(act);
+	if (rhs)
+		scs_free(rhs);
+	if (warm)
+		scs_free(warm);
+	if (r)
+		scs_free(r);
+	endInterruptListener();
+	RETURN status;
+}
+
+scs_int scs_solve_batch(Work * w, const Data * d, const Cone * k, scs_int nProblems, scs_float ** b, scs_float ** c,
+		Sol * sol, Info * info) {
+    DEBUG_FUNC
+	scs_int j, status = 0;
+	ChordalWork * ch;
+	Data * dc;
+	scs_float ** bc, **cc;
+	Sol * solc;
+	if (!d || !k || !sol || !info || !w || !b || !c || nProblems <= 0) {
+		scs_printf("ERROR: SCS_NULL input\n");
+		RETURN SCS_FAILED;
+	}
+	for (j = 0; j < nProblems; ++j) {
+		if (!b[j] || !c[j]) {
+			scs_printf("ERROR: SCS_NULL input\n");
+			RETURN SCS_FAILED;
+		}
+	}
+	if (!(ch = w->chordal)) {
+		RETURN solveBatchWork(w, d, k, nProblems, b, c, sol, info);
+	}
+	/* each problem's b, c and solution mapped to the decomposed problem and back */
+	dc = getChordalData(ch);
+	bc = scs_calloc(nProblems, sizeof(scs_float *));
+	cc = scs_calloc(nProblems, sizeof(scs_float *));
+	solc = scs_calloc(nProblems, sizeof(Sol));
+	status = (bc && cc && solc) ? 0 : SCS_FAILED;
+	for (j = 0; j < nProblems && status == 0; ++j) {
+		bc[j] = scs_malloc(dc->m * sizeof(scs_float));
+		cc[j] = scs_malloc(dc->n * sizeof(scs_float));
+		solc[j].x = scs_malloc(dc->n * sizeof(scs_float));
+		solc[j].y = scs_malloc(dc->m * sizeof(scs_float));
+		solc[j].s = scs_malloc(dc->m * sizeof(scs_float));
+		if (!bc[j] || !cc[j] || !solc[j].x || !solc[j].y || !solc[j].s
+				|| chordalForward(ch, b[j], c[j], bc[j], cc[j], w->stgs->warm_start ? &(sol[j]) : SCS_NULL,
+						&(solc[j])) < 0) {
+			status = SCS_FAILED;
+		}
+	}
+	if (status == 0) {
+		status = solveBatchWork(w, dc, getChordalCone(ch), nProblems, bc, cc, solc, info);
+		for (j = 0; j < nProblems; ++j) {
+			if (info[j].statusVal == SCS_FAILED || info[j].statusVal == SCS_SIGINT) {
+				populateOnFailure(d->m, d->n, &(sol[j]), SCS_NULL, info[j].statusVal, SCS_NULL);
+			} else {
+				chordalBackward(ch, &(solc[j]), &(sol[j]));
+			}
+		}
+	} else {
+		scs_printf("ERROR: batch chordal decomposition failure\n");
+		for (j = 0; j < nProblems; ++j) {
+			populateOnFailure(d->m, d->n, &(sol[j]), &(info[j]), SCS_FAILED, "Failure");
+		}
+	}
+	for (j = 0; j < nProblems; ++j) {
+		if (bc && bc[j])
+			scs_free(bc[j]);
+		if (cc && cc[j])
+			scs_free(cc[j]);
+		if (solc && solc[j].x)
+			scs_free(solc[j].x);
+		if (solc && solc[j].y)
+			scs_free(solc[j].y);
+		if (solc && solc[j].s)
+			scs_free(solc[j].s);
+	}
+	if (bc)
+		scs_free(bc);
+	if (cc)
+		scs_free(cc);
+	if (solc)
+		scs_free(solc);
+	RETURN status;
+}
+
+scs_int scs_update_A(Work * w, const scs_float * Ax_new) {
+    DEBUG_FUNC
+	timer updateTimer;
+	if (!w || !Ax_new) {
+		scs_printf("ERROR: SCS_NULL input\n");
+		RETURN SCS_FAILED;
+	}
+	tic(&updateTimer);
+	if (w->chordal) {
+		Ax_new = chordalUpdateA(w->chordal, Ax_new);
+	}
+	setAMatrixValues(w->A, Ax_new);
+	if (w->stgs->normalize) {
+		/* normalizeA allocates new scalings and rescales by stgs->scale, undoing any adaptive scale updates */
+		scs_free(w->scal->D);
+		scs_free(w->scal->E);
+		normalizeA(w->A, w->stgs, SCS_NULL, w->scal);
+		if (setConeScaling(w->coneWork, w->scal->D) < 0) {
+			scs_printf("ERROR: setConeScaling failure\n");
+			RETURN SCS_FAILED;
+		}
+		w->scale = w->stgs->scale;
+	}
+	if (updateLinSys(w->A, w->stgs, w->p) < 0) {
+		scs_printf("ERROR: updateLinSys failure\n");
+		RETURN SCS_FAILED;
+	}
+	if (w->stgs->verbose) {
+		scs_printf("Update A time: %1.2es\n", tocq(&updateTimer) / 1e3);
+	}
+	RETURN 0;
+}
+
 void scs_finish(Work * w) {
     DEBUG_FUNC
+    ChordalWork * ch;
     if (w) {
         finishCone(w->coneWork);
         if (w->stgs && w->stgs->normalize) {
 #ifndef COPYAMATRIX
+            if (w->scale != w->stgs->scale) {
+                rescaleA(w->A, w->stgs->scale / w->scale);
+            }
             unNormalizeA(w->A, w->stgs, w->scal);
 #else
             freeAMatrix(w->A);
 #endif
         }
         if (w->p) freePriv(w->p);
+        ch = w->chordal;
         freeWork(w);
+        finishChordal(ch);
     }
 #if EXTRAVERBOSE > 0
     scs_printf("exit finish\n");
@@ -852,10 +1602,13 @@ Work * scs_init(const Data * d, const Cone * k, Info * info) {
     tic(&globalTimer);
 #endif
     Work * w;
+	ChordalWork * ch = SCS_NULL;
+	char * str;
 	timer initTimer;
 	startInterruptListener();
 	if (!d || !k || !info) {
 		scs_printf("ERROR: Missing Data, Cone or Info input\n");
+		endInterruptListener();
 		RETURN SCS_NULL;
 	}
 #if EXTRAVERBOSE > 0
@@ -865,11 +1618,30 @@ Work * scs_init(const Data * d, const Cone * k, Info * info) {
 #ifndef NOVALIDATE
 	if (validate(d, k) < 0) {
 		scs_printf("ERROR: Validation returned failure\n");
+		endInterruptListener();
 		RETURN SCS_NULL;
 	}
 #endif
 	tic(&initTimer);
-	w = initWork(d, k);
+	if (d->stgs->chordal_decomposition) {
+		ch = initChordal(d, k);
+	}
+	if (ch) {
+		/* the rest of the solver only sees the decomposed problem */
+		w = initWork(getChordalData(ch), getChordalCone(ch));
+		if (w) {
+			w->chordal = ch;
+			if (d->stgs->verbose) {
+				str = getChordalSummary(ch);
+				scs_printf("%s", str);
+				scs_free(str);
+			}
+		} else {
+			finishChordal(ch);
+		}
+	} else {
+		w = initWork(d, k);
+	}
 	/* strtoc("init", &initTimer); */
 	info->setupTime = tocq(&initTimer);
 	if (d->stgs->verbose) { scs_printf("Setup time: %1.2es\n", info->setupTime / 1e3); } 
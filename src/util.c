@@ -73,7 +73,7 @@ scs_float strtoc(char * str, timer * t) {
 }
 
 void printConeData(const Cone * k) {
-	scs_int i;
+	scs_int i, j, l;
 	scs_printf("num zeros = %i\n", (int) k->f);
 	scs_printf("num LP = %i\n", (int) k->l);
 	scs_printf("num SOCs = %i\n", (int) k->qsize);
@@ -86,6 +86,11 @@ void printConeData(const Cone * k) {
 	for (i = 0; i < k->ssize; i++) {
 		scs_printf("%i\n", (int) k->s[i]);
 	}
+	scs_printf("num complex SDCs = %i\n", (int) k->cssize);
+	scs_printf("complex sdc array:\n");
+	for (i = 0; i < k->cssize; i++) {
+		scs_printf("%i\n", (int) k->cs[i]);
+	}
     scs_printf("num ep = %i\n", (int) k->ep);
     scs_printf("num ed = %i\n", (int) k->ed);
     scs_printf("num PCs = %i\n", (int) k->psize);
@@ -93,6 +98,20 @@ void printConeData(const Cone * k) {
     for (i = 0; i < k->psize; i++) {
         scs_printf("%4f\n", (double) k->p[i]);
     }
+    scs_printf("num generalized PCs = %i\n", (int) k->gpsize);
+    scs_printf("generalized pow dims and exponents:\n");
+    for (i = 0, j = 0; i < k->gpsize; i++) {
+        scs_printf("%i %i:", (int) k->gpm[i], (int) k->gpn[i]);
+        for (l = 0; l < k->gpm[i]; ++l, ++j) {
+            scs_printf(" %4f", (double) k->gpa[j]);
+        }
+        scs_printf("\n");
+    }
+    scs_printf("box cone size = %i\n", (int) k->bsize);
+    scs_printf("box bounds:\n");
+    for (i = 0; i < k->bsize - 1; i++) {
+        scs_printf("%4f %4f\n", (double) k->bl[i], (double) k->bu[i]);
+    }
 }
 
 void printWork(const Work * w) {
@@ -124,6 +143,16 @@ void printData(const Data * d) {
 	scs_printf("rhoX = %4f\n", d->stgs->rho_x);
 	scs_printf("cg_rate = %4f\n", d->stgs->cg_rate);
 	scs_printf("scale = %4f\n", d->stgs->scale);
+	scs_printf("acceleration_lookback = %i\n", (int) d->stgs->acceleration_lookback);
+	scs_printf("acceleration_type = %i\n", (int) d->stgs->acceleration_type);
+	scs_printf("adaptive_scale = %i\n", (int) d->stgs->adaptive_scale);
+	scs_printf("mixed_precision = %i\n", (int) d->stgs->mixed_precision);
+	scs_printf("sdp_warm_eig = %i\n", (int) d->stgs->sdp_warm_eig);
+	scs_printf("chordal_decomposition = %i\n", (int) d->stgs->chordal_decomposition);
+	scs_printf("supernodal = %i\n", (int) d->stgs->supernodal);
+	scs_printf("normal_equations = %i\n", (int) d->stgs->normal_equations);
+	scs_printf("factor_cache = %s\n", d->stgs->factor_cache ? d->stgs->factor_cache : "none");
+	scs_printf("tree_parallel = %i\n", (int) d->stgs->tree_parallel);
 }
 
 void printArray(const scs_float * arr, scs_int n, char * name) {
@@ -161,8 +190,20 @@ void freeData(Data * d, Cone * k) {
             scs_free(k->q);
         if (k->s)
             scs_free(k->s);
+        if (k->cs)
+            scs_free(k->cs);
+        if (k->gpm)
+            scs_free(k->gpm);
+        if (k->gpn)
+            scs_free(k->gpn);
+        if (k->gpa)
+            scs_free(k->gpa);
         if (k->p)
             scs_free(k->p);
+        if (k->bl)
+            scs_free(k->bl);
+        if (k->bu)
+            scs_free(k->bu);
         scs_free(k);
     }
 }
@@ -193,5 +234,16 @@ void setDefaultSettings(Data * d) {
     d->stgs->verbose = VERBOSE; /* boolean, write out progress: 1 */
     d->stgs->normalize = NORMALIZE; /* boolean, heuristic data rescaling: 1 */
     d->stgs->warm_start = WARM_START;
+    d->stgs->acceleration_lookback = ACCEL_LOOKBACK; /* memory depth for Anderson acceleration, 0 disables: 0 */
+    d->stgs->acceleration_type = ACCEL_TYPE; /* type-I (1) or type-II (2) Anderson acceleration: 2 */
+    d->stgs->adaptive_scale = ADAPTIVE_SCALE; /* max number of scale updates per solve, 0 disables: 0 */
+    d->stgs->time_limit = TIME_LIMIT; /* wall-clock limit per solve in milliseconds, 0 disables: 0 */
+    d->stgs->mixed_precision = MIXED_PRECISION; /* boolean, single precision linear system data then double: 0 */
+    d->stgs->sdp_warm_eig = SDP_WARM_EIG; /* boolean, warm-started partial eigendecompositions of large SD blocks: 0 */
+    d->stgs->chordal_decomposition = CHORDAL_DECOMPOSITION; /* boolean, split large sparse SD blocks into cliques: 0 */
+    d->stgs->supernodal = SUPERNODAL; /* boolean, direct only, supernodal factorization of the KKT matrix: 1 */
+    d->stgs->normal_equations = NORMAL_EQUATIONS; /* boolean, direct only, factor rho_x I + A'A if smaller: 1 */
+    d->stgs->factor_cache = FACTOR_CACHE; /* direct only, directory of the factorization cache: SCS_NULL */
+    d->stgs->tree_parallel = TREE_PARALLEL; /* boolean, direct only, parallel over elimination subtrees: 0 */
 }
 